@@ -0,0 +1,85 @@
+// Micro-benchmark for the DLL API result encodings.
+// Serializes a large recipe list as the API returns it and decodes it again,
+// comparing JSON text (dump/parse) with CBOR and MessagePack.
+// Build with -DRECIPE_BUILD_BENCHMARKS=ON.
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "domain/recipe/Recipe.h"
+#include "json.hpp"
+
+using json = nlohmann::json;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+constexpr int kRecipes = 20000;
+constexpr int kRounds = 10;
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void report(const std::string& name, double encodeMs, double decodeMs, std::size_t bytes) {
+    std::cout << name << ": encode " << encodeMs / kRounds << " ms, decode " << decodeMs / kRounds
+              << " ms, end-to-end " << (encodeMs + decodeMs) / kRounds << " ms, " << bytes
+              << " bytes" << std::endl;
+}
+
+// Encodes and decodes `value` kRounds times with the given functions
+template <typename Encode, typename Decode>
+void measure(const std::string& name, const json& value, Encode encode, Decode decode) {
+    double encodeMs = 0, decodeMs = 0;
+    std::size_t bytes = 0;
+    for (int round = 0; round < kRounds; ++round) {
+        auto start = Clock::now();
+        auto encoded = encode(value);
+        encodeMs += elapsedMs(start);
+        bytes = encoded.size();
+
+        start = Clock::now();
+        json decoded = decode(encoded);
+        decodeMs += elapsedMs(start);
+        if (decoded.size() != value.size()) std::cerr << name << ": round trip mismatch" << std::endl;
+    }
+    report(name, encodeMs, decodeMs, bytes);
+}
+}  // namespace
+
+int main() {
+    std::mt19937 rng(2024);
+    std::uniform_int_distribution<int> minutes(5, 180), difficulty(0, 2), count(3, 12);
+    const std::vector<std::string> tags{"Quick", "Vegetarian", "Spicy", "Soup", "Dessert", "Chinese"};
+
+    json recipes = json::array();
+    for (int id = 1; id <= kRecipes; ++id) {
+        std::vector<RecipeApp::Ingredient> ingredients;
+        std::vector<std::string> steps;
+        for (int i = count(rng); i > 0; --i) {
+            ingredients.push_back({"Ingredient " + std::to_string(rng() % 500), std::to_string(rng() % 400) + " g"});
+            steps.push_back("Step " + std::to_string(i) + ": stir the pot and wait a little longer.");
+        }
+        recipes.push_back(RecipeApp::Recipe::builder(id, "Recipe " + std::to_string(id))
+                              .withNutritionalInfo("Calories: " + std::to_string(100 + id % 700))
+                              .withIngredients(ingredients)
+                              .withSteps(steps)
+                              .withCookingTime(minutes(rng))
+                              .withDifficulty(static_cast<RecipeApp::Difficulty>(difficulty(rng)))
+                              .withTags({tags[id % tags.size()], tags[(id / 7) % tags.size()]})
+                              .build());
+    }
+
+    measure(
+        "json dump/parse", recipes, [](const json& j) { return j.dump(); },
+        [](const std::string& s) { return json::parse(s); });
+    measure(
+        "cbor", recipes, [](const json& j) { return json::to_cbor(j); },
+        [](const std::vector<std::uint8_t>& b) { return json::from_cbor(b); });
+    measure(
+        "msgpack", recipes, [](const json& j) { return json::to_msgpack(j); },
+        [](const std::vector<std::uint8_t>& b) { return json::from_msgpack(b); });
+    return 0;
+}
@@ -0,0 +1,105 @@
+// Scaling benchmark for encyclopedia loading.
+// Generates a synthetic encyclopedia (JSON array and NDJSON), then times the
+// sequential loadRecipes against loadRecipesParallel with 1-16 threads, and
+// opening a compiled bundle (indexes queried in place) against both.
+// Build with -DRECIPE_BUILD_BENCHMARKS=ON.
+// Usage: BenchEncyclopediaLoad [recipe count, default 100000]
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "json.hpp"
+#include "logic/encyclopedia/RecipeEncyclopediaManager.h"
+
+using RecipeApp::Logic::Encyclopedia::RecipeEncyclopediaManager;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+nlohmann::json makeRecipe(int id) {
+    nlohmann::json ingredients = nlohmann::json::array();
+    for (int i = 0; i < 8; ++i) {
+        ingredients.push_back({{"name", "食材" + std::to_string((id * 7 + i) % 500)},
+                               {"quantity", std::to_string(i + 1) + "0g"}});
+    }
+    nlohmann::json steps = nlohmann::json::array();
+    for (int i = 0; i < 6; ++i) {
+        steps.push_back("第" + std::to_string(i + 1) + "步：处理食材并翻炒均匀，注意火候。");
+    }
+    return {{"id", id},
+            {"name", "测试菜谱 " + std::to_string(id)},
+            {"ingredients", ingredients},
+            {"steps", steps},
+            {"cookingTime", 10 + id % 90},
+            {"difficulty", id % 3 == 0 ? "Hard" : (id % 2 == 0 ? "Medium" : "Easy")},
+            {"tags", {"标签" + std::to_string(id % 40), "家常菜"}},
+            {"nutritionalInfo", "约 " + std::to_string(200 + id % 500) + " 千卡"},
+            {"imageUrl", nullptr}};
+}
+
+double timeLoad(const std::function<bool()>& load) {
+    // Silence the manager's per-load status line
+    std::ostringstream sink;
+    std::streambuf* saved = std::cout.rdbuf(sink.rdbuf());
+    auto start = Clock::now();
+    bool ok = load();
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    std::cout.rdbuf(saved);
+    if (!ok) {
+        std::cerr << "load failed" << std::endl;
+    }
+    return ms;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::size_t count = argc > 1 ? std::stoul(argv[1]) : 100000;
+    const std::string arrayPath = "bench_encyclopedia.json";
+    const std::string ndjsonPath = "bench_encyclopedia.ndjson";
+    {
+        std::ofstream array(arrayPath);
+        std::ofstream lines(ndjsonPath);
+        array << "[\n";
+        for (std::size_t i = 0; i < count; ++i) {
+            std::string record = makeRecipe(static_cast<int>(1001 + i)).dump();
+            array << (i ? ",\n" : "") << record;
+            lines << record << '\n';
+        }
+        array << "\n]\n";
+    }
+    std::cout << count << " recipes, hardware threads: "
+              << std::thread::hardware_concurrency() << std::endl;
+
+    for (const std::string& path : {arrayPath, ndjsonPath}) {
+        std::cout << "== " << path << std::endl;
+        RecipeEncyclopediaManager manager;
+        double baseline = timeLoad([&] { return manager.loadRecipes(path); });
+        std::cout << "loadRecipes (sequential): " << baseline << " ms" << std::endl;
+        for (unsigned threads : {1u, 2u, 4u, 8u, 16u}) {
+            double ms = timeLoad([&] { return manager.loadRecipesParallel(path, threads); });
+            std::cout << "loadRecipesParallel(" << threads << "): " << ms
+                      << " ms, speedup x" << baseline / ms << std::endl;
+        }
+    }
+
+    const std::string bundlePath = "bench_encyclopedia.bundle";
+    std::cout << "== " << bundlePath << std::endl;
+    timeLoad([&] { return RecipeEncyclopediaManager::compileBundle(arrayPath, bundlePath); });
+    RecipeEncyclopediaManager manager;
+    double ms = timeLoad([&] { return manager.loadBundle(bundlePath, arrayPath); });
+    std::cout << "loadBundle: " << ms << " ms" << std::endl;
+    auto start = Clock::now();
+    std::size_t hits = manager.searchRecipes("测试菜谱 4242").size();
+    std::cout << "first search after loadBundle: "
+              << std::chrono::duration<double, std::milli>(Clock::now() - start).count()
+              << " ms (" << hits << " hits)" << std::endl;
+
+    std::remove(arrayPath.c_str());
+    std::remove(ndjsonPath.c_str());
+    std::remove(bundlePath.c_str());
+    return 0;
+}
@@ -0,0 +1,77 @@
+// Micro-benchmark for encyclopedia ID lookups at 1M entries.
+// Compares the dense offset table, the hash-map fallback and the previous
+// linear scan. Build with -DRECIPE_BUILD_BENCHMARKS=ON.
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "logic/search/IdPositionIndex.h"
+
+using RecipeApp::Logic::Search::IdPositionIndex;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+constexpr std::size_t kEntries = 1000000;
+constexpr std::size_t kLookups = 10000000;
+constexpr std::size_t kLinearLookups = 2000;
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void report(const std::string& name, double ms, std::size_t ops, std::uint64_t checksum) {
+    std::cout << name << ": " << ms << " ms total, " << (ms * 1e6 / ops)
+              << " ns/lookup (checksum " << checksum << ")" << std::endl;
+}
+
+void benchIndex(const std::string& label, const std::vector<int>& ids, std::mt19937& rng) {
+    auto start = Clock::now();
+    IdPositionIndex index;
+    index.build(ids);
+    std::cout << label << " build (" << (index.isDense() ? "dense" : "hash")
+              << "): " << elapsedMs(start) << " ms" << std::endl;
+
+    std::uniform_int_distribution<std::size_t> pick(0, ids.size() - 1);
+    std::vector<int> queries(kLookups);
+    for (auto& q : queries) q = ids[pick(rng)];
+
+    std::uint64_t checksum = 0;
+    start = Clock::now();
+    for (int id : queries) checksum += index.find(id);
+    report(label + " lookup", elapsedMs(start), kLookups, checksum);
+}
+}  // namespace
+
+int main() {
+    std::mt19937 rng(2024);
+
+    // Compact IDs, as in data/encyclopedia_recipes.json (1001, 1002, ...)
+    std::vector<int> denseIds(kEntries);
+    for (std::size_t i = 0; i < kEntries; ++i) denseIds[i] = static_cast<int>(1001 + i);
+    benchIndex("dense ids", denseIds, rng);
+
+    // Scattered IDs force the hash-map fallback
+    std::vector<int> sparseIds(kEntries);
+    std::uniform_int_distribution<int> scatter(1, 1 << 30);
+    for (auto& id : sparseIds) id = scatter(rng);
+    benchIndex("sparse ids", sparseIds, rng);
+
+    // Baseline: the previous linear scan over the record array
+    std::uniform_int_distribution<std::size_t> pick(0, kEntries - 1);
+    std::uint64_t checksum = 0;
+    auto start = Clock::now();
+    for (std::size_t n = 0; n < kLinearLookups; ++n) {
+        int id = denseIds[pick(rng)];
+        for (std::size_t i = 0; i < denseIds.size(); ++i) {
+            if (denseIds[i] == id) {
+                checksum += i;
+                break;
+            }
+        }
+    }
+    report("linear scan", elapsedMs(start), kLinearLookups, checksum);
+    return 0;
+}
@@ -0,0 +1,92 @@
+// Micro-benchmark for restaurant proximity queries at 1M points.
+// Measures k-nearest, radius and map-viewport queries on GeoGridIndex
+// against a linear scan. Build with -DRECIPE_BUILD_BENCHMARKS=ON.
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "logic/search/GeoGridIndex.h"
+
+using RecipeApp::GeoPoint;
+using RecipeApp::Logic::Search::GeoGridIndex;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+constexpr std::size_t kPoints = 1000000;
+constexpr std::size_t kQueries = 10000;
+constexpr std::size_t kLinearQueries = 50;
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void report(const std::string& name, double ms, std::size_t ops, std::uint64_t checksum) {
+    std::cout << name << ": " << ms << " ms total, " << (ms * 1e3 / ops)
+              << " us/query (checksum " << checksum << ")" << std::endl;
+}
+}  // namespace
+
+int main() {
+    std::mt19937 rng(2024);
+    // Ten metropolitan clusters, ~10 km spread each
+    std::uniform_real_distribution<double> centerLat(-50, 60), centerLon(-180, 180);
+    std::normal_distribution<double> spread(0, 0.1);
+    std::vector<GeoPoint> centers(10);
+    for (auto& c : centers) c = {centerLat(rng), centerLon(rng)};
+    std::uniform_int_distribution<std::size_t> pickCenter(0, centers.size() - 1);
+    auto nearCenter = [&] {
+        const GeoPoint& c = centers[pickCenter(rng)];
+        double lon = c.longitude + spread(rng);
+        if (lon >= 180) lon -= 360;
+        if (lon < -180) lon += 360;
+        return GeoPoint{c.latitude + spread(rng), lon};
+    };
+    std::vector<GeoPoint> points(kPoints);
+    for (auto& p : points) p = nearCenter();
+
+    auto start = Clock::now();
+    GeoGridIndex index;
+    for (std::size_t i = 0; i < points.size(); ++i) index.insert(static_cast<int>(i), points[i]);
+    std::cout << "build: " << elapsedMs(start) << " ms" << std::endl;
+
+    std::vector<GeoPoint> queries(kQueries);
+    for (auto& q : queries) q = nearCenter();
+
+    std::uint64_t checksum = 0;
+    start = Clock::now();
+    for (const auto& q : queries) checksum += index.nearest(q, 10).front().key;
+    report("grid 10-nearest", elapsedMs(start), kQueries, checksum);
+
+    checksum = 0;
+    start = Clock::now();
+    for (const auto& q : queries) checksum += index.withinRadius(q, 1000).size();
+    report("grid radius 1 km", elapsedMs(start), kQueries, checksum);
+
+    // A ~5 km x 5 km map viewport, capped at 500 markers
+    checksum = 0;
+    start = Clock::now();
+    for (const auto& q : queries) {
+        checksum += index.withinBounds(q.latitude - 0.025, q.longitude - 0.03, q.latitude + 0.025,
+                                       q.longitude + 0.03, 500)
+                        .size();
+    }
+    report("grid viewport", elapsedMs(start), kQueries, checksum);
+
+    checksum = 0;
+    start = Clock::now();
+    for (std::size_t i = 0; i < kLinearQueries; ++i) {
+        const GeoPoint& q = queries[i];
+        std::vector<std::pair<double, int>> ranked(points.size());
+        for (std::size_t j = 0; j < points.size(); ++j) {
+            ranked[j] = {GeoPoint::distanceMeters(q, points[j]), static_cast<int>(j)};
+        }
+        std::partial_sort(ranked.begin(), ranked.begin() + 10, ranked.end());
+        checksum += ranked.front().second;
+    }
+    report("linear 10-nearest", elapsedMs(start), kLinearQueries, checksum);
+    return 0;
+}
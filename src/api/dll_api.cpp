@@ -1,4 +1,13 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>   // 用于调试输出
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <stdexcept>  // 用于异常处理
 #include <string>
 #include <vector>
@@ -7,7 +16,9 @@
 #include "../domain/recipe/Recipe.h"
 #include "../logic/encyclopedia/RecipeEncyclopediaManager.h"  // Added for encyclopedia
 #include "../logic/recipe/RecipeManager.h"
+#include "../logic/restaurant/RestaurantManager.h"
 #include "../persistence/JsonRecipeRepository.h"  // Added for JsonRecipeRepository
+#include "../persistence/JsonRestaurantRepository.h"
 
 // --- DLL 导出宏定义 ---
 #ifdef _WIN32
@@ -38,15 +49,192 @@ static char *strcpy_to_new_char_buffer(const std::string &s) {
     return buffer;
 }
 
+// nlohmann 输出适配器: 直接写入调用方缓冲区，超出容量后只计数不写入
+class CallerBufferOutputAdapter
+    : public nlohmann::detail::output_adapter_protocol<char> {
+   public:
+    CallerBufferOutputAdapter(char *buffer, std::size_t capacity)
+        : buffer_(buffer), capacity_(capacity) {}
+
+    void write_character(char c) override { write_characters(&c, 1); }
+
+    void write_characters(const char *s, std::size_t length) override {
+        // 预留 1 字节给结尾的 '\0'
+        if (buffer_ && size_ + length < capacity_) {
+            std::memcpy(buffer_ + size_, s, length);
+        }
+        size_ += length;
+    }
+
+    std::size_t size() const { return size_; }
+
+   private:
+    char *buffer_;
+    std::size_t capacity_;
+    std::size_t size_ = 0;
+};
+
+// 将 JSON 序列化到调用方缓冲区，不经过中间 std::string。
+// 返回所需字节数 (含结尾 '\0')；大于 capacity 时缓冲区内容无效 (置为空串)。
+static std::size_t dump_json_to_buffer(const json &value, char *buffer,
+                                       std::size_t capacity) {
+    auto adapter =
+        std::make_shared<CallerBufferOutputAdapter>(buffer, capacity);
+    nlohmann::detail::serializer<json> serializer(adapter, ' ');
+    serializer.dump(value, false, false, 0);
+    std::size_t required = adapter->size() + 1;
+    if (buffer && capacity > 0) {
+        buffer[required <= capacity ? required - 1 : 0] = '\0';
+    }
+    return required;
+}
+
+// 调用 build() 生成结果；build 抛出的异常转为 {"error": ...}
+template <typename Build>
+static json run_query(const char *function_name, Build build) {
+    try {
+        return build();
+    } catch (const std::exception &e) {
+        return json{{"error", "[DLL] Exception in " +
+                                  std::string(function_name) + ": " +
+                                  e.what()}};
+    } catch (...) {
+        return json{{"error", "[DLL] Unknown exception in " +
+                                  std::string(function_name) + "."}};
+    }
+}
+
+// 调用 build() 生成结果并写入调用方缓冲区
+template <typename Build>
+static std::size_t write_json_result(const char *function_name, char *buffer,
+                                     std::size_t capacity, Build build) {
+    return dump_json_to_buffer(run_query(function_name, build), buffer,
+                               capacity);
+}
+
+static json recipes_to_json(const std::vector<Recipe> &recipes) {
+    json json_array = json::array();
+    for (const auto &recipe : recipes) {
+        json_array.push_back(recipe);  // Uses RecipeApp::to_json via ADL
+    }
+    return json_array;
+}
+
+// Serializes search hits as [{"recipe": {...}, "matches": [{"field", "index",
+// "offset", "length"}, ...]}, ...]; offsets are UTF-8 byte offsets into the
+// named field (index selects the ingredient or tag).
+static json search_hits_to_json(
+    const std::vector<Logic::Search::RecipeSearchHit> &hits) {
+    json json_array = json::array();
+    for (const auto &hit : hits) {
+        json matches = json::array();
+        for (const auto &match : hit.matches) {
+            matches.push_back({{"field", Logic::Search::matchFieldName(match.field)},
+                               {"index", match.fieldIndex},
+                               {"offset", match.offset},
+                               {"length", match.length}});
+        }
+        json_array.push_back({{"recipe", hit.recipe}, {"matches", matches}});
+    }
+    return json_array;
+}
+
+// Serializes MenuAggregates as {"restaurantId", "recipeCount",
+// "totalCookingTime", "averageCookingTime", "difficulty": {"Easy", "Medium",
+// "Hard"}, "tags": [{"tag", "count"}, ...]} with tags most frequent first.
+static json menu_aggregates_to_json(int restaurant_id,
+                                    const MenuAggregates &aggregates) {
+    json tags = json::array();
+    for (const auto &entry : aggregates.topTags(aggregates.tagCounts.size())) {
+        tags.push_back({{"tag", entry.first}, {"count", entry.second}});
+    }
+    return json{{"restaurantId", restaurant_id},
+                {"recipeCount", aggregates.recipeCount},
+                {"totalCookingTime", aggregates.totalCookingTime},
+                {"averageCookingTime", aggregates.averageCookingTime()},
+                {"difficulty",
+                 {{"Easy", aggregates.difficultyCounts[0]},
+                  {"Medium", aggregates.difficultyCounts[1]},
+                  {"Hard", aggregates.difficultyCounts[2]}}},
+                {"tags", tags}};
+}
+
 // --- DLL 内部静态实例 ---
 static RecipeManager *global_recipe_manager_ptr = nullptr;
-static Domain::Recipe::RecipeRepository *global_recipe_repository_ptr =
-    nullptr;  // 使用接口类型
-// 如果确定只用Json实现，也可以是 JsonRecipeRepository*
-// static Persistence::JsonRecipeRepository* global_json_recipe_repository_ptr =
-// nullptr;
+// 保存具体类型: RecipeRepository 是虚基类，无法再 static_cast 回派生类删除
+static Persistence::JsonRecipeRepository *global_recipe_repository_ptr =
+    nullptr;
 static RecipeApp::Logic::Encyclopedia::RecipeEncyclopediaManager
     *global_encyclopedia_manager_ptr = nullptr;
+static Persistence::JsonRestaurantRepository *global_restaurant_repository_ptr =
+    nullptr;
+static RestaurantManager *global_restaurant_manager_ptr = nullptr;
+
+// --- 并发控制 ---
+// 宿主可能从线程池并发调用本 API。所有调用共享持有 global_lifecycle_mutex，
+// initialize/shutdown 独占持有它，因此不会与任何调用交错。
+// 菜谱与餐馆数据 (餐馆管理器监听菜谱变更) 另由 global_recipe_data_mutex 保护:
+// 查询共享持有，增删改独占持有。食谱大全由 global_encyclopedia_mutex 单独保护:
+// 查询共享持有 (惰性解码自带互斥)，apply_encyclopedia_patch 独占持有，
+// 因此两类数据互不阻塞。加锁顺序: 生命周期锁 -> 数据锁。
+static std::shared_mutex global_lifecycle_mutex;
+static std::shared_mutex global_recipe_data_mutex;
+static std::shared_mutex global_encyclopedia_mutex;
+static int global_init_count = 0;  // initialize_recipe_system 的引用计数
+// 每次真正初始化时递增，使之前打开的游标失效
+static unsigned global_system_generation = 0;
+// 每次应用补丁时递增，使之前打开的食谱大全游标失效 (补丁会移动文件位置)
+static unsigned global_encyclopedia_version = 0;
+
+// 写者排队时先占住此闸门，新到的读者在闸门处等待，避免读多写少时写者饥饿
+// (std::shared_mutex 在部分平台上偏向读者)。
+static std::mutex global_writer_turnstile;
+static std::mutex global_encyclopedia_writer_turnstile;
+
+// 查询菜谱/餐馆数据时持有
+class RecipeDataReadLock {
+   public:
+    RecipeDataReadLock() : lifecycle_(global_lifecycle_mutex) {
+        { std::lock_guard<std::mutex> turnstile(global_writer_turnstile); }
+        data_ = std::shared_lock<std::shared_mutex>(global_recipe_data_mutex);
+    }
+
+   private:
+    std::shared_lock<std::shared_mutex> lifecycle_;
+    std::shared_lock<std::shared_mutex> data_;
+};
+
+// 修改菜谱数据时持有
+class RecipeDataWriteLock {
+   private:
+    std::shared_lock<std::shared_mutex> lifecycle_{global_lifecycle_mutex};
+    std::lock_guard<std::mutex> turnstile_{global_writer_turnstile};
+    std::unique_lock<std::shared_mutex> data_{global_recipe_data_mutex};
+};
+
+// 查询食谱大全时持有
+class EncyclopediaReadLock {
+   public:
+    EncyclopediaReadLock() : lifecycle_(global_lifecycle_mutex) {
+        {
+            std::lock_guard<std::mutex> turnstile(
+                global_encyclopedia_writer_turnstile);
+        }
+        data_ = std::shared_lock<std::shared_mutex>(global_encyclopedia_mutex);
+    }
+
+   private:
+    std::shared_lock<std::shared_mutex> lifecycle_;
+    std::shared_lock<std::shared_mutex> data_;
+};
+
+// 修改食谱大全 (应用补丁) 时持有
+class EncyclopediaWriteLock {
+   private:
+    std::shared_lock<std::shared_mutex> lifecycle_{global_lifecycle_mutex};
+    std::lock_guard<std::mutex> turnstile_{global_encyclopedia_writer_turnstile};
+    std::unique_lock<std::shared_mutex> data_{global_encyclopedia_mutex};
+};
 
 // --- 导出函数实现 ---
 
@@ -56,8 +244,17 @@ extern "C" {
  * @brief (可选) 初始化菜谱系统。
  *        例如，可以在这里从文件加载数据到 RecipeManager。
  *        Python 端应在开始使用其他 API 前调用此函数（如果需要）。
+ *        可重复调用: 只有第一次调用真正初始化，之后仅增加引用计数；
+ *        每次调用都应对应一次 shutdown_recipe_system()。
  */
 DLL_EXPORT void initialize_recipe_system() {
+    std::unique_lock<std::shared_mutex> lifecycle(global_lifecycle_mutex);
+    if (global_init_count++ > 0) {
+        std::cout << "[DLL] Recipe system already initialized (references: "
+                  << global_init_count << ")." << std::endl;
+        return;
+    }
+    ++global_system_generation;
     try {
         // Define baseDir earlier to be accessible by both manager
         // initializations
@@ -99,13 +296,38 @@ DLL_EXPORT void initialize_recipe_system() {
                       << std::endl;
         }
 
+        // 餐馆管理器: 跟随菜谱删除，并维护各餐馆的菜单统计
+        if (global_restaurant_manager_ptr == nullptr &&
+            global_recipe_manager_ptr != nullptr) {
+            global_restaurant_repository_ptr =
+                new Persistence::JsonRestaurantRepository(baseDir,
+                                                          "restaurants.json");
+            if (!global_restaurant_repository_ptr->load()) {
+                std::cout << "[DLL] Failed to load restaurant data, or "
+                             "starting fresh."
+                          << std::endl;
+            }
+            global_restaurant_manager_ptr =
+                new RestaurantManager(*global_restaurant_repository_ptr);
+            global_restaurant_manager_ptr->followRecipeDeletions(
+                *global_recipe_manager_ptr);
+            global_restaurant_manager_ptr->trackMenuAggregates(
+                *global_recipe_manager_ptr);
+            std::cout << "[DLL] RestaurantManager initialized." << std::endl;
+        }
+
         // Initialize Encyclopedia Manager
         if (global_encyclopedia_manager_ptr == nullptr) {
             global_encyclopedia_manager_ptr =
                 new RecipeApp::Logic::Encyclopedia::RecipeEncyclopediaManager();
             std::filesystem::path encyclopediaDataPath =
                 baseDir / "encyclopedia_recipes.json";
-            if (global_encyclopedia_manager_ptr->loadRecipes(
+            // 预编译的二进制包与 JSON 一致时直接映射使用，否则按文件大小
+            // 选择按需加载或并行解析
+            std::filesystem::path encyclopediaBundlePath =
+                baseDir / "encyclopedia_recipes.bundle";
+            if (global_encyclopedia_manager_ptr->loadPreferringBundle(
+                    encyclopediaBundlePath.string(),
                     encyclopediaDataPath.string())) {
                 std::cout << "[DLL] Recipe Encyclopedia data loaded."
                           << std::endl;
@@ -189,8 +411,20 @@ DLL_EXPORT void initialize_recipe_system() {
  * @brief (可选) 关闭菜谱系统。
  *        例如，可以在这里将数据保存到文件。
  *        Python 端应在应用程序退出前调用此函数（如果需要）。
+ *        引用计数归零时才真正释放，等待进行中的调用结束后执行。
  */
 DLL_EXPORT void shutdown_recipe_system() {
+    std::unique_lock<std::shared_mutex> lifecycle(global_lifecycle_mutex);
+    if (global_init_count == 0) {
+        std::cout << "[DLL] shutdown_recipe_system called without initialization."
+                  << std::endl;
+        return;
+    }
+    if (--global_init_count > 0) {
+        std::cout << "[DLL] Recipe system still referenced ("
+                  << global_init_count << ")." << std::endl;
+        return;
+    }
     try {
         // 示例: 尝试保存数据 (如果仓库有 saveAll 方法)
         // if (global_json_recipe_repository_ptr)
@@ -198,13 +432,16 @@ DLL_EXPORT void shutdown_recipe_system() {
         // (如果它提供了保存所有数据的接口)
         std::cout << "[DLL] shutdown_recipe_system called." << std::endl;
 
+        // 餐馆管理器在菜谱管理器上注册了监听器，须先释放
+        delete global_restaurant_manager_ptr;
+        global_restaurant_manager_ptr = nullptr;
+        delete global_restaurant_repository_ptr;
+        global_restaurant_repository_ptr = nullptr;
+
         delete global_recipe_manager_ptr;
         global_recipe_manager_ptr = nullptr;
 
-        // 如果 global_recipe_repository_ptr 是 new 出来的 JsonRecipeRepository*
-        // 那么也需要 delete 它
-        delete static_cast<RecipeApp::Persistence::JsonRecipeRepository *>(
-            global_recipe_repository_ptr);
+        delete global_recipe_repository_ptr;
         global_recipe_repository_ptr = nullptr;
 
         delete global_encyclopedia_manager_ptr;
@@ -230,6 +467,7 @@ DLL_EXPORT void shutdown_recipe_system() {
  * 字符串的指针（也需要释放），或返回 nullptr。
  */
 DLL_EXPORT char *get_all_recipes_json_alloc() {
+    RecipeDataReadLock lock;
     std::cout << "[DLL DEBUG] Entered get_all_recipes_json_alloc."
               << std::endl;  // DEBUG
     try {
@@ -361,6 +599,7 @@ DLL_EXPORT void free_allocated_string(char *str_ptr) {
  *         调用者必须使用 free_allocated_string() 释放此内存。
  */
 DLL_EXPORT char *add_recipe_json(const char *recipe_json_str) {
+    RecipeDataWriteLock lock;
     std::cout << "[DLL DEBUG] Entered add_recipe_json." << std::endl;
     try {
         if (!recipe_json_str) {
@@ -516,6 +755,7 @@ DLL_EXPORT char *add_recipe_json(const char *recipe_json_str) {
  *         调用者必须使用 free_allocated_string() 释放此内存。
  */
 DLL_EXPORT char *get_recipe_by_id_json(int recipe_id) {
+    RecipeDataReadLock lock;
     std::cout << "[DLL DEBUG] Entered get_recipe_by_id_json with ID: "
               << recipe_id << std::endl;
     try {
@@ -599,6 +839,7 @@ DLL_EXPORT char *get_recipe_by_id_json(int recipe_id) {
 }
 
 DLL_EXPORT char *update_recipe_json(const char *recipe_json_str) {
+    RecipeDataWriteLock lock;
     std::cout << "[DLL DEBUG] Entered update_recipe_json." << std::endl;
     try {
         if (!global_recipe_manager_ptr) {
@@ -673,6 +914,7 @@ DLL_EXPORT char *update_recipe_json(const char *recipe_json_str) {
 }
 
 DLL_EXPORT char *delete_recipe_json(int recipe_id) {
+    RecipeDataWriteLock lock;
     std::cout << "[DLL DEBUG] Entered delete_recipe_json for ID: " << recipe_id
               << std::endl;
     try {
@@ -687,8 +929,17 @@ DLL_EXPORT char *delete_recipe_json(int recipe_id) {
         if (success) {
             std::cout << "[DLL] Recipe with ID " << recipe_id
                       << " deleted successfully." << std::endl;
-            return strcpy_to_new_char_buffer(
-                json{{"success", true}, {"id", recipe_id}}.dump());
+            json result{{"success", true}, {"id", recipe_id}};
+            // 菜谱已删除，但从餐馆招牌菜中移除它的操作未能保存 (稍后自动重试)
+            if (global_restaurant_manager_ptr &&
+                global_restaurant_manager_ptr->pendingRecipeReferenceRemovals()
+                    .count(recipe_id)) {
+                result["warning"] =
+                    "Recipe deleted, but removing it from restaurant featured "
+                    "lists failed to save; it will be retried on the next "
+                    "restaurant change.";
+            }
+            return strcpy_to_new_char_buffer(result.dump());
         } else {
             std::cout << "[DLL] Failed to delete recipe with ID " << recipe_id
                       << ". May not exist." << std::endl;
@@ -714,6 +965,8 @@ DLL_EXPORT char *delete_recipe_json(int recipe_id) {
 
 // --- New functions for Recipe Encyclopedia ---
 
+extern "C" {
+
 /**
  * @brief 获取食谱大全中所有菜谱的 JSON 字符串表示。
  * @return char* 指向包含 JSON 数组字符串的内存。
@@ -721,6 +974,7 @@ DLL_EXPORT char *delete_recipe_json(int recipe_id) {
  *         如果发生错误或未初始化，返回错误信息的 JSON 字符串。
  */
 DLL_EXPORT char *get_all_encyclopedia_recipes_json_alloc() {
+    EncyclopediaReadLock lock;
     std::cout << "[DLL DEBUG] Entered get_all_encyclopedia_recipes_json_alloc."
               << std::endl;
     try {
@@ -781,6 +1035,7 @@ DLL_EXPORT char *get_all_encyclopedia_recipes_json_alloc() {
  */
 DLL_EXPORT char *search_encyclopedia_recipes_json_alloc(
     const char *search_term_str) {
+    EncyclopediaReadLock lock;
     std::cout << "[DLL DEBUG] Entered search_encyclopedia_recipes_json_alloc."
               << std::endl;
     try {
@@ -846,4 +1101,724 @@ DLL_EXPORT char *search_encyclopedia_recipes_json_alloc(
         strcpy(error_buffer, error_json_s.c_str());
         return error_buffer;
     }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief 与 search_encyclopedia_recipes_json_alloc 相同的搜索，但每个结果附带匹配位置，
+ *        前端可直接高亮而无需重新扫描菜谱。
+ * @param search_term_str 要搜索的关键词字符串。
+ * @return char* 指向 [{"recipe": {...}, "matches": [{"field": "name"|"ingredient"|"tag",
+ *         "index": n, "offset": 字节偏移, "length": 字节长度}]}] 或错误信息的 JSON 字符串。
+ *         调用者必须使用 free_allocated_string() 释放此内存。
+ */
+DLL_EXPORT char *search_encyclopedia_recipes_with_matches_json_alloc(
+    const char *search_term_str) {
+    EncyclopediaReadLock lock;
+    try {
+        if (!global_encyclopedia_manager_ptr) {
+            return strcpy_to_new_char_buffer(
+                json{{"error",
+                      "[DLL] Error: RecipeEncyclopediaManager not initialized."}}
+                    .dump());
+        }
+        if (!search_term_str) {
+            return strcpy_to_new_char_buffer(
+                json{{"error", "[DLL] Error: Null search term provided."}}.dump());
+        }
+        return strcpy_to_new_char_buffer(
+            search_hits_to_json(
+                global_encyclopedia_manager_ptr->searchRecipesWithMatches(
+                    search_term_str))
+                .dump());
+    } catch (const std::exception &e) {
+        return strcpy_to_new_char_buffer(
+            json{{"error",
+                  "[DLL] Exception in "
+                  "search_encyclopedia_recipes_with_matches_json_alloc: " +
+                      std::string(e.what())}}
+                .dump());
+    } catch (...) {
+        return strcpy_to_new_char_buffer(
+            json{{"error",
+                  "[DLL] Unknown exception in "
+                  "search_encyclopedia_recipes_with_matches_json_alloc."}}
+                .dump());
+    }
+}
+
+/**
+ * @brief 将增量补丁应用到已加载的食谱大全，无需重新加载整个文件。
+ *        按需加载与二进制包模式下补丁保存在覆盖层中，不会解码全部菜谱。
+ *        补丁格式见 RecipeEncyclopediaManager::applyPatch。应用期间食谱大全
+ *        查询会等待；之前打开的食谱大全游标将失效。
+ * @param patch_file_path 补丁文件路径 (JSON 数组或 NDJSON)。
+ * @return char* 指向 {"success": true, "added": n, "replaced": n, "removed": n,
+ *         "skipped": n} 或 {"success": false, "error": "..."} 的 JSON 字符串。
+ *         调用者必须使用 free_allocated_string() 释放此内存。
+ */
+DLL_EXPORT char *apply_encyclopedia_patch(const char *patch_file_path) {
+    EncyclopediaWriteLock lock;
+    try {
+        if (!global_encyclopedia_manager_ptr) {
+            return strcpy_to_new_char_buffer(
+                json{{"success", false},
+                     {"error", "RecipeEncyclopediaManager not initialized."}}
+                    .dump());
+        }
+        if (!patch_file_path) {
+            return strcpy_to_new_char_buffer(
+                json{{"success", false}, {"error", "Null patch file path."}}
+                    .dump());
+        }
+        RecipeApp::Logic::Encyclopedia::RecipeEncyclopediaManager::PatchSummary
+            summary;
+        if (!global_encyclopedia_manager_ptr->applyPatch(patch_file_path,
+                                                         &summary)) {
+            return strcpy_to_new_char_buffer(
+                json{{"success", false},
+                     {"error",
+                      "Failed to read or parse the patch file; the "
+                      "encyclopedia is unchanged."}}
+                    .dump());
+        }
+        ++global_encyclopedia_version;
+        return strcpy_to_new_char_buffer(json{{"success", true},
+                                              {"added", summary.added},
+                                              {"replaced", summary.replaced},
+                                              {"removed", summary.removed},
+                                              {"skipped", summary.skipped}}
+                                             .dump());
+    } catch (const std::exception &e) {
+        return strcpy_to_new_char_buffer(
+            json{{"success", false},
+                 {"error", "Standard exception: " + std::string(e.what())}}
+                .dump());
+    } catch (...) {
+        return strcpy_to_new_char_buffer(
+            json{{"success", false},
+                 {"error", "Unknown exception in apply_encyclopedia_patch."}}
+                .dump());
+    }
+}
+
+/**
+ * @brief 按名称片段 (不区分大小写) 搜索用户菜谱，每个结果附带名称中的匹配位置。
+ * @param name_query_str 名称片段。
+ * @return char* 指向与 search_encyclopedia_recipes_with_matches_json_alloc 格式相同的
+ *         JSON 数组或错误信息。调用者必须使用 free_allocated_string() 释放此内存。
+ */
+DLL_EXPORT char *search_recipes_by_name_with_matches_json_alloc(
+    const char *name_query_str) {
+    RecipeDataReadLock lock;
+    try {
+        if (!global_recipe_manager_ptr) {
+            return strcpy_to_new_char_buffer(
+                json{{"error", "[DLL] Error: RecipeManager not initialized."}}
+                    .dump());
+        }
+        if (!name_query_str) {
+            return strcpy_to_new_char_buffer(
+                json{{"error", "[DLL] Error: Null search term provided."}}.dump());
+        }
+        return strcpy_to_new_char_buffer(
+            search_hits_to_json(
+                global_recipe_manager_ptr->findRecipeByNameWithMatches(
+                    name_query_str, true))
+                .dump());
+    } catch (const std::exception &e) {
+        return strcpy_to_new_char_buffer(
+            json{{"error",
+                  "[DLL] Exception in "
+                  "search_recipes_by_name_with_matches_json_alloc: " +
+                      std::string(e.what())}}
+                .dump());
+    } catch (...) {
+        return strcpy_to_new_char_buffer(
+            json{{"error",
+                  "[DLL] Unknown exception in "
+                  "search_recipes_by_name_with_matches_json_alloc."}}
+                .dump());
+    }
+}
+
+/**
+ * @brief 获取餐馆特色菜谱的菜单统计 (菜谱数、总/平均烹饪时间、难度分布、标签分布)。
+ *        统计随特色菜谱列表或菜谱字段的变更增量维护，本调用为 O(1) 查表。
+ * @param restaurant_id 餐馆 ID。
+ * @return char* 指向 {"restaurantId", "recipeCount", "totalCookingTime",
+ *         "averageCookingTime", "difficulty": {"Easy", "Medium", "Hard"},
+ *         "tags": [{"tag", "count"}]} 或错误信息的 JSON 字符串。
+ *         调用者必须使用 free_allocated_string() 释放此内存。
+ */
+DLL_EXPORT char *get_restaurant_menu_aggregates_json_alloc(int restaurant_id) {
+    RecipeDataReadLock lock;
+    try {
+        if (!global_restaurant_manager_ptr) {
+            return strcpy_to_new_char_buffer(
+                json{{"error", "[DLL] Error: RestaurantManager not initialized."}}
+                    .dump());
+        }
+        auto aggregates =
+            global_restaurant_manager_ptr->getMenuAggregates(restaurant_id);
+        if (!aggregates) {
+            return strcpy_to_new_char_buffer(
+                json{{"error", "[DLL] Restaurant with ID " +
+                                   std::to_string(restaurant_id) +
+                                   " not found."}}
+                    .dump());
+        }
+        return strcpy_to_new_char_buffer(
+            menu_aggregates_to_json(restaurant_id, *aggregates).dump());
+    } catch (const std::exception &e) {
+        return strcpy_to_new_char_buffer(
+            json{{"error",
+                  "[DLL] Exception in get_restaurant_menu_aggregates_json_alloc: " +
+                      std::string(e.what())}}
+                .dump());
+    } catch (...) {
+        return strcpy_to_new_char_buffer(
+            json{{"error",
+                  "[DLL] Unknown exception in "
+                  "get_restaurant_menu_aggregates_json_alloc."}}
+                .dump());
+    }
+}
+
+}  // extern "C"
+
+// --- 查询 ---
+// 以下函数在持锁期间生成结果 JSON，供 *_json_into 与二进制编码变体共用；
+// 序列化在释放锁之后进行。
+
+static json query_all_recipes() {
+    RecipeDataReadLock lock;
+    if (!global_recipe_manager_ptr) {
+        return {{"error", "[DLL] Error: RecipeManager not initialized."}};
+    }
+    return recipes_to_json(global_recipe_manager_ptr->getAllRecipes());
+}
+
+static json query_recipe_by_id(int recipe_id) {
+    RecipeDataReadLock lock;
+    if (!global_recipe_manager_ptr) {
+        return {{"success", false},
+                {"error", "[DLL] Error: RecipeManager not initialized."}};
+    }
+    auto recipe = global_recipe_manager_ptr->findRecipeById(recipe_id);
+    if (!recipe) {
+        return {{"success", false}, {"error", "Recipe not found"}};
+    }
+    return *recipe;
+}
+
+static json query_all_encyclopedia_recipes() {
+    EncyclopediaReadLock lock;
+    if (!global_encyclopedia_manager_ptr) {
+        return {{"error",
+                 "[DLL] Error: RecipeEncyclopediaManager not initialized."}};
+    }
+    return recipes_to_json(global_encyclopedia_manager_ptr->getAllRecipes());
+}
+
+static json query_encyclopedia_search(const char *search_term_str) {
+    EncyclopediaReadLock lock;
+    if (!global_encyclopedia_manager_ptr) {
+        return {{"error",
+                 "[DLL] Error: RecipeEncyclopediaManager not initialized."}};
+    }
+    if (!search_term_str) {
+        return {{"error", "[DLL] Error: Null search term provided."}};
+    }
+    return recipes_to_json(
+        global_encyclopedia_manager_ptr->searchRecipes(search_term_str));
+}
+
+static json query_encyclopedia_search_with_matches(
+    const char *search_term_str) {
+    EncyclopediaReadLock lock;
+    if (!global_encyclopedia_manager_ptr) {
+        return {{"error",
+                 "[DLL] Error: RecipeEncyclopediaManager not initialized."}};
+    }
+    if (!search_term_str) {
+        return {{"error", "[DLL] Error: Null search term provided."}};
+    }
+    return search_hits_to_json(
+        global_encyclopedia_manager_ptr->searchRecipesWithMatches(
+            search_term_str));
+}
+
+static json query_recipe_name_search_with_matches(
+    const char *name_query_str) {
+    RecipeDataReadLock lock;
+    if (!global_recipe_manager_ptr) {
+        return {{"error", "[DLL] Error: RecipeManager not initialized."}};
+    }
+    if (!name_query_str) {
+        return {{"error", "[DLL] Error: Null search term provided."}};
+    }
+    return search_hits_to_json(
+        global_recipe_manager_ptr->findRecipeByNameWithMatches(
+            name_query_str, true));
+}
+
+static json query_menu_aggregates(int restaurant_id) {
+    RecipeDataReadLock lock;
+    if (!global_restaurant_manager_ptr) {
+        return {{"error", "[DLL] Error: RestaurantManager not initialized."}};
+    }
+    auto aggregates =
+        global_restaurant_manager_ptr->getMenuAggregates(restaurant_id);
+    if (!aggregates) {
+        return {{"error", "[DLL] Restaurant with ID " +
+                              std::to_string(restaurant_id) + " not found."}};
+    }
+    return menu_aggregates_to_json(restaurant_id, *aggregates);
+}
+
+// --- 调用方缓冲区变体 ---
+//
+// 每个 *_json_into 函数与对应的 *_json_alloc / *_json 函数返回相同的 JSON，
+// 但直接序列化进调用方提供的 buffer (容量 capacity 字节)，无需
+// free_allocated_string()。协议:
+//   - 返回值为所需字节数 (含结尾 '\0')。
+//   - 返回值 <= capacity 时 buffer 中为完整的 JSON 字符串。
+//   - 否则 buffer 置为空串，调用方应分配至少返回值大小的缓冲区后重试。
+//   - buffer 为 NULL 且 capacity 为 0 时仅查询所需大小。
+// 对大结果，先用一个估计足够的缓冲区调用可避免第二次序列化。
+
+extern "C" {
+
+/// 与 get_all_recipes_json_alloc() 相同的 JSON，写入调用方缓冲区。
+DLL_EXPORT std::size_t get_all_recipes_json_into(char *buffer,
+                                                 std::size_t capacity) {
+    return write_json_result("get_all_recipes_json_into", buffer, capacity,
+                             [] { return query_all_recipes(); });
+}
+
+/// 与 get_recipe_by_id_json() 相同的 JSON，写入调用方缓冲区。
+DLL_EXPORT std::size_t get_recipe_by_id_json_into(int recipe_id, char *buffer,
+                                                  std::size_t capacity) {
+    return write_json_result("get_recipe_by_id_json_into", buffer, capacity,
+                             [&] { return query_recipe_by_id(recipe_id); });
+}
+
+/// 与 get_all_encyclopedia_recipes_json_alloc() 相同的 JSON，写入调用方缓冲区。
+DLL_EXPORT std::size_t get_all_encyclopedia_recipes_json_into(
+    char *buffer, std::size_t capacity) {
+    return write_json_result("get_all_encyclopedia_recipes_json_into", buffer,
+                             capacity,
+                             [] { return query_all_encyclopedia_recipes(); });
+}
+
+/// 与 search_encyclopedia_recipes_json_alloc() 相同的 JSON，写入调用方缓冲区。
+DLL_EXPORT std::size_t search_encyclopedia_recipes_json_into(
+    const char *search_term_str, char *buffer, std::size_t capacity) {
+    return write_json_result(
+        "search_encyclopedia_recipes_json_into", buffer, capacity,
+        [&] { return query_encyclopedia_search(search_term_str); });
+}
+
+/// 与 search_encyclopedia_recipes_with_matches_json_alloc() 相同的 JSON，写入调用方缓冲区。
+DLL_EXPORT std::size_t search_encyclopedia_recipes_with_matches_json_into(
+    const char *search_term_str, char *buffer, std::size_t capacity) {
+    return write_json_result(
+        "search_encyclopedia_recipes_with_matches_json_into", buffer, capacity,
+        [&] { return query_encyclopedia_search_with_matches(search_term_str); });
+}
+
+/// 与 search_recipes_by_name_with_matches_json_alloc() 相同的 JSON，写入调用方缓冲区。
+DLL_EXPORT std::size_t search_recipes_by_name_with_matches_json_into(
+    const char *name_query_str, char *buffer, std::size_t capacity) {
+    return write_json_result(
+        "search_recipes_by_name_with_matches_json_into", buffer, capacity,
+        [&] { return query_recipe_name_search_with_matches(name_query_str); });
+}
+
+/// 与 get_restaurant_menu_aggregates_json_alloc() 相同的 JSON，写入调用方缓冲区。
+DLL_EXPORT std::size_t get_restaurant_menu_aggregates_json_into(
+    int restaurant_id, char *buffer, std::size_t capacity) {
+    return write_json_result(
+        "get_restaurant_menu_aggregates_json_into", buffer, capacity,
+        [&] { return query_menu_aggregates(restaurant_id); });
+}
+
+}  // extern "C"
+
+// --- 结果游标 ---
+//
+// 游标按批次序列化大结果集，内存占用为 O(批次) 而不是整个目录的 JSON。
+// 打开时只记录匹配项的 ID (用户菜谱) 或文件位置 (食谱大全搜索)；
+// 遍历整个食谱大全时只记录区间。菜谱内容在取批次时才读取，期间被删除的
+// 菜谱会被跳过。同一游标不能被多个线程同时使用；每个游标须恰好关闭一次。
+
+struct RecipeCursor {
+    bool encyclopedia = false;
+    unsigned generation = 0;           // 打开时的 global_system_generation
+    unsigned encyclopediaVersion = 0;  // 打开时的 global_encyclopedia_version
+    std::vector<int> recipeIds;        // 用户菜谱: 匹配的 ID
+    std::vector<size_t> positions;     // 食谱大全搜索: 匹配的文件位置
+    size_t total = 0;                  // 条目数；食谱大全无搜索时为位置区间 [0, total)
+    size_t next = 0;
+};
+
+// 取出从 cursor->next 开始的最多 n 个菜谱 (不前移游标)；consumed 返回消耗的条目数。
+// 打开游标后被删除的用户菜谱会被跳过并继续向后读取，因此只有读到末尾时才返回空数组。
+static json cursor_batch_json(const RecipeCursor &cursor, int n,
+                              size_t &consumed) {
+    size_t end = std::min(cursor.total, cursor.next + static_cast<size_t>(n));
+    consumed = end - cursor.next;
+    if (cursor.encyclopedia) {
+        EncyclopediaReadLock lock;
+        if (!global_encyclopedia_manager_ptr ||
+            cursor.generation != global_system_generation) {
+            return {{"error", "[DLL] Error: Cursor invalidated by shutdown."}};
+        }
+        if (cursor.encyclopediaVersion != global_encyclopedia_version) {
+            return {{"error",
+                     "[DLL] Error: Cursor invalidated by an encyclopedia patch."}};
+        }
+        std::vector<size_t> batch;
+        if (cursor.positions.empty()) {
+            for (size_t i = cursor.next; i < end; ++i) batch.push_back(i);
+        } else {
+            batch.assign(cursor.positions.begin() + cursor.next,
+                         cursor.positions.begin() + end);
+        }
+        return recipes_to_json(
+            global_encyclopedia_manager_ptr->getRecipesAtPositions(batch));
+    }
+    RecipeDataReadLock lock;
+    if (!global_recipe_manager_ptr ||
+        cursor.generation != global_system_generation) {
+        return {{"error", "[DLL] Error: Cursor invalidated by shutdown."}};
+    }
+    std::vector<Recipe> batch;
+    size_t position = cursor.next;
+    while (batch.size() < static_cast<size_t>(n) && position < cursor.total) {
+        size_t window_end = std::min(
+            cursor.total, position + (static_cast<size_t>(n) - batch.size()));
+        std::vector<Recipe> live = global_recipe_manager_ptr->findRecipesByIds(
+            std::vector<int>(cursor.recipeIds.begin() + position,
+                             cursor.recipeIds.begin() + window_end));
+        std::move(live.begin(), live.end(), std::back_inserter(batch));
+        position = window_end;
+    }
+    consumed = position - cursor.next;
+    return recipes_to_json(batch);
+}
+
+extern "C" {
+
+/**
+ * @brief 打开结果游标。
+ * @param query_json 查询条件 JSON: {"source": "recipes" | "encyclopedia",
+ *        "search": "关键词"}，两项均可省略 (默认为全部用户菜谱)；NULL 或空串
+ *        同样表示全部用户菜谱。用户菜谱按名称片段匹配 (不区分大小写，ID 升序)，
+ *        食谱大全按名称/食材/标签匹配 (文件顺序)。
+ * @return 游标句柄；查询无效或系统未初始化时返回 NULL。
+ *         须使用 close_cursor() 关闭。
+ */
+DLL_EXPORT void *open_recipe_cursor(const char *query_json) {
+    try {
+        json query = json::object();
+        if (query_json && *query_json) {
+            query = json::parse(query_json, nullptr, false);
+            if (!query.is_object()) {
+                std::cerr << "[DLL] open_recipe_cursor: invalid query JSON."
+                          << std::endl;
+                return nullptr;
+            }
+        }
+        std::string source = query.value("source", "recipes");
+        std::string search = query.value("search", "");
+
+        auto cursor = std::make_unique<RecipeCursor>();
+        if (source == "encyclopedia") {
+            EncyclopediaReadLock lock;
+            if (!global_encyclopedia_manager_ptr) {
+                return nullptr;
+            }
+            cursor->encyclopedia = true;
+            cursor->generation = global_system_generation;
+            cursor->encyclopediaVersion = global_encyclopedia_version;
+            if (search.empty()) {
+                cursor->total = global_encyclopedia_manager_ptr->size();
+            } else {
+                cursor->positions =
+                    global_encyclopedia_manager_ptr->findRecipePositions(search);
+                cursor->total = cursor->positions.size();
+            }
+        } else if (source == "recipes") {
+            RecipeDataReadLock lock;
+            if (!global_recipe_manager_ptr) {
+                return nullptr;
+            }
+            cursor->generation = global_system_generation;
+            cursor->recipeIds =
+                search.empty()
+                    ? global_recipe_manager_ptr->getAllRecipeIds()
+                    : global_recipe_manager_ptr->findRecipeIdsByName(search,
+                                                                     true);
+            cursor->total = cursor->recipeIds.size();
+        } else {
+            std::cerr << "[DLL] open_recipe_cursor: unknown source '" << source
+                      << "'." << std::endl;
+            return nullptr;
+        }
+        return cursor.release();
+    } catch (const std::exception &e) {
+        std::cerr << "[DLL] Exception in open_recipe_cursor: " << e.what()
+                  << std::endl;
+        return nullptr;
+    } catch (...) {
+        std::cerr << "[DLL] Unknown exception in open_recipe_cursor."
+                  << std::endl;
+        return nullptr;
+    }
+}
+
+/**
+ * @brief 读取游标的下一批结果并前移游标。
+ * @param cursor open_recipe_cursor() 返回的句柄。
+ * @param n 本批最多返回的菜谱数 (> 0)。
+ * @return char* 指向菜谱 JSON 数组 (空数组表示已读完) 或错误信息的 JSON 字符串。
+ *         调用者必须使用 free_allocated_string() 释放此内存。
+ */
+DLL_EXPORT char *cursor_next_batch(void *cursor, int n) {
+    try {
+        if (!cursor || n <= 0) {
+            return strcpy_to_new_char_buffer(
+                json{{"error", "[DLL] Error: Null cursor or non-positive "
+                               "batch size."}}
+                    .dump());
+        }
+        auto *state = static_cast<RecipeCursor *>(cursor);
+        size_t consumed = 0;
+        json batch = cursor_batch_json(*state, n, consumed);
+        if (batch.is_array()) {
+            state->next += consumed;
+        }
+        return strcpy_to_new_char_buffer(batch.dump());
+    } catch (const std::exception &e) {
+        return strcpy_to_new_char_buffer(
+            json{{"error", "[DLL] Exception in cursor_next_batch: " +
+                               std::string(e.what())}}
+                .dump());
+    } catch (...) {
+        return strcpy_to_new_char_buffer(
+            json{{"error", "[DLL] Unknown exception in cursor_next_batch."}}
+                .dump());
+    }
+}
+
+/**
+ * @brief cursor_next_batch() 的调用方缓冲区变体 (协议见 *_json_into)。
+ *        缓冲区不足时游标不前移，调用方扩大缓冲区后重试即可拿到同一批。
+ */
+DLL_EXPORT std::size_t cursor_next_batch_into(void *cursor, int n, char *buffer,
+                                              std::size_t capacity) {
+    auto *state = static_cast<RecipeCursor *>(cursor);
+    size_t consumed = 0;
+    bool advance = false;
+    std::size_t required = write_json_result(
+        "cursor_next_batch_into", buffer, capacity, [&]() -> json {
+            if (!state || n <= 0) {
+                return {{"error", "[DLL] Error: Null cursor or non-positive "
+                                  "batch size."}};
+            }
+            json batch = cursor_batch_json(*state, n, consumed);
+            advance = batch.is_array();
+            return batch;
+        });
+    if (advance && required <= capacity) {
+        state->next += consumed;
+    }
+    return required;
+}
+
+/**
+ * @brief 关闭游标并释放其内存。cursor 可以为 NULL。
+ */
+DLL_EXPORT void close_cursor(void *cursor) {
+    delete static_cast<RecipeCursor *>(cursor);
+}
+
+}  // extern "C"
+
+// --- 二进制编码变体 ---
+//
+// 每个 *_bin_alloc 函数返回与对应 JSON 函数相同的数据，但以 CBOR
+// (format = 1) 或 MessagePack (format = 2) 编码，宿主无需再解析文本。
+// 返回的缓冲区以 4 字节小端无符号整数表示的负载长度开头，其后为编码数据；
+// 错误同样以编码后的 {"error": ...} 返回。format 无效时返回 NULL。
+// 缓冲区须使用 free_allocated_binary() 释放。
+
+static constexpr int kBinaryFormatCbor = 1;
+static constexpr int kBinaryFormatMsgpack = 2;
+static constexpr std::size_t kBinaryLengthPrefix = 4;
+
+// nlohmann 输出适配器: 编码到 malloc 分配、按需倍增的缓冲区，
+// 完成后直接把所有权交给调用方，不再复制
+class MallocBufferOutputAdapter
+    : public nlohmann::detail::output_adapter_protocol<std::uint8_t> {
+   public:
+    explicit MallocBufferOutputAdapter(std::size_t reserved)
+        : size_(reserved) {
+        grow(std::max<std::size_t>(reserved, 256));
+    }
+
+    ~MallocBufferOutputAdapter() override { std::free(data_); }
+
+    void write_character(std::uint8_t c) override { write_characters(&c, 1); }
+
+    void write_characters(const std::uint8_t *s, std::size_t length) override {
+        if (size_ + length > capacity_) {
+            grow(std::max(capacity_ * 2, size_ + length));
+        }
+        std::memcpy(data_ + size_, s, length);
+        size_ += length;
+    }
+
+    std::uint8_t *data() { return data_; }
+    std::size_t size() const { return size_; }
+
+    std::uint8_t *release() {
+        std::uint8_t *data = data_;
+        data_ = nullptr;
+        return data;
+    }
+
+   private:
+    void grow(std::size_t capacity) {
+        auto *grown = static_cast<std::uint8_t *>(std::realloc(data_, capacity));
+        if (!grown) {
+            throw std::bad_alloc();
+        }
+        data_ = grown;
+        capacity_ = capacity;
+    }
+
+    std::uint8_t *data_ = nullptr;
+    std::size_t capacity_ = 0;
+    std::size_t size_;
+};
+
+// 调用 build() 生成结果，按 format 编码并加上长度前缀
+template <typename Build>
+static unsigned char *encode_binary_result(const char *function_name,
+                                           int format, Build build) {
+    if (format != kBinaryFormatCbor && format != kBinaryFormatMsgpack) {
+        std::cerr << "[DLL] " << function_name << ": unknown binary format "
+                  << format << "." << std::endl;
+        return nullptr;
+    }
+    try {
+        json result = run_query(function_name, build);
+        auto adapter =
+            std::make_shared<MallocBufferOutputAdapter>(kBinaryLengthPrefix);
+        nlohmann::detail::binary_writer<json, std::uint8_t> writer(adapter);
+        if (format == kBinaryFormatCbor) {
+            writer.write_cbor(result);
+        } else {
+            writer.write_msgpack(result);
+        }
+        std::size_t length = adapter->size() - kBinaryLengthPrefix;
+        if (length > UINT32_MAX) {
+            throw std::length_error("encoded result exceeds 4 GiB");
+        }
+        for (std::size_t i = 0; i < kBinaryLengthPrefix; ++i) {
+            adapter->data()[i] = static_cast<std::uint8_t>(length >> (8 * i));
+        }
+        return adapter->release();
+    } catch (const std::exception &e) {
+        std::cerr << "[DLL] Exception while encoding " << function_name
+                  << ": " << e.what() << std::endl;
+        return nullptr;
+    }
+}
+
+extern "C" {
+
+/// get_all_recipes_json_alloc() 的二进制编码变体。
+DLL_EXPORT unsigned char *get_all_recipes_bin_alloc(int format) {
+    return encode_binary_result("get_all_recipes_bin_alloc", format,
+                                [] { return query_all_recipes(); });
+}
+
+/// get_recipe_by_id_json() 的二进制编码变体。
+DLL_EXPORT unsigned char *get_recipe_by_id_bin_alloc(int recipe_id,
+                                                     int format) {
+    return encode_binary_result("get_recipe_by_id_bin_alloc", format,
+                                [&] { return query_recipe_by_id(recipe_id); });
+}
+
+/// search_recipes_by_name_with_matches_json_alloc() 的二进制编码变体。
+DLL_EXPORT unsigned char *search_recipes_by_name_with_matches_bin_alloc(
+    const char *name_query_str, int format) {
+    return encode_binary_result(
+        "search_recipes_by_name_with_matches_bin_alloc", format,
+        [&] { return query_recipe_name_search_with_matches(name_query_str); });
+}
+
+/// get_all_encyclopedia_recipes_json_alloc() 的二进制编码变体。
+DLL_EXPORT unsigned char *get_all_encyclopedia_recipes_bin_alloc(int format) {
+    return encode_binary_result(
+        "get_all_encyclopedia_recipes_bin_alloc", format,
+        [] { return query_all_encyclopedia_recipes(); });
+}
+
+/// search_encyclopedia_recipes_json_alloc() 的二进制编码变体。
+DLL_EXPORT unsigned char *search_encyclopedia_recipes_bin_alloc(
+    const char *search_term_str, int format) {
+    return encode_binary_result(
+        "search_encyclopedia_recipes_bin_alloc", format,
+        [&] { return query_encyclopedia_search(search_term_str); });
+}
+
+/// search_encyclopedia_recipes_with_matches_json_alloc() 的二进制编码变体。
+DLL_EXPORT unsigned char *search_encyclopedia_recipes_with_matches_bin_alloc(
+    const char *search_term_str, int format) {
+    return encode_binary_result(
+        "search_encyclopedia_recipes_with_matches_bin_alloc", format,
+        [&] { return query_encyclopedia_search_with_matches(search_term_str); });
+}
+
+/// get_restaurant_menu_aggregates_json_alloc() 的二进制编码变体。
+DLL_EXPORT unsigned char *get_restaurant_menu_aggregates_bin_alloc(
+    int restaurant_id, int format) {
+    return encode_binary_result(
+        "get_restaurant_menu_aggregates_bin_alloc", format,
+        [&] { return query_menu_aggregates(restaurant_id); });
+}
+
+/// cursor_next_batch() 的二进制编码变体，成功时前移游标。
+DLL_EXPORT unsigned char *cursor_next_batch_bin_alloc(void *cursor, int n,
+                                                      int format) {
+    auto *state = static_cast<RecipeCursor *>(cursor);
+    size_t consumed = 0;
+    bool advance = false;
+    unsigned char *encoded = encode_binary_result(
+        "cursor_next_batch_bin_alloc", format, [&]() -> json {
+            if (!state || n <= 0) {
+                return {{"error", "[DLL] Error: Null cursor or non-positive "
+                                  "batch size."}};
+            }
+            json batch = cursor_batch_json(*state, n, consumed);
+            advance = batch.is_array();
+            return batch;
+        });
+    if (encoded && advance) {
+        state->next += consumed;
+    }
+    return encoded;
+}
+
+/**
+ * @brief 释放 *_bin_alloc 函数返回的缓冲区。buffer 可以为 NULL。
+ */
+DLL_EXPORT void free_allocated_binary(unsigned char *buffer) {
+    std::free(buffer);
+}
+
+}  // extern "C"
@@ -409,6 +409,75 @@ std::vector<int> parseCsvStringToIntVector(const std::string &csv_string) {
     return result;
 }
 
+std::string highlightMatches(
+    const std::string &text,
+    const std::vector<RecipeApp::Logic::Search::MatchSpan> &matches,
+    RecipeApp::Logic::Search::MatchField field, std::size_t fieldIndex) {
+    std::vector<std::pair<std::size_t, std::size_t>> ranges;
+    for (const auto &match : matches) {
+        if (match.field == field && match.fieldIndex == fieldIndex &&
+            match.length > 0 && match.offset < text.size()) {
+            ranges.emplace_back(match.offset,
+                                std::min(match.offset + match.length, text.size()));
+        }
+    }
+    std::sort(ranges.begin(), ranges.end());
+
+    std::string out;
+    std::size_t cursor = 0;
+    for (const auto &range : ranges) {
+        if (range.first < cursor) {
+            continue;  // Overlaps the previous highlight
+        }
+        out.append(text, cursor, range.first - cursor);
+        out += "【";
+        out.append(text, range.first, range.second - range.first);
+        out += "】";
+        cursor = range.second;
+    }
+    out.append(text, cursor, std::string::npos);
+    return out;
+}
+
+void displayRecipeSearchHitBrief(
+    const RecipeApp::Logic::Search::RecipeSearchHit &hit) {
+    using RecipeApp::Logic::Search::MatchField;
+    displayRecipeDetailsBrief(hit.recipe);
+    if (hit.matches.empty()) {
+        return;
+    }
+
+    // Each matched field once, in the order the matches were reported
+    std::vector<std::pair<MatchField, std::size_t>> shown;
+    std::cout << "    匹配:";
+    for (const auto &match : hit.matches) {
+        std::pair<MatchField, std::size_t> key{match.field, match.fieldIndex};
+        if (std::find(shown.begin(), shown.end(), key) != shown.end()) {
+            continue;
+        }
+        shown.push_back(key);
+        const auto &recipe = hit.recipe;
+        if (match.field == MatchField::Name) {
+            std::cout << " 名称 "
+                      << highlightMatches(recipe.getName(), hit.matches,
+                                          match.field);
+        } else if (match.field == MatchField::Ingredient &&
+                   match.fieldIndex < recipe.getIngredients().size()) {
+            std::cout << " 食材 "
+                      << highlightMatches(
+                             recipe.getIngredients()[match.fieldIndex].name,
+                             hit.matches, match.field, match.fieldIndex);
+        } else if (match.field == MatchField::Tag &&
+                   match.fieldIndex < recipe.getTags().size()) {
+            std::cout << " 标签 "
+                      << highlightMatches(recipe.getTags()[match.fieldIndex],
+                                          hit.matches, match.field,
+                                          match.fieldIndex);
+        }
+    }
+    std::cout << std::endl;
+}
+
 std::string difficultyToString(RecipeApp::Difficulty difficulty) {
     switch (difficulty) {
         case RecipeApp::Difficulty::Easy:
@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "domain/recipe/Recipe.h"  // For RecipeApp::Difficulty
+#include "logic/search/SearchMatch.h"
 // #include "domain/user/User.h"     // User domain object removed
 
 namespace RecipeApp {
@@ -57,6 +58,16 @@ void displayRecipeDetailsBrief(const RecipeApp::Recipe &recipe);
 // 完整显示菜谱详情
 void displayRecipeDetailsFull(const RecipeApp::Recipe &recipe);
 
+// 用【】标出文本中的匹配片段 (只使用属于给定字段的匹配，偏移为 UTF-8 字节偏移)
+std::string highlightMatches(
+    const std::string &text,
+    const std::vector<RecipeApp::Logic::Search::MatchSpan> &matches,
+    RecipeApp::Logic::Search::MatchField field, std::size_t fieldIndex = 0);
+
+// 简要显示搜索结果，并在其下列出高亮后的命中字段 (名称、食材、标签)
+void displayRecipeSearchHitBrief(
+    const RecipeApp::Logic::Search::RecipeSearchHit &hit);
+
 // 将 RecipeApp::Difficulty 枚举转换为字符串
 std::string difficultyToString(RecipeApp::Difficulty difficulty);
 
@@ -4,11 +4,22 @@
 #include "domain/recipe/Recipe.h"
 #include "../../common/exceptions/ValidationException.h" // For ValidationException
 #include "spdlog/spdlog.h" // For logging
+#include <algorithm>
+#include <cctype>
 #include <iostream>
 #include <vector>
 #include <string>
 #include <sstream>
 
+namespace
+{
+    std::string toLowerAscii(std::string value)
+    {
+        std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) { return std::tolower(c); });
+        return value;
+    }
+} // namespace
+
 namespace RecipeApp
 {
     namespace CliHandlers
@@ -16,6 +27,10 @@ namespace RecipeApp
         RecipeEncyclopediaCommandHandler::RecipeEncyclopediaCommandHandler(RecipeApp::Logic::Encyclopedia::RecipeEncyclopediaManager &manager)
             : encyclopediaManager(manager) {}
 
+        RecipeEncyclopediaCommandHandler::RecipeEncyclopediaCommandHandler(RecipeApp::Logic::Encyclopedia::RecipeEncyclopediaManager &manager,
+                                                                           RecipeApp::RecipeManager &userRecipeManager)
+            : encyclopediaManager(manager), recipeManager(&userRecipeManager) {}
+
         int RecipeEncyclopediaCommandHandler::handleSearchEncyclopediaRecipes(const cxxopts::ParseResult &result)
         {
             if (!result.count("enc-search")) {
@@ -40,20 +55,18 @@ namespace RecipeApp
             }
             
             spdlog::debug("在食谱大全中搜索关键词: '{}'", keywords);
-            std::vector<RecipeApp::Recipe> recipes = encyclopediaManager.searchRecipes(keywords);
+            std::vector<RecipeApp::Logic::Search::RecipeSearchHit> hits = encyclopediaManager.searchRecipesWithMatches(keywords);
 
-            if (recipes.empty())
+            if (hits.empty())
             {
                 std::cout << "未找到与关键词匹配的食谱: '" << keywords << "'." << std::endl;
             }
             else
             {
-                std::cout << "找到 " << recipes.size() << " 个与关键词匹配的食谱 '" << keywords << "':" << std::endl;
-                for (const auto &recipe : recipes)
+                std::cout << "找到 " << hits.size() << " 个与关键词匹配的食谱 '" << keywords << "':" << std::endl;
+                for (const auto &hit : hits)
                 {
-                    std::cout << "  ID: " << recipe.getRecipeId() << ", 名称: " << recipe.getName() << std::endl;
-                    // TODO: Implement a more detailed summary if needed, e.g., using a CliUtils function
-                    // RecipeApp::CliUtils::displayRecipeDetailsBrief(recipe);
+                    RecipeApp::CliUtils::displayRecipeSearchHitBrief(hit);
                 }
             }
             return RecipeApp::Cli::EX_OK;
@@ -141,5 +154,52 @@ namespace RecipeApp
             }
             return RecipeApp::Cli::EX_OK;
         }
+
+        int RecipeEncyclopediaCommandHandler::handleImportEncyclopediaRecipes(const cxxopts::ParseResult &result)
+        {
+            if (!recipeManager) {
+                spdlog::error("处理食谱大全导入错误：未配置菜谱管理器。");
+                throw Common::Exceptions::ValidationException("当前无法导入食谱大全菜谱。");
+            }
+
+            std::string keywords = result.count("enc-import") ? result["enc-import"].as<std::string>() : "";
+            std::string tag = result.count("enc-import-tag") ? result["enc-import-tag"].as<std::string>() : "";
+
+            // No keywords means the whole encyclopedia (narrowed by --enc-import-tag if given)
+            std::vector<RecipeApp::Recipe> candidates = keywords.empty() ? encyclopediaManager.getAllRecipes()
+                                                                         : encyclopediaManager.searchRecipes(keywords);
+            if (!tag.empty()) {
+                std::string wantedTag = toLowerAscii(tag);
+                candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+                                                [&](const RecipeApp::Recipe &recipe) {
+                                                    const auto &tags = recipe.getTags();
+                                                    return std::none_of(tags.begin(), tags.end(), [&](const std::string &t) {
+                                                        return toLowerAscii(t) == wantedTag;
+                                                    });
+                                                }),
+                                 candidates.end());
+            }
+
+            if (candidates.empty()) {
+                std::cout << "食谱大全中没有符合条件的菜谱可导入。" << std::endl;
+                return RecipeApp::Cli::EX_OK;
+            }
+
+            spdlog::debug("从食谱大全导入 {} 个候选菜谱 (关键词: '{}', 标签: '{}')", candidates.size(), keywords, tag);
+            RecipeApp::RecipeImportResult importResult = recipeManager->importRecipes(candidates);
+
+            std::cout << "已从食谱大全导入 " << importResult.importedIds.size() << " 个菜谱";
+            if (!importResult.importedIds.empty()) {
+                std::cout << " (ID " << importResult.importedIds.front() << " - " << importResult.importedIds.back() << ")";
+            }
+            std::cout << "。" << std::endl;
+            if (!importResult.skippedNames.empty()) {
+                std::cout << "跳过 " << importResult.skippedNames.size() << " 个名称已存在的菜谱:" << std::endl;
+                for (const auto &name : importResult.skippedNames) {
+                    std::cout << "  - " << name << std::endl;
+                }
+            }
+            return RecipeApp::Cli::EX_OK;
+        }
     } // namespace CliHandlers
 } // namespace RecipeApp
\ No newline at end of file
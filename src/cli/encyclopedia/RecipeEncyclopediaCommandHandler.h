@@ -3,6 +3,7 @@
 
 #include "cxxopts.hpp"
 #include "logic/encyclopedia/RecipeEncyclopediaManager.h" // Adjusted path
+#include "logic/recipe/RecipeManager.h"
 
 namespace RecipeApp
 {
@@ -13,6 +14,10 @@ namespace RecipeApp
         public:
             explicit RecipeEncyclopediaCommandHandler(RecipeApp::Logic::Encyclopedia::RecipeEncyclopediaManager &encyclopediaManager);
 
+            // With a RecipeManager the handler can also import encyclopedia entries into the user's recipes
+            RecipeEncyclopediaCommandHandler(RecipeApp::Logic::Encyclopedia::RecipeEncyclopediaManager &encyclopediaManager,
+                                             RecipeApp::RecipeManager &recipeManager);
+
             // Handles searching recipes in the encyclopedia
             // Expected command: recipe-cli encyclopedia search --keywords "keyword1 keyword2"
             int handleSearchEncyclopediaRecipes(const cxxopts::ParseResult &result);
@@ -21,8 +26,13 @@ namespace RecipeApp
             // Expected command: recipe-cli encyclopedia view --id <recipe_id>
             int handleViewEncyclopediaRecipe(const cxxopts::ParseResult &result);
 
+            // Handles bulk-importing encyclopedia recipes into the user's recipes, optionally filtered
+            // Expected command: recipe-cli --enc-import [keywords] [--enc-import-tag <tag>]
+            int handleImportEncyclopediaRecipes(const cxxopts::ParseResult &result);
+
         private:
             RecipeApp::Logic::Encyclopedia::RecipeEncyclopediaManager &encyclopediaManager;
+            RecipeApp::RecipeManager *recipeManager = nullptr;
         };
     } // namespace CliHandlers
 } // namespace RecipeApp
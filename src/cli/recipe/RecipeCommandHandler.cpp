@@ -4,7 +4,9 @@
 
 #include <iostream> // For std::cout, std::cerr (will be phased out for logging where appropriate)
 #include <limits>     // Required for std::numeric_limits
+#include <map>
 #include <stdexcept>  // Required for std::exception
+#include <set>
 #include <string>
 #include <vector>
 
@@ -161,6 +163,8 @@ int RecipeCommandHandler::handleViewRecipe(const cxxopts::ParseResult &result) {
 int RecipeCommandHandler::handleSearchRecipes(
     const cxxopts::ParseResult &result) {
     std::vector<RecipeApp::Recipe> recipesToDisplay;
+    // Name-match spans per recipe ID, for highlighting in the result list
+    std::map<int, std::vector<RecipeApp::Logic::Search::MatchSpan>> nameMatches;
     std::string searchCriteriaDisplay;
     bool nameQueryProvided = false;
     bool tagQueryProvided = false;
@@ -170,7 +174,10 @@ int RecipeCommandHandler::handleSearchRecipes(
         !result["recipe-search"].as<std::string>().empty()) {
         std::string nameQuery = result["recipe-search"].as<std::string>();
         // Use the updated RecipeManager method that utilizes indexes
-        recipesToDisplay = recipeManager.findRecipeByName(nameQuery, true);
+        for (auto &hit : recipeManager.findRecipeByNameWithMatches(nameQuery, true)) {
+            nameMatches[hit.recipe.getRecipeId()] = std::move(hit.matches);
+            recipesToDisplay.push_back(std::move(hit.recipe));
+        }
         searchCriteriaDisplay = "名称包含: \"" + nameQuery + "\"";
         nameQueryProvided = true;
     }
@@ -249,8 +256,72 @@ int RecipeCommandHandler::handleSearchRecipes(
         // Neither name nor tag query provided.
     }
 
+    // 3. Filter by step text (--steps), phrase match over the step index
+    bool stepsQueryProvided = false;
+    if (result.count("steps") && !result["steps"].as<std::string>().empty()) {
+        std::string stepsQuery = result["steps"].as<std::string>();
+        stepsQueryProvided = true;
+        std::string stepsCriteriaDisplayPart =
+            "步骤包含: \"" + stepsQuery + "\"";
+        if (!nameQueryProvided && !tagQueryProvided) {
+            searchCriteriaDisplay = stepsCriteriaDisplayPart;
+            recipesToDisplay = recipeManager.findRecipesByStepText(stepsQuery);
+        } else {
+            searchCriteriaDisplay += " 并且 " + stepsCriteriaDisplayPart;
+            std::vector<int> step_ids =
+                recipeManager.findRecipeIdsByStepText(stepsQuery);
+            std::set<int> step_matched(step_ids.begin(), step_ids.end());
+            recipesToDisplay.erase(
+                std::remove_if(recipesToDisplay.begin(), recipesToDisplay.end(),
+                               [&step_matched](const RecipeApp::Recipe &r) {
+                                   return step_matched.count(
+                                              r.getRecipeId()) == 0;
+                               }),
+                recipesToDisplay.end());
+        }
+    }
+
+    // 4. Exclude recipes containing ingredients of the given categories
+    // (allergens, dislikes). Works on its own or on top of name/tag results.
+    bool excludeQueryProvided = false;
+    if (result.count("exclude")) {
+        std::string csv_categories = result["exclude"].as<std::string>();
+        std::vector<std::string> excludedCategories =
+            RecipeApp::CliUtils::parseCsvStringToVector(csv_categories);
+        if (!excludedCategories.empty()) {
+            excludeQueryProvided = true;
+            std::string excludeCriteriaDisplayPart =
+                "排除类别: \"" + csv_categories + "\"";
+            // Throws ValidationException for unknown categories
+            if (!nameQueryProvided && !tagQueryProvided &&
+                !stepsQueryProvided) {
+                searchCriteriaDisplay = excludeCriteriaDisplayPart;
+                recipesToDisplay = recipeManager.findRecipesExcludingCategories(
+                    excludedCategories);
+            } else {
+                searchCriteriaDisplay += " 并且 " + excludeCriteriaDisplayPart;
+                std::vector<int> candidate_ids;
+                candidate_ids.reserve(recipesToDisplay.size());
+                for (const auto &r : recipesToDisplay)
+                    candidate_ids.push_back(r.getRecipeId());
+                std::vector<int> kept_ids =
+                    recipeManager.filterRecipeIdsExcludingCategories(
+                        candidate_ids, excludedCategories);
+                std::set<int> kept(kept_ids.begin(), kept_ids.end());
+                recipesToDisplay.erase(
+                    std::remove_if(recipesToDisplay.begin(),
+                                   recipesToDisplay.end(),
+                                   [&kept](const RecipeApp::Recipe &r) {
+                                       return kept.count(r.getRecipeId()) == 0;
+                                   }),
+                    recipesToDisplay.end());
+            }
+        }
+    }
+
     // Check if any search criteria was actually provided
-    if (!nameQueryProvided && !tagQueryProvided) {
+    if (!nameQueryProvided && !tagQueryProvided && !stepsQueryProvided &&
+        !excludeQueryProvided) {
         // This means --recipe-search was called without a query, and no --tag
         // or --tags. Or just --recipe-search with an empty string. The main.cpp
         // option definition should ideally prevent --recipe-search without any
@@ -260,7 +331,7 @@ int RecipeCommandHandler::handleSearchRecipes(
         if (result.count("recipe-search")) {
             spdlog::error("请为搜索提供查询词或标签。");
             throw Common::Exceptions::ValidationException(
-                "请为搜索提供查询词或标签。用法: --recipe-search [查询词] [--tag <标签>] [--tags <标签1,标签2>]");
+                "请为搜索提供查询词或标签。用法: --recipe-search [查询词] [--tag <标签>] [--tags <标签1,标签2>] [--steps <步骤文本>] [--exclude <类别1,类别2>]");
         }
         // If not even --recipe-search command, this handler shouldn't be
         // called. But if it is, and no criteria, it's an issue. For safety, if
@@ -276,10 +347,45 @@ int RecipeCommandHandler::handleSearchRecipes(
         std::cout << "未找到匹配的菜谱。" << std::endl;
     } else {
         for (const auto &recipe : recipesToDisplay) {
-            RecipeApp::CliUtils::displayRecipeDetailsBrief(recipe);
+            auto matchesIt = nameMatches.find(recipe.getRecipeId());
+            if (matchesIt != nameMatches.end()) {
+                RecipeApp::CliUtils::displayRecipeSearchHitBrief(
+                    {recipe, matchesIt->second});
+            } else {
+                RecipeApp::CliUtils::displayRecipeDetailsBrief(recipe);
+            }
         }
         std::cout << "找到 " << recipesToDisplay.size() << " 个匹配的菜谱。"
                   << std::endl;
+
+        if (result.count("facets")) {
+            std::vector<int> result_ids;
+            result_ids.reserve(recipesToDisplay.size());
+            for (const auto &r : recipesToDisplay)
+                result_ids.push_back(r.getRecipeId());
+            RecipeApp::RecipeFacets facets =
+                recipeManager.computeFacets(result_ids);
+
+            std::cout << "--- 分面统计 ---" << std::endl;
+            std::cout << "标签:";
+            for (const auto &tagCount : facets.tagCounts) {
+                std::cout << " " << tagCount.first << " (" << tagCount.second
+                          << ")";
+            }
+            std::cout << std::endl << "难度:";
+            for (const auto &diffCount : facets.difficultyCounts) {
+                std::cout << " "
+                          << RecipeApp::CliUtils::difficultyToString(
+                                 diffCount.first)
+                          << " (" << diffCount.second << ")";
+            }
+            std::cout << std::endl << "烹饪时长:";
+            for (const auto &timeCount : facets.cookingTimeCounts) {
+                std::cout << " " << timeCount.first << " (" << timeCount.second
+                          << ")";
+            }
+            std::cout << std::endl;
+        }
     }
     return RecipeApp::Cli::EX_OK;
 }
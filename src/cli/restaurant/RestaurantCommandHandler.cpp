@@ -103,12 +103,21 @@ namespace RecipeApp
                 if (restaurants.empty()) {
                     std::cout << "当前没有已保存的餐馆。" << std::endl;
                 } else {
+                    // Featured recipes for the whole listing in one lookup
+                    auto featuredByRestaurant = restaurantManager_.getFeaturedRecipesForRestaurants(restaurants, recipeManager_);
                     for (const auto& r : restaurants) {
                         std::cout << "ID: " << r.getId() 
                                   << ", 名称: " << r.getName()
                                   << ", 地址: " << r.getAddress()
-                                  << ", 联系方式: " << r.getContact()
-                                  << std::endl;
+                                  << ", 联系方式: " << r.getContact();
+                        const auto& featured = featuredByRestaurant[r.getId()];
+                        if (!featured.empty()) {
+                            std::cout << ", 特色菜谱: ";
+                            for (std::size_t i = 0; i < featured.size(); ++i) {
+                                std::cout << (i ? "、" : "") << featured[i].getName();
+                            }
+                        }
+                        std::cout << std::endl;
                     }
                     std::cout << "共 " << restaurants.size() << " 个餐馆。" << std::endl;
                 }
@@ -591,5 +600,33 @@ namespace RecipeApp
                 return RecipeApp::Cli::EX_SOFTWARE;
             }
         }
+
+        int RestaurantCommandHandler::handleVerifyRecipeReferences(const cxxopts::ParseResult& result) {
+            bool repair = result.count("restaurant-repair-refs") > 0;
+            spdlog::debug("处理餐馆菜谱引用检查命令 (修复: {})。", repair);
+            try {
+                RecipeApp::RestaurantIntegrityReport report = restaurantManager_.verifyRecipeReferences(recipeManager_, repair);
+                std::cout << "已检查 " << report.restaurantsChecked << " 个餐馆。" << std::endl;
+                if (report.danglingReferences.empty()) {
+                    std::cout << "未发现引用已删除菜谱的餐馆。" << std::endl;
+                    return RecipeApp::Cli::EX_OK;
+                }
+                for (const auto& [restaurantId, recipeId] : report.danglingReferences) {
+                    std::cout << "  餐馆 ID " << restaurantId << " 引用了不存在的菜谱 ID " << recipeId << std::endl;
+                }
+                std::cout << "共发现 " << report.danglingReferences.size() << " 个无效引用。" << std::endl;
+                if (repair) {
+                    spdlog::info("已修复 {} 个餐馆的特色菜谱列表。", report.restaurantsRepaired);
+                    std::cout << "已从 " << report.restaurantsRepaired << " 个餐馆中移除无效引用。" << std::endl;
+                    return RecipeApp::Cli::EX_OK;
+                }
+                std::cout << "使用 --restaurant-repair-refs 移除这些引用。" << std::endl;
+                return RecipeApp::Cli::EX_DATAERR;
+            } catch (const RecipeApp::Common::Exceptions::PersistenceException& pe) {
+                spdlog::error("修复餐馆菜谱引用时发生持久化错误: {}", pe.what());
+                std::cout << "错误: 保存修复结果失败 - " << pe.what() << std::endl;
+                return RecipeApp::Cli::EX_IOERR;
+            }
+        }
     } // namespace CliHandlers
 } // namespace RecipeApp
\ No newline at end of file
@@ -24,6 +24,7 @@ namespace RecipeApp
             int handleManageRestaurantMenu(const cxxopts::ParseResult& result); // New method for F1.1.4
             int handleSearchRestaurantsByName(const cxxopts::ParseResult& result); // New method for F1.1.5 (by name)
             int handleSearchRestaurantsByCuisine(const cxxopts::ParseResult& result); // New method for F1.1.5 (by cuisine)
+            int handleVerifyRecipeReferences(const cxxopts::ParseResult& result); // 检查 (并可修复) 餐馆引用的已删除菜谱
 
         private:
             RecipeApp::RestaurantManager &restaurantManager_; // Renamed for clarity
@@ -0,0 +1,78 @@
+#include "FederatedSearchCommandHandler.h"
+#include "cli/ExitCodes.h"
+#include "../../common/exceptions/ValidationException.h" // For ValidationException
+#include "spdlog/spdlog.h" // For logging
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace RecipeApp
+{
+    namespace CliHandlers
+    {
+        using RecipeApp::Logic::Search::FederatedSearchHit;
+        using RecipeApp::Logic::Search::RecipeSource;
+
+        namespace
+        {
+            const char *sourceLabel(RecipeSource source)
+            {
+                return source == RecipeSource::UserCatalogue ? "我的菜谱" : "食谱大全";
+            }
+        } // namespace
+
+        FederatedSearchCommandHandler::FederatedSearchCommandHandler(const RecipeApp::Logic::Search::FederatedSearchService &service)
+            : searchService(service) {}
+
+        int FederatedSearchCommandHandler::handleFederatedSearch(const cxxopts::ParseResult &result)
+        {
+            std::string keywords;
+            int topK = 10;
+            try {
+                keywords = result["search"].as<std::string>();
+                topK = result["top"].as<int>();
+            } catch (const cxxopts::exceptions::exception& e) {
+                spdlog::error("处理联合搜索错误：无法解析 --search/--top 的值。原始错误: {}", e.what());
+                throw Common::Exceptions::ValidationException(std::string("无法解析联合搜索参数: ") + e.what());
+            }
+
+            if (keywords.empty()) {
+                spdlog::error("处理联合搜索错误：--search 的关键词不能为空。");
+                throw Common::Exceptions::ValidationException("联合搜索的关键词不能为空。");
+            }
+            if (topK <= 0) {
+                throw Common::Exceptions::ValidationException("--top 必须为正整数。");
+            }
+
+            spdlog::debug("联合搜索关键词: '{}' (前 {} 条)", keywords, topK);
+            // Partial results are reported as each source finishes; the final
+            // ranking is printed once both are in.
+            std::vector<FederatedSearchHit> hits = searchService.search(
+                keywords, static_cast<std::size_t>(topK),
+                [](const std::vector<FederatedSearchHit> &current, RecipeSource arrived) {
+                    std::cout << "[" << sourceLabel(arrived) << "] 结果已到达，当前前 "
+                              << current.size() << " 条";
+                    if (!current.empty()) {
+                        std::cout << "，最佳: " << current.front().recipe.getName();
+                    }
+                    std::cout << std::endl;
+                });
+
+            if (hits.empty())
+            {
+                std::cout << "未在我的菜谱或食谱大全中找到与 '" << keywords << "' 匹配的菜谱。" << std::endl;
+                return RecipeApp::Cli::EX_OK;
+            }
+
+            std::cout << "--- 联合搜索结果: '" << keywords << "' (前 " << hits.size() << " 条) ---" << std::endl;
+            int rank = 1;
+            for (const auto &hit : hits)
+            {
+                std::cout << "  " << rank++ << ". [" << sourceLabel(hit.source) << "] ID: "
+                          << hit.recipe.getRecipeId() << ", 名称: " << hit.recipe.getName()
+                          << ", 得分: " << hit.score << std::endl;
+            }
+            return RecipeApp::Cli::EX_OK;
+        }
+    } // namespace CliHandlers
+} // namespace RecipeApp
@@ -0,0 +1,26 @@
+#ifndef FEDERATED_SEARCH_COMMAND_HANDLER_H
+#define FEDERATED_SEARCH_COMMAND_HANDLER_H
+
+#include "cxxopts.hpp"
+#include "logic/search/FederatedSearchService.h"
+
+namespace RecipeApp
+{
+    namespace CliHandlers
+    {
+        class FederatedSearchCommandHandler
+        {
+        public:
+            explicit FederatedSearchCommandHandler(const RecipeApp::Logic::Search::FederatedSearchService &searchService);
+
+            // Searches the user's recipes and the encyclopedia together
+            // Expected command: recipe-cli --search "keyword" [--top 10]
+            int handleFederatedSearch(const cxxopts::ParseResult &result);
+
+        private:
+            const RecipeApp::Logic::Search::FederatedSearchService &searchService;
+        };
+    } // namespace CliHandlers
+} // namespace RecipeApp
+
+#endif // FEDERATED_SEARCH_COMMAND_HANDLER_H
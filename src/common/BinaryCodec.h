@@ -0,0 +1,156 @@
+#ifndef BINARY_CODEC_H
+#define BINARY_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace RecipeApp {
+namespace Common {
+
+/**
+ * @brief Appends fixed-width little-endian integers and length-prefixed
+ *        strings to a byte buffer. Used for the prebuilt binary data files.
+ */
+class ByteWriter {
+   public:
+    explicit ByteWriter(std::string& out) : m_out(out) {}
+
+    void writeU8(std::uint8_t value) { m_out.push_back(static_cast<char>(value)); }
+
+    void writeU32(std::uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            m_out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+        }
+    }
+
+    void writeU64(std::uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            m_out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+        }
+    }
+
+    void writeI32(std::int32_t value) { writeU32(static_cast<std::uint32_t>(value)); }
+
+    void writeString(std::string_view value) {
+        writeU32(static_cast<std::uint32_t>(value.size()));
+        m_out.append(value.data(), value.size());
+    }
+
+    void writeBytes(std::string_view bytes) { m_out.append(bytes.data(), bytes.size()); }
+
+    std::size_t position() const { return m_out.size(); }
+
+   private:
+    std::string& m_out;
+};
+
+/**
+ * @brief Writes a (u32 offset, u32 length) reference to a string kept in a
+ *        shared string pool, in place of the string bytes.
+ */
+using StringRefWriter = std::function<void(ByteWriter&, std::string_view)>;
+
+/**
+ * @brief Reads a little-endian integer at a known-valid address, for data
+ *        that is queried in place rather than decoded with a ByteReader.
+ */
+inline std::uint32_t loadU32(const char* bytes) {
+    std::uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+        value |= static_cast<std::uint32_t>(static_cast<unsigned char>(bytes[i]))
+                 << (8 * i);
+    }
+    return value;
+}
+
+inline std::uint64_t loadU64(const char* bytes) {
+    return loadU32(bytes) | static_cast<std::uint64_t>(loadU32(bytes + 4)) << 32;
+}
+
+inline std::int32_t loadI32(const char* bytes) {
+    return static_cast<std::int32_t>(loadU32(bytes));
+}
+
+/**
+ * @brief Bounds-checked reader for data produced by ByteWriter. A read past
+ *        the end sets the failure flag and yields zero / empty values, so
+ *        callers can decode a whole structure and check ok() once.
+ */
+class ByteReader {
+   public:
+    explicit ByteReader(std::string_view data) : m_data(data) {}
+
+    std::uint8_t readU8() {
+        if (!require(1)) {
+            return 0;
+        }
+        return static_cast<std::uint8_t>(m_data[m_pos++]);
+    }
+
+    std::uint32_t readU32() {
+        if (!require(4)) {
+            return 0;
+        }
+        std::uint32_t value = 0;
+        for (int i = 0; i < 4; ++i) {
+            value |= static_cast<std::uint32_t>(
+                         static_cast<unsigned char>(m_data[m_pos + i]))
+                     << (8 * i);
+        }
+        m_pos += 4;
+        return value;
+    }
+
+    std::uint64_t readU64() {
+        if (!require(8)) {
+            return 0;
+        }
+        std::uint64_t value = 0;
+        for (int i = 0; i < 8; ++i) {
+            value |= static_cast<std::uint64_t>(
+                         static_cast<unsigned char>(m_data[m_pos + i]))
+                     << (8 * i);
+        }
+        m_pos += 8;
+        return value;
+    }
+
+    std::int32_t readI32() { return static_cast<std::int32_t>(readU32()); }
+
+    std::string_view readStringView() {
+        std::uint32_t length = readU32();
+        if (!require(length)) {
+            return {};
+        }
+        std::string_view value = m_data.substr(m_pos, length);
+        m_pos += length;
+        return value;
+    }
+
+    std::string readString() { return std::string(readStringView()); }
+
+    bool ok() const { return m_ok; }
+    std::size_t position() const { return m_pos; }
+    std::size_t remaining() const { return m_data.size() - m_pos; }
+
+   private:
+    std::string_view m_data;
+    std::size_t m_pos = 0;
+    bool m_ok = true;
+
+    bool require(std::size_t bytes) {
+        if (!m_ok || bytes > m_data.size() - m_pos) {
+            m_ok = false;
+            return false;
+        }
+        return true;
+    }
+};
+
+}  // namespace Common
+}  // namespace RecipeApp
+
+#endif  // BINARY_CODEC_H
@@ -34,6 +34,35 @@ class RecipeRepository {
     virtual std::vector<RecipeApp::Recipe> findByTags(
         const std::vector<std::string> &tagNames, bool matchAll) const = 0;
 
+    /**
+     * @brief Adds a batch of new recipes (input IDs are ignored) and persists
+     * them in one write.
+     * @param recipes Recipes to add.
+     * @return The stored recipes with their assigned IDs, in input order, or
+     * an empty vector if persisting failed (nothing is kept in that case).
+     *
+     * The default implementation falls back to one save() per recipe;
+     * repositories with a whole-file write should override it.
+     */
+    virtual std::vector<RecipeApp::Recipe> saveMany(
+        const std::vector<RecipeApp::Recipe> &recipes) {
+        std::vector<RecipeApp::Recipe> saved;
+        saved.reserve(recipes.size());
+        for (const auto &recipe : recipes) {
+            int id = save(recipe);
+            std::optional<RecipeApp::Recipe> stored =
+                id > 0 ? findById(id) : std::nullopt;
+            if (!stored) {
+                for (const auto &added : saved) {
+                    remove(added.getRecipeId());
+                }
+                return {};
+            }
+            saved.push_back(std::move(*stored));
+        }
+        return saved;
+    }
+
     /**
      * @brief Sets the next available ID for a new recipe (for persistence
      * loading).
@@ -0,0 +1,45 @@
+#ifndef GEO_POINT_H
+#define GEO_POINT_H
+
+#include <algorithm>
+#include <cmath>
+
+namespace RecipeApp {
+
+/**
+ * @brief A WGS84 latitude/longitude pair in degrees.
+ */
+struct GeoPoint {
+    static constexpr double kEarthRadiusMeters = 6371008.8;  // Mean radius
+    static constexpr double kPi = 3.14159265358979323846;
+
+    double latitude = 0.0;   ///< -90 .. 90
+    double longitude = 0.0;  ///< -180 .. 180
+
+    bool isValid() const {
+        return std::isfinite(latitude) && std::isfinite(longitude) &&
+               latitude >= -90.0 && latitude <= 90.0 && longitude >= -180.0 &&
+               longitude <= 180.0;
+    }
+
+    static double toRadians(double degrees) { return degrees * kPi / 180.0; }
+
+    /// Great-circle (haversine) distance in metres.
+    static double distanceMeters(const GeoPoint &a, const GeoPoint &b) {
+        double dLat = toRadians(b.latitude - a.latitude);
+        double dLon = toRadians(b.longitude - a.longitude);
+        double h = std::sin(dLat / 2) * std::sin(dLat / 2) +
+                   std::cos(toRadians(a.latitude)) *
+                       std::cos(toRadians(b.latitude)) * std::sin(dLon / 2) *
+                       std::sin(dLon / 2);
+        return 2 * kEarthRadiusMeters * std::asin(std::sqrt(std::min(1.0, h)));
+    }
+
+    bool operator==(const GeoPoint &other) const {
+        return latitude == other.latitude && longitude == other.longitude;
+    }
+};
+
+}  // namespace RecipeApp
+
+#endif  // GEO_POINT_H
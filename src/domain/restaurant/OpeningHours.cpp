@@ -0,0 +1,379 @@
+#include "OpeningHours.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+namespace RecipeApp {
+
+namespace {
+using DayMask = unsigned;  // Bit 0 = Monday .. bit 6 = Sunday
+constexpr DayMask kAllDays = 0x7F;
+constexpr DayMask kWeekdays = 0x1F;
+constexpr DayMask kWeekend = 0x60;
+
+constexpr std::array<std::string_view, 7> kEnglishDays = {
+    "monday", "tuesday", "wednesday", "thursday", "friday", "saturday", "sunday"};
+// Suffixes after 周/星期/礼拜; 日 and 天 both mean Sunday
+constexpr std::array<std::pair<std::string_view, int>, 8> kChineseDays = {{
+    {"一", 0}, {"二", 1}, {"三", 2}, {"四", 3}, {"五", 4}, {"六", 5}, {"日", 6}, {"天", 6}}};
+
+constexpr std::array<std::string_view, 8> kRangeSeparators = {
+    "-", "~", "至", "到", "－", "～", "–", "—"};
+constexpr std::array<std::string_view, 8> kClauseSeparators = {
+    ";", "；", ",", "，", "、", "\n", "|", "｜"};
+// Between listed days ("周六/周日") or time ranges ("11:30-14:00/17:00-21:30")
+constexpr std::array<std::string_view, 5> kListSeparators = {"/", "／", "&", "和", "及"};
+constexpr std::array<std::string_view, 4> kAllDayWords = {"24小时", "24/7", "24h", "全天"};
+constexpr std::array<std::string_view, 5> kClosedWords = {"不营业", "休息", "关门", "closed", "off"};
+constexpr std::array<std::string_view, 5> kFillerWords = {"营业时间", "营业", "开放", "hours", "open"};
+
+DayMask dayBit(int day) { return 1u << day; }
+
+// Days from..to inclusive, wrapping past Sunday (e.g. Fri-Mon).
+DayMask dayRange(int from, int to) {
+    DayMask mask = 0;
+    for (int day = from;; day = (day + 1) % 7) {
+        mask |= dayBit(day);
+        if (day == to) {
+            return mask;
+        }
+    }
+}
+
+bool isAsciiAlpha(char c) { return std::isalpha(static_cast<unsigned char>(c)) != 0; }
+
+class Lexer {
+   public:
+    explicit Lexer(std::string_view text) : m_text(text) {}
+
+    std::size_t position() const { return m_pos; }
+    void rewind(std::size_t pos) { m_pos = pos; }
+
+    bool atEnd() {
+        skipSpaces();
+        return m_pos >= m_text.size();
+    }
+
+    // Case-insensitive for ASCII. An alphabetic word only matches whole.
+    bool consume(std::string_view word) {
+        skipSpaces();
+        if (m_text.size() - m_pos < word.size()) {
+            return false;
+        }
+        for (std::size_t i = 0; i < word.size(); ++i) {
+            if (std::tolower(static_cast<unsigned char>(m_text[m_pos + i])) !=
+                static_cast<unsigned char>(word[i])) {
+                return false;
+            }
+        }
+        std::size_t end = m_pos + word.size();
+        if (isAsciiAlpha(word.back()) && end < m_text.size() && isAsciiAlpha(m_text[end])) {
+            return false;
+        }
+        m_pos = end;
+        return true;
+    }
+
+    template <std::size_t N>
+    bool consumeAny(const std::array<std::string_view, N> &words) {
+        for (std::string_view word : words) {
+            if (consume(word)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::string readAsciiWord() {
+        skipSpaces();
+        std::string word;
+        while (m_pos < m_text.size() && isAsciiAlpha(m_text[m_pos])) {
+            word += static_cast<char>(std::tolower(static_cast<unsigned char>(m_text[m_pos])));
+            ++m_pos;
+        }
+        return word;
+    }
+
+    std::optional<int> readNumber(std::size_t maxDigits) {
+        skipSpaces();
+        int value = 0;
+        std::size_t digits = 0;
+        while (m_pos < m_text.size() && digits < maxDigits &&
+               std::isdigit(static_cast<unsigned char>(m_text[m_pos]))) {
+            value = value * 10 + (m_text[m_pos] - '0');
+            ++m_pos;
+            ++digits;
+        }
+        return digits ? std::optional<int>(value) : std::nullopt;
+    }
+
+    bool consumeDirect(std::string_view word) {
+        if (m_text.substr(m_pos, word.size()) == word) {
+            m_pos += word.size();
+            return true;
+        }
+        return false;
+    }
+
+   private:
+    // Colons are skipped too, so labels like "营业时间: ..." or "Sat: ..."
+    // read the same as without them. Colons inside times are consumed
+    // directly by parseTime().
+    void skipSpaces() {
+        while (m_pos < m_text.size()) {
+            char c = m_text[m_pos];
+            if (c == ' ' || c == '\t' || c == '\r' || c == ':') {
+                ++m_pos;
+            } else if (m_text.compare(m_pos, 3, "　") == 0 ||  // Ideographic space
+                       m_text.compare(m_pos, 3, "：") == 0) {
+                m_pos += 3;
+            } else {
+                return;
+            }
+        }
+    }
+
+    std::string_view m_text;
+    std::size_t m_pos = 0;
+};
+
+std::optional<int> parseSingleDay(Lexer &lexer) {
+    std::size_t start = lexer.position();
+    for (std::string_view prefix : {"星期", "礼拜", "周"}) {
+        if (lexer.consume(prefix)) {
+            for (const auto &[suffix, day] : kChineseDays) {
+                if (lexer.consumeDirect(suffix)) {
+                    return day;
+                }
+            }
+            lexer.rewind(start);
+            return std::nullopt;
+        }
+    }
+    std::string word = lexer.readAsciiWord();
+    if (word.size() >= 3) {
+        for (int day = 0; day < 7; ++day) {
+            if (kEnglishDays[day].compare(0, word.size(), word) == 0) {
+                return day;
+            }
+        }
+    }
+    lexer.rewind(start);
+    return std::nullopt;
+}
+
+// A day, a day range or a named group of days.
+std::optional<DayMask> parseDaySpec(Lexer &lexer) {
+    if (lexer.consume("周末") || lexer.consume("weekends") || lexer.consume("weekend")) {
+        return kWeekend;
+    }
+    if (lexer.consume("工作日") || lexer.consume("weekdays") || lexer.consume("weekday")) {
+        return kWeekdays;
+    }
+    if (lexer.consume("每天") || lexer.consume("每日") || lexer.consume("天天") ||
+        lexer.consume("daily") || lexer.consume("everyday")) {
+        return kAllDays;
+    }
+    std::optional<int> from = parseSingleDay(lexer);
+    if (!from) {
+        return std::nullopt;
+    }
+    std::size_t afterFirst = lexer.position();
+    if (lexer.consumeAny(kRangeSeparators)) {
+        if (std::optional<int> to = parseSingleDay(lexer)) {
+            return dayRange(*from, *to);
+        }
+        lexer.rewind(afterFirst);
+    }
+    return dayBit(*from);
+}
+
+std::optional<int> parseTime(Lexer &lexer) {
+    std::size_t start = lexer.position();
+    std::optional<int> hour = lexer.readNumber(2);
+    if (!hour) {
+        return std::nullopt;
+    }
+    int minute = 0;
+    if (lexer.consumeDirect(":") || lexer.consumeDirect("：") || lexer.consumeDirect(".")) {
+        std::optional<int> minutes = lexer.readNumber(2);
+        if (!minutes || *minutes >= 60) {
+            lexer.rewind(start);
+            return std::nullopt;
+        }
+        minute = *minutes;
+    } else {
+        lexer.consumeDirect("点");
+    }
+    // 12-hour clock: 12am is midnight, 12pm noon
+    bool pm = lexer.consume("pm");
+    if (pm || lexer.consume("am")) {
+        if (*hour < 1 || *hour > 12) {
+            lexer.rewind(start);
+            return std::nullopt;
+        }
+        *hour = *hour % 12 + (pm ? 12 : 0);
+    }
+    if (*hour > 24 || (*hour == 24 && minute != 0)) {
+        lexer.rewind(start);
+        return std::nullopt;
+    }
+    return *hour * 60 + minute;
+}
+
+// Minutes relative to the start of the day; end may pass midnight.
+std::optional<std::pair<int, int>> parseTimeRange(Lexer &lexer) {
+    std::size_t start = lexer.position();
+    std::optional<int> open = parseTime(lexer);
+    if (open && lexer.consumeAny(kRangeSeparators)) {
+        if (std::optional<int> close = parseTime(lexer)) {
+            int end = *close > *open ? *close : *close + OpeningHours::kMinutesPerDay;
+            return std::make_pair(*open, end);
+        }
+    }
+    lexer.rewind(start);
+    return std::nullopt;
+}
+
+std::vector<std::string_view> splitClauses(std::string_view text) {
+    std::vector<std::string_view> clauses;
+    std::size_t begin = 0;
+    std::size_t pos = 0;
+    while (pos < text.size()) {
+        std::size_t separatorLength = 0;
+        for (std::string_view separator : kClauseSeparators) {
+            if (text.compare(pos, separator.size(), separator) == 0) {
+                separatorLength = separator.size();
+                break;
+            }
+        }
+        if (separatorLength) {
+            clauses.push_back(text.substr(begin, pos - begin));
+            pos += separatorLength;
+            begin = pos;
+        } else {
+            ++pos;
+        }
+    }
+    clauses.push_back(text.substr(begin));
+    return clauses;
+}
+}  // namespace
+
+int OpeningHours::minuteOfWeek(int weekday, int hour, int minute) {
+    return weekday * kMinutesPerDay + hour * 60 + minute;
+}
+
+int OpeningHours::minuteOfWeek(const std::tm &localTime) {
+    int weekday = (localTime.tm_wday + 6) % 7;  // tm_wday counts from Sunday
+    return minuteOfWeek(weekday, localTime.tm_hour, localTime.tm_min);
+}
+
+OpeningHours OpeningHours::parse(const std::string &text) {
+    OpeningHours hours;
+    std::array<std::vector<std::pair<int, int>>, 7> daily;
+    DayMask currentDays = kAllDays;  // Ranges without a day spec repeat the last one
+    DayMask pendingDays = 0;         // Days listed in a clause of their own ("周六、周日 ...")
+    bool sawSchedule = false;
+
+    for (std::string_view clause : splitClauses(text)) {
+        Lexer lexer(clause);
+        // A clause holds one or more segments, each an optional day spec and
+        // its time ranges: "周一至周五 9:00-21:00 周末 10:00-23:00"
+        while (!lexer.atEnd()) {
+            lexer.consumeAny(kFillerWords);
+            DayMask days = 0;
+            while (std::optional<DayMask> spec = parseDaySpec(lexer)) {
+                days |= *spec;
+                lexer.consumeAny(kListSeparators);
+            }
+            lexer.consumeAny(kFillerWords);
+
+            std::vector<std::pair<int, int>> ranges;
+            bool closed = false;
+            while (!lexer.atEnd()) {
+                if (lexer.consumeAny(kAllDayWords)) {
+                    ranges.emplace_back(0, kMinutesPerDay);
+                } else if (lexer.consumeAny(kClosedWords)) {
+                    closed = true;
+                } else if (auto range = parseTimeRange(lexer)) {
+                    ranges.push_back(*range);
+                } else if (lexer.consumeAny(kFillerWords) ||
+                           (!ranges.empty() && lexer.consumeAny(kListSeparators))) {
+                    continue;  // "24小时营业", "11:30-14:00/17:00-21:30"
+                } else {
+                    std::size_t segmentEnd = lexer.position();
+                    if ((!ranges.empty() || closed) && parseDaySpec(lexer)) {
+                        lexer.rewind(segmentEnd);  // Next segment's days
+                        break;
+                    }
+                    return hours;  // Unrecognised text: keep only the raw string
+                }
+            }
+
+            if (ranges.empty() && !closed) {
+                if (!days) {
+                    return hours;
+                }
+                pendingDays |= days;
+                continue;
+            }
+            if (days || pendingDays) {
+                currentDays = days | pendingDays;
+                pendingDays = 0;
+            }
+            for (int day = 0; day < 7; ++day) {
+                if (!(currentDays & dayBit(day))) {
+                    continue;
+                }
+                if (closed) {
+                    daily[day].clear();
+                }
+                daily[day].insert(daily[day].end(), ranges.begin(), ranges.end());
+            }
+            sawSchedule = true;
+        }
+    }
+    if (!sawSchedule || pendingDays) {
+        return hours;
+    }
+
+    for (int day = 0; day < 7; ++day) {
+        for (const auto &[open, close] : daily[day]) {
+            int start = day * kMinutesPerDay + open;
+            int end = day * kMinutesPerDay + close;
+            if (end <= kMinutesPerWeek) {
+                hours.m_intervals.push_back({start, end});
+            } else {  // Sunday night running into Monday
+                hours.m_intervals.push_back({start, kMinutesPerWeek});
+                hours.m_intervals.push_back({0, end - kMinutesPerWeek});
+            }
+        }
+    }
+    std::sort(hours.m_intervals.begin(), hours.m_intervals.end(),
+              [](const Interval &a, const Interval &b) { return a.start < b.start; });
+    std::vector<Interval> merged;
+    for (const auto &interval : hours.m_intervals) {
+        if (!merged.empty() && interval.start <= merged.back().end) {
+            merged.back().end = std::max(merged.back().end, interval.end);
+        } else {
+            merged.push_back(interval);
+        }
+    }
+    hours.m_intervals = std::move(merged);
+    hours.m_structured = true;
+    return hours;
+}
+
+bool OpeningHours::isOpenAt(int minuteOfWeek) const {
+    auto it = std::upper_bound(
+        m_intervals.begin(), m_intervals.end(), minuteOfWeek,
+        [](int minute, const Interval &interval) { return minute < interval.start; });
+    return it != m_intervals.begin() && std::prev(it)->end > minuteOfWeek;
+}
+
+}  // namespace RecipeApp
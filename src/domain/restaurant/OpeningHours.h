@@ -0,0 +1,79 @@
+#ifndef OPENING_HOURS_H
+#define OPENING_HOURS_H
+
+#include <ctime>
+#include <string>
+#include <vector>
+
+namespace RecipeApp {
+
+/**
+ * @brief Weekly opening hours parsed from the free-form text users enter.
+ *
+ * Times are expressed as minute-of-week, counted from Monday 00:00
+ * (0 .. kMinutesPerWeek-1). Recognised text consists of clauses separated by
+ * ';', ',', '、' or new lines, each an optional day spec followed by time
+ * ranges (a day spec after a range starts a new clause), for example:
+ *
+ *   "09:00-21:00"                         every day
+ *   "Mon-Fri 11:00-14:00, 17:00-22:00; Sat 10:00-23:00"
+ *   "周一至周五 9:00-21:00，周末 10:00-02:00"  (ranges past midnight wrap)
+ *   "周一至周五 9:00-21:00 周末 10:00-23:00"
+ *   "11:30-14:00/17:00-21:30"
+ *   "Mon-Sun 9am-5pm"
+ *   "每天 10:00-22:00，周一休息"             ("休息"/"closed" clears those days)
+ *   "24小时营业" / "24/7"
+ *
+ * Text that does not fit is kept as-is but reported as unstructured, and
+ * such a restaurant is never considered open by time-based queries.
+ */
+class OpeningHours {
+   public:
+    static constexpr int kMinutesPerDay = 24 * 60;
+    static constexpr int kMinutesPerWeek = 7 * kMinutesPerDay;
+
+    /// Half-open [start, end) minute-of-week range.
+    struct Interval {
+        int start;
+        int end;
+
+        bool operator==(const Interval &other) const {
+            return start == other.start && end == other.end;
+        }
+    };
+
+    OpeningHours() = default;
+
+    /**
+     * @brief Parses opening hours text. Never throws; check isStructured().
+     */
+    static OpeningHours parse(const std::string &text);
+
+    /**
+     * @brief Minute of week for a weekday (0 = Monday .. 6 = Sunday) and time.
+     */
+    static int minuteOfWeek(int weekday, int hour, int minute);
+
+    /**
+     * @brief Minute of week of a local calendar time (uses tm_wday, tm_hour,
+     *        tm_min).
+     */
+    static int minuteOfWeek(const std::tm &localTime);
+
+    /// True if the text was understood (empty text is not structured).
+    bool isStructured() const { return m_structured; }
+
+    /// Sorted, non-overlapping open intervals.
+    const std::vector<Interval> &intervals() const { return m_intervals; }
+
+    /// O(log n) check whether the place is open at a minute of week.
+    bool isOpenAt(int minuteOfWeek) const;
+
+   private:
+    bool m_structured = false;
+    std::vector<Interval> m_intervals;
+};
+
+}  // namespace RecipeApp
+
+#endif  // OPENING_HOURS_H
@@ -43,6 +43,10 @@ void Restaurant::displayRestaurantDetails() const {
     std::cout << "Address: " << address << std::endl;
     std::cout << "Contact: " << contact << std::endl;
     std::cout << "Opening Hours: " << openingHours << std::endl;
+    if (location) {
+        std::cout << "Location: " << location->latitude << ", "
+                  << location->longitude << std::endl;
+    }
     std::cout << "Featured Recipe IDs: ";
     if (featuredRecipeIds.empty()) {
         std::cout << "None";
@@ -63,6 +67,10 @@ void to_json(json &j, const Restaurant &r) {
              {"contact", r.getContact()},
              {"openingHours", r.getOpeningHours()},
              {"featuredRecipeIds", r.getFeaturedRecipeIds()}};
+    if (r.getLocation()) {
+        j["latitude"] = r.getLocation()->latitude;
+        j["longitude"] = r.getLocation()->longitude;
+    }
 }
 
 }  // namespace RecipeApp
\ No newline at end of file
@@ -7,6 +7,8 @@
 #include <string>
 #include <vector>
 
+#include "GeoPoint.h"
+#include "OpeningHours.h"
 #include "json.hpp"  // For JSON serialization
 
 // Convenience alias
@@ -24,19 +26,24 @@ class Restaurant {
     std::string name;
     std::string address;
     std::string contact;
-    std::string openingHours;
+    std::string openingHours;  ///< Raw text, kept for display and persistence
+    OpeningHours parsedOpeningHours;  ///< Parsed from openingHours on every change
     std::vector<int> featuredRecipeIds;
+    std::optional<GeoPoint> location;  ///< Optional map position
 
     // Private constructor for Builder
     Restaurant(int id, std::string name, std::string address,
                std::string contact, std::string openingHours,
-               std::vector<int> featuredRecipeIds)
+               std::vector<int> featuredRecipeIds,
+               std::optional<GeoPoint> location)
         : restaurantId(id),
           name(std::move(name)),
           address(std::move(address)),
           contact(std::move(contact)),
           openingHours(std::move(openingHours)),
-          featuredRecipeIds(std::move(featuredRecipeIds)) {
+          parsedOpeningHours(OpeningHours::parse(this->openingHours)),
+          featuredRecipeIds(std::move(featuredRecipeIds)),
+          location(location) {
         if (this->name.empty())
             throw std::invalid_argument("Restaurant name cannot be empty.");
         // Address and contact can be optional depending on requirements, for
@@ -62,9 +69,13 @@ class Restaurant {
     const std::string &getAddress() const { return address; }
     const std::string &getContact() const { return contact; }
     const std::string &getOpeningHours() const { return openingHours; }
+    const OpeningHours &getParsedOpeningHours() const {
+        return parsedOpeningHours;
+    }
     const std::vector<int> &getFeaturedRecipeIds() const {
         return featuredRecipeIds;
     }
+    const std::optional<GeoPoint> &getLocation() const { return location; }
 
     // Setter methods
     void setName(const std::string &newName) {
@@ -85,12 +96,19 @@ class Restaurant {
     void setOpeningHours(const std::string &newOpeningHours) {
         // Opening hours can be an empty string if not specified
         openingHours = newOpeningHours;
+        parsedOpeningHours = OpeningHours::parse(openingHours);
     }
     // Setter for featuredRecipeIds might be useful if direct manipulation is
     // needed post-construction
     void setFeaturedRecipeIds(const std::vector<int> &ids) {
         featuredRecipeIds = ids;
     }
+    void setLocation(const std::optional<GeoPoint> &newLocation) {
+        if (newLocation && !newLocation->isValid())
+            throw std::invalid_argument(
+                "Restaurant coordinates are out of range.");
+        location = newLocation;
+    }
 
     // Methods for managing featured recipes
     void addFeaturedRecipe(int recipeId);
@@ -113,6 +131,7 @@ class RestaurantBuilder {
     std::string m_contact;
     std::string m_openingHours;            // Optional
     std::vector<int> m_featuredRecipeIds;  // Optional
+    std::optional<GeoPoint> m_location;    // Optional
 
    public:
     RestaurantBuilder(int id, const std::string &name) : m_id(id) {
@@ -146,6 +165,15 @@ class RestaurantBuilder {
         return *this;
     }
 
+    RestaurantBuilder &withLocation(double latitude, double longitude) {
+        GeoPoint point{latitude, longitude};
+        if (!point.isValid())
+            throw std::invalid_argument(
+                "Restaurant coordinates are out of range.");
+        m_location = point;
+        return *this;
+    }
+
     Restaurant build() const {
         // Ensure required fields are set (name is set in constructor)
         if (m_address.empty())
@@ -157,7 +185,7 @@ class RestaurantBuilder {
         // ID is also required, set in constructor.
 
         return Restaurant(m_id, m_name, m_address, m_contact, m_openingHours,
-                          m_featuredRecipeIds);
+                          m_featuredRecipeIds, m_location);
     }
 };
 
@@ -232,6 +260,24 @@ struct adl_serializer<RecipeApp::Restaurant> {
             }
             builder.withFeaturedRecipeIds(ids);
         }
+
+        // latitude/longitude are optional, but only as a pair
+        bool hasLatitude = j.contains("latitude") && !j.at("latitude").is_null();
+        bool hasLongitude =
+            j.contains("longitude") && !j.at("longitude").is_null();
+        if (hasLatitude || hasLongitude) {
+            if (!hasLatitude || !hasLongitude ||
+                !j.at("latitude").is_number() || !j.at("longitude").is_number())
+                throw std::runtime_error(
+                    "Restaurant latitude and longitude must both be numbers in "
+                    "JSON.");
+            try {
+                builder.withLocation(j.at("latitude").get<double>(),
+                                     j.at("longitude").get<double>());
+            } catch (const std::invalid_argument &e) {
+                throw std::runtime_error(e.what());
+            }
+        }
         return builder.build();
     }
 };
@@ -58,6 +58,34 @@ namespace RecipeApp
                  */
                 virtual bool remove(int restaurantId) = 0;
 
+                /**
+                 * @brief Updates several existing restaurants at once.
+                 * @param restaurants Restaurants to store; each must already exist (matched by ID).
+                 * @return True if all were stored. On failure none of the changes are kept.
+                 *
+                 * The default implementation falls back to one save() per restaurant;
+                 * repositories with a whole-file write should override it.
+                 */
+                virtual bool updateMany(const std::vector<::RecipeApp::Restaurant> &restaurants)
+                {
+                    std::vector<::RecipeApp::Restaurant> originals;
+                    originals.reserve(restaurants.size());
+                    for (const auto &restaurant : restaurants)
+                    {
+                        std::optional<::RecipeApp::Restaurant> original = findById(restaurant.getRestaurantId());
+                        if (!original.has_value() || save(restaurant) == -1)
+                        {
+                            for (auto it = originals.rbegin(); it != originals.rend(); ++it)
+                            {
+                                save(*it);
+                            }
+                            return false;
+                        }
+                        originals.push_back(std::move(original.value()));
+                    }
+                    return true;
+                }
+
                 /**
                  * @brief Gets the next available ID for a new restaurant.
                  * @return The next available ID.
@@ -0,0 +1,86 @@
+#ifndef DECODED_RECIPE_CACHE_H
+#define DECODED_RECIPE_CACHE_H
+
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+#include "../../domain/recipe/Recipe.h"
+
+namespace RecipeApp {
+namespace Logic {
+namespace Encyclopedia {
+
+/**
+ * @brief Small least-recently-used cache of fully decoded encyclopedia
+ *        recipes, keyed by record position. Not thread-safe; the owner
+ *        serializes access. A capacity of 0 means unbounded.
+ */
+class DecodedRecipeCache {
+   public:
+    explicit DecodedRecipeCache(std::size_t capacity = 128)
+        : m_capacity(capacity) {}
+
+    /**
+     * @brief Returns the cached recipe and marks it most recently used.
+     * @return Pointer valid until the next put/clear, or nullptr on a miss.
+     */
+    const RecipeApp::Recipe* get(std::size_t position) {
+        auto it = m_lookup.find(position);
+        if (it == m_lookup.end()) {
+            return nullptr;
+        }
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        return &it->second->second;
+    }
+
+    /**
+     * @brief Inserts (or replaces) a decoded recipe, evicting the least
+     *        recently used entry when full.
+     */
+    const RecipeApp::Recipe& put(std::size_t position, RecipeApp::Recipe recipe) {
+        auto it = m_lookup.find(position);
+        if (it != m_lookup.end()) {
+            it->second->second = std::move(recipe);
+            m_entries.splice(m_entries.begin(), m_entries, it->second);
+            return it->second->second;
+        }
+        if (m_capacity > 0 && m_entries.size() >= m_capacity) {
+            m_lookup.erase(m_entries.back().first);
+            m_entries.pop_back();
+        }
+        m_entries.emplace_front(position, std::move(recipe));
+        m_lookup[position] = m_entries.begin();
+        return m_entries.front().second;
+    }
+
+    void clear() {
+        m_entries.clear();
+        m_lookup.clear();
+    }
+
+    void setCapacity(std::size_t capacity) {
+        m_capacity = capacity;
+        while (m_capacity > 0 && m_entries.size() > m_capacity) {
+            m_lookup.erase(m_entries.back().first);
+            m_entries.pop_back();
+        }
+    }
+
+    std::size_t size() const { return m_entries.size(); }
+    std::size_t capacity() const { return m_capacity; }
+
+   private:
+    using Entry = std::pair<std::size_t, RecipeApp::Recipe>;
+
+    std::size_t m_capacity;
+    std::list<Entry> m_entries;  // Most recently used first
+    std::unordered_map<std::size_t, std::list<Entry>::iterator> m_lookup;
+};
+
+}  // namespace Encyclopedia
+}  // namespace Logic
+}  // namespace RecipeApp
+
+#endif  // DECODED_RECIPE_CACHE_H
@@ -2,22 +2,21 @@
 
 #include <algorithm>  // For std::transform and std::search
 #include <cctype>     // For std::tolower
+#include <cstdint>
+#include <filesystem>
 #include <fstream>    // For std::ifstream
+#include <iterator>   // For std::back_inserter
 #include <iostream>   // For std::cerr (error logging)
+#include <numeric>    // For std::iota
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace RecipeApp {
 namespace Logic {
 namespace Encyclopedia {
 
-namespace {  // Anonymous namespace for helper functions
-// Helper function to convert string to lowercase
-std::string toLower(std::string s) {
-    std::transform(s.begin(), s.end(), s.begin(),
-                   [](unsigned char c) { return std::tolower(c); });
-    return s;
-}
-}  // end anonymous namespace
-
 RecipeEncyclopediaManager::RecipeEncyclopediaManager() {
     // Constructor can be empty or initialize members if needed
 }
@@ -28,8 +27,11 @@ RecipeEncyclopediaManager::~RecipeEncyclopediaManager() {
 }
 
 bool RecipeEncyclopediaManager::loadRecipes(const std::string& filepath) {
-    encyclopediaRecipes
-        .clear();  // Clear existing recipes before loading new ones
+    resetState();  // Clear existing recipes before loading new ones
+
+    if (Persistence::isNdjsonPath(filepath)) {
+        return loadRecipesNdjson(filepath);
+    }
 
     std::ifstream file(filepath);
     if (!file.is_open()) {
@@ -65,6 +67,8 @@ bool RecipeEncyclopediaManager::loadRecipes(const std::string& filepath) {
                       << filepath << std::endl;
             return false;
         }
+        rebuildIdIndex();
+        rebuildSearchIndex();
         std::cout << "[RecipeEncyclopediaManager] Successfully loaded "
                   << encyclopediaRecipes.size() << " recipes from " << filepath
                   << std::endl;
@@ -82,67 +86,861 @@ bool RecipeEncyclopediaManager::loadRecipes(const std::string& filepath) {
     return false;  // Should not be reached if try-catch is exhaustive
 }
 
+bool RecipeEncyclopediaManager::loadRecipesNdjson(const std::string& filepath) {
+    Persistence::MappedFile file;
+    if (!file.open(filepath)) {
+        std::cerr << "[RecipeEncyclopediaManager] Error: Could not open file: "
+                  << filepath << std::endl;
+        return false;
+    }
+
+    std::vector<Persistence::RecordSpan> spans;
+    Persistence::scanNdjsonRecords(file.view(), spans);
+    encyclopediaRecipes.reserve(spans.size());
+    size_t skipped = 0;
+    for (const auto& span : spans) {
+        // Each line stands alone: a corrupt one is reported and skipped.
+        try {
+            encyclopediaRecipes.push_back(
+                nlohmann::json::parse(file.data() + span.offset,
+                                      file.data() + span.offset + span.length)
+                    .get<RecipeApp::Recipe>());
+        } catch (const std::exception& e) {
+            ++skipped;
+            std::cerr << "[RecipeEncyclopediaManager] Skipping NDJSON record "
+                         "at byte "
+                      << span.offset << ": " << e.what() << std::endl;
+        }
+    }
+
+    rebuildIdIndex();
+    rebuildSearchIndex();
+    std::cout << "[RecipeEncyclopediaManager] Successfully loaded "
+              << encyclopediaRecipes.size() << " recipes from " << filepath;
+    if (skipped > 0) {
+        std::cout << " (" << skipped << " corrupt lines skipped)";
+    }
+    std::cout << std::endl;
+    return true;
+}
+
+bool RecipeEncyclopediaManager::loadRecipesParallel(const std::string& filepath,
+                                                    unsigned threadCount) {
+    resetState();
+
+    Persistence::MappedFile file;
+    if (!file.open(filepath)) {
+        std::cerr << "[RecipeEncyclopediaManager] Error: Could not open file: "
+                  << filepath << std::endl;
+        return false;
+    }
+    const bool ndjson = Persistence::isNdjsonPath(filepath);
+    std::vector<Persistence::RecordSpan> spans;
+    if (ndjson) {
+        Persistence::scanNdjsonRecords(file.view(), spans);
+    } else if (!Persistence::scanJsonArrayRecords(file.view(), spans)) {
+        std::cerr << "[RecipeEncyclopediaManager] Error: JSON data is not "
+                     "an array in file: "
+                  << filepath << std::endl;
+        return false;
+    }
+
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    size_t workerCount = std::min<size_t>(threadCount, std::max<size_t>(spans.size(), 1));
+
+    // Each worker parses one contiguous run of records into its own slot, so
+    // concatenating the slots restores the file order. Diagnostics are
+    // buffered per worker and printed afterwards in the same order.
+    struct Chunk {
+        std::vector<RecipeApp::Recipe> recipes;
+        std::ostringstream errors;
+        bool syntaxError = false;
+    };
+    std::vector<Chunk> chunks(workerCount);
+    auto parseChunk = [&](size_t worker) {
+        Chunk& chunk = chunks[worker];
+        size_t begin = spans.size() * worker / workerCount;
+        size_t end = spans.size() * (worker + 1) / workerCount;
+        chunk.recipes.reserve(end - begin);
+        for (size_t i = begin; i < end; ++i) {
+            const char* text = file.data() + spans[i].offset;
+            nlohmann::json item;
+            try {
+                item = nlohmann::json::parse(text, text + spans[i].length);
+            } catch (const nlohmann::json::parse_error& e) {
+                chunk.errors << "[RecipeEncyclopediaManager] Error parsing "
+                                "record at byte "
+                             << spans[i].offset << ": " << e.what() << '\n';
+                if (!ndjson) {
+                    chunk.syntaxError = true;  // The document itself is invalid
+                    return;
+                }
+                continue;
+            }
+            try {
+                chunk.recipes.push_back(item.get<RecipeApp::Recipe>());
+            } catch (const std::exception& e) {
+                chunk.errors << "[RecipeEncyclopediaManager] Error parsing a "
+                                "recipe item: "
+                             << e.what() << '\n';
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(workerCount - 1);
+    for (size_t worker = 1; worker < workerCount; ++worker) {
+        workers.emplace_back(parseChunk, worker);
+    }
+    parseChunk(0);  // The calling thread takes the first chunk
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    size_t total = 0;
+    bool syntaxError = false;
+    for (auto& chunk : chunks) {
+        std::cerr << chunk.errors.str();
+        total += chunk.recipes.size();
+        syntaxError = syntaxError || chunk.syntaxError;
+    }
+    if (syntaxError) {
+        std::cerr << "[RecipeEncyclopediaManager] Error parsing JSON file "
+                  << filepath << std::endl;
+        return false;
+    }
+    encyclopediaRecipes.reserve(total);
+    for (auto& chunk : chunks) {
+        std::move(chunk.recipes.begin(), chunk.recipes.end(),
+                  std::back_inserter(encyclopediaRecipes));
+    }
+
+    rebuildIdIndex();
+    rebuildSearchIndex();
+    std::cout << "[RecipeEncyclopediaManager] Successfully loaded "
+              << encyclopediaRecipes.size() << " recipes from " << filepath
+              << " using " << workerCount << " threads" << std::endl;
+    return true;
+}
+
+bool RecipeEncyclopediaManager::saveRecipesNdjson(
+    const std::string& filepath) const {
+    std::ofstream file(filepath, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "[RecipeEncyclopediaManager] Error: Could not open file "
+                     "for writing: "
+                  << filepath << std::endl;
+        return false;
+    }
+    for (const auto& recipe : getAllRecipes()) {
+        file << nlohmann::json(recipe).dump() << '\n';
+    }
+    file.close();
+    return !file.fail();
+}
+
+bool RecipeEncyclopediaManager::applyPatch(const std::string& patchPath,
+                                           PatchSummary* summary) {
+    // Parse the whole patch before touching anything, so a truncated or
+    // malformed file leaves the encyclopedia as it was.
+    std::ifstream file(patchPath, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "[RecipeEncyclopediaManager] Error: Could not open patch "
+                     "file: "
+                  << patchPath << std::endl;
+        return false;
+    }
+    std::string contents((std::istreambuf_iterator<char>(file)),
+                         std::istreambuf_iterator<char>());
+    std::vector<nlohmann::json> operations;
+    try {
+        if (Persistence::isNdjsonPath(patchPath)) {
+            std::vector<Persistence::RecordSpan> spans;
+            Persistence::scanNdjsonRecords(contents, spans);
+            operations.reserve(spans.size());
+            for (const auto& span : spans) {
+                operations.push_back(nlohmann::json::parse(
+                    contents.data() + span.offset,
+                    contents.data() + span.offset + span.length));
+            }
+        } else {
+            nlohmann::json document = nlohmann::json::parse(contents);
+            if (!document.is_array()) {
+                std::cerr << "[RecipeEncyclopediaManager] Error: Patch file is "
+                             "not a JSON array: "
+                          << patchPath << std::endl;
+                return false;
+            }
+            operations.reserve(document.size());
+            for (auto& operation : document) {
+                operations.push_back(std::move(operation));
+            }
+        }
+    } catch (const nlohmann::json::parse_error& e) {
+        std::cerr << "[RecipeEncyclopediaManager] Error parsing patch file "
+                  << patchPath << ": " << e.what() << std::endl;
+        return false;
+    }
+
+    PatchSummary counts;
+    if (isLazy()) {
+        applyPatchToOverlay(operations, patchPath, counts);
+    } else {
+        applyPatchToRecipes(operations, patchPath, counts);
+    }
+
+    std::cout << "[RecipeEncyclopediaManager] Applied patch " << patchPath
+              << ": " << counts.added << " added, " << counts.replaced
+              << " replaced, " << counts.removed << " removed";
+    if (counts.skipped > 0) {
+        std::cout << " (" << counts.skipped << " operations skipped)";
+    }
+    std::cout << std::endl;
+    if (summary) {
+        *summary = counts;
+    }
+    return true;
+}
+
+void RecipeEncyclopediaManager::logSkippedOperation(
+    const std::string& patchPath, size_t index, const std::string& reason) {
+    std::cerr << "[RecipeEncyclopediaManager] Skipping patch operation "
+              << index + 1 << " in " << patchPath << ": " << reason
+              << std::endl;
+}
+
+void RecipeEncyclopediaManager::applyPatchToRecipes(
+    const std::vector<nlohmann::json>& operations, const std::string& patchPath,
+    PatchSummary& counts) {
+    // Removals are only marked here and compacted once at the end, so every
+    // position stays valid while the operations run.
+    std::vector<bool> removed(encyclopediaRecipes.size(), false);
+    std::unordered_map<int, size_t> addedPositions;
+    auto positionOf = [&](int id) {
+        auto added = addedPositions.find(id);
+        if (added != addedPositions.end()) {
+            return added->second;
+        }
+        size_t position = idIndex.find(id);
+        return position != Search::IdPositionIndex::npos && !removed[position]
+                   ? position
+                   : Search::IdPositionIndex::npos;
+    };
+    auto skip = [&](size_t index, const std::string& reason) {
+        ++counts.skipped;
+        logSkippedOperation(patchPath, index, reason);
+    };
+
+    for (size_t i = 0; i < operations.size(); ++i) {
+        const auto& operation = operations[i];
+        try {
+            std::string op = operation.at("op").get<std::string>();
+            if (op == "remove") {
+                int id = operation.at("id").get<int>();
+                size_t position = positionOf(id);
+                if (position == Search::IdPositionIndex::npos) {
+                    skip(i, "no recipe with ID " + std::to_string(id));
+                    continue;
+                }
+                removed[position] = true;
+                addedPositions.erase(id);
+                searchIndex.removeDocument(id);
+                ++counts.removed;
+            } else if (op == "add" || op == "replace") {
+                RecipeApp::Recipe recipe =
+                    operation.at("recipe").get<RecipeApp::Recipe>();
+                int id = recipe.getRecipeId();
+                size_t position = positionOf(id);
+                if (op == "add") {
+                    if (id <= 0 || position != Search::IdPositionIndex::npos) {
+                        skip(i, "ID " + std::to_string(id) +
+                                    " is invalid or already present");
+                        continue;
+                    }
+                    addedPositions[id] = encyclopediaRecipes.size();
+                    removed.push_back(false);
+                    encyclopediaRecipes.push_back(recipe);
+                    ++counts.added;
+                } else {
+                    if (position == Search::IdPositionIndex::npos) {
+                        skip(i, "no recipe with ID " + std::to_string(id));
+                        continue;
+                    }
+                    encyclopediaRecipes[position] = recipe;
+                    ++counts.replaced;
+                }
+                searchIndex.addDocument(id, searchFieldsOf(recipe));
+            } else {
+                skip(i, "unknown op '" + op + "'");
+            }
+        } catch (const std::exception& e) {
+            skip(i, e.what());
+        }
+    }
+
+    if (counts.removed > 0) {
+        size_t kept = 0;
+        for (size_t i = 0; i < encyclopediaRecipes.size(); ++i) {
+            if (!removed[i]) {
+                if (kept != i) {
+                    encyclopediaRecipes[kept] = std::move(encyclopediaRecipes[i]);
+                }
+                ++kept;
+            }
+        }
+        encyclopediaRecipes.erase(encyclopediaRecipes.begin() + kept,
+                                  encyclopediaRecipes.end());
+    }
+    if (counts.added > 0 || counts.removed > 0) {
+        rebuildIdIndex();
+    }
+}
+
+void RecipeEncyclopediaManager::applyPatchToOverlay(
+    const std::vector<nlohmann::json>& operations, const std::string& patchPath,
+    PatchSummary& counts) {
+    // IDs touched by this patch and whether they are still present; the ID
+    // index describes the state before the patch until it is rebuilt.
+    std::unordered_map<int, bool> touched;
+    auto isPresent = [&](int id) {
+        auto it = touched.find(id);
+        return it != touched.end()
+                   ? it->second
+                   : idIndex.find(id) != Search::IdPositionIndex::npos;
+    };
+    auto skip = [&](size_t index, const std::string& reason) {
+        ++counts.skipped;
+        logSkippedOperation(patchPath, index, reason);
+    };
+
+    for (size_t i = 0; i < operations.size(); ++i) {
+        const auto& operation = operations[i];
+        try {
+            std::string op = operation.at("op").get<std::string>();
+            if (op == "remove") {
+                int id = operation.at("id").get<int>();
+                if (!isPresent(id)) {
+                    skip(i, "no recipe with ID " + std::to_string(id));
+                    continue;
+                }
+                auto appended =
+                    std::find(appendedIds.begin(), appendedIds.end(), id);
+                if (appended != appendedIds.end()) {
+                    appendedIds.erase(appended);
+                } else {
+                    removedIds.insert(id);
+                }
+                overlayRecipes.erase(id);
+                searchIndex.removeDocument(id);
+                touched[id] = false;
+                ++counts.removed;
+            } else if (op == "add" || op == "replace") {
+                RecipeApp::Recipe recipe =
+                    operation.at("recipe").get<RecipeApp::Recipe>();
+                int id = recipe.getRecipeId();
+                if (op == "add") {
+                    if (id <= 0 || isPresent(id)) {
+                        skip(i, "ID " + std::to_string(id) +
+                                    " is invalid or already present");
+                        continue;
+                    }
+                    // A re-added ID keeps its mapped record tombstoned
+                    appendedIds.push_back(id);
+                    touched[id] = true;
+                    ++counts.added;
+                } else {
+                    if (!isPresent(id)) {
+                        skip(i, "no recipe with ID " + std::to_string(id));
+                        continue;
+                    }
+                    ++counts.replaced;
+                }
+                searchIndex.addDocument(id, searchFieldsOf(recipe));
+                overlayRecipes.insert_or_assign(id, std::move(recipe));
+            } else {
+                skip(i, "unknown op '" + op + "'");
+            }
+        } catch (const std::exception& e) {
+            skip(i, e.what());
+        }
+    }
+
+    if (counts.added > 0 || counts.removed > 0) {
+        rebuildOverlaySlots();
+    }
+    // Decoded copies may be stale or sit at shifted positions
+    std::lock_guard<std::mutex> lock(lazyMutex);
+    decodedCache.clear();
+    encyclopediaRecipes.clear();
+    allMaterialized = false;
+}
+
+void RecipeEncyclopediaManager::rebuildOverlaySlots() {
+    // Only IDs are read; no record is decoded
+    size_t mapped = mappedRecordCount();
+    std::vector<int> ids;
+    ids.reserve(mapped + appendedIds.size());
+    overlaySlots.clear();
+    overlaySlots.reserve(mapped + appendedIds.size());
+    for (size_t slot = 0; slot < mapped; ++slot) {
+        int id = mappedRecordId(slot);
+        if (removedIds.count(id) == 0) {
+            overlaySlots.push_back(slot);
+            ids.push_back(id);
+        }
+    }
+    for (size_t k = 0; k < appendedIds.size(); ++k) {
+        overlaySlots.push_back(mapped + k);
+        ids.push_back(appendedIds[k]);
+    }
+    overlayActive = true;
+    idIndex.build(ids);
+}
+
+size_t RecipeEncyclopediaManager::mappedRecordCount() const {
+    return loadMode == LoadMode::Bundle ? bundle.recordCount()
+                                        : recordSpans.size();
+}
+
+int RecipeEncyclopediaManager::mappedRecordId(size_t slot) const {
+    return loadMode == LoadMode::Bundle ? bundle.recordId(slot)
+                                        : lazyRecordIds[slot];
+}
+
+bool RecipeEncyclopediaManager::loadRecipesLazy(const std::string& filepath,
+                                                size_t cacheCapacity) {
+    resetState();
+
+    if (!mappedFile.open(filepath)) {
+        std::cerr << "[RecipeEncyclopediaManager] Error: Could not map file: "
+                  << filepath << std::endl;
+        return false;
+    }
+
+    std::vector<Persistence::RecordSpan> spans;
+    if (Persistence::isNdjsonPath(filepath)) {
+        Persistence::scanNdjsonRecords(mappedFile.view(), spans);
+    } else if (!Persistence::scanJsonArrayRecords(mappedFile.view(), spans)) {
+        std::cerr << "[RecipeEncyclopediaManager] Error: JSON data is not "
+                     "an array in file: "
+                  << filepath << std::endl;
+        resetState();
+        return false;
+    }
+
+    // Only the searchable top-level keys survive parsing; everything else
+    // (steps, nutrition, ...) is dropped by the parser callback.
+    static const std::unordered_set<std::string> kIndexedKeys = {
+        "id", "name", "ingredients", "tags"};
+    nlohmann::json::parser_callback_t keepIndexedKeys =
+        [](int depth, nlohmann::json::parse_event_t event,
+           nlohmann::json& parsed) {
+            if (event == nlohmann::json::parse_event_t::key && depth == 1) {
+                return kIndexedKeys.count(parsed.get<std::string>()) > 0;
+            }
+            return true;
+        };
+
+    std::vector<int> ids;
+    std::unordered_set<int> indexedIds;
+    recordSpans.reserve(spans.size());
+    ids.reserve(spans.size());
+    const char* base = mappedFile.data();
+    for (const auto& span : spans) {
+        try {
+            nlohmann::json item =
+                nlohmann::json::parse(base + span.offset,
+                                      base + span.offset + span.length,
+                                      keepIndexedKeys);
+            if (!item.is_object() || !item.contains("id") ||
+                !item["id"].is_number_integer() ||
+                item["id"].get<int>() <= 0 || !item.contains("name") ||
+                !item["name"].is_string()) {
+                std::cerr << "[RecipeEncyclopediaManager] Skipping a recipe "
+                             "item without a valid id and name."
+                          << std::endl;
+                continue;
+            }
+
+            std::vector<std::string> fields;
+            fields.push_back(item["name"].get<std::string>());
+            if (item.contains("ingredients") && item["ingredients"].is_array()) {
+                for (const auto& ingredient : item["ingredients"]) {
+                    if (ingredient.is_object() && ingredient.contains("name") &&
+                        ingredient["name"].is_string()) {
+                        fields.push_back(ingredient["name"].get<std::string>());
+                    }
+                }
+            }
+            if (item.contains("tags") && item["tags"].is_array()) {
+                for (const auto& tag : item["tags"]) {
+                    if (tag.is_string()) {
+                        fields.push_back(tag.get<std::string>());
+                    }
+                }
+            }
+
+            int id = item["id"].get<int>();
+            recordSpans.push_back(span);
+            ids.push_back(id);
+            if (indexedIds.insert(id).second) {  // First occurrence wins
+                searchIndex.addDocument(id, fields);
+            }
+        } catch (const nlohmann::json::exception& e) {
+            std::cerr << "[RecipeEncyclopediaManager] Error parsing a "
+                         "recipe item: "
+                      << e.what() << std::endl;
+        }
+    }
+
+    idIndex.build(ids);
+    lazyRecordIds = std::move(ids);
+    decodedCache.setCapacity(cacheCapacity);
+    loadMode = LoadMode::LazyJson;
+    std::cout << "[RecipeEncyclopediaManager] Lazily indexed "
+              << recordSpans.size() << " recipes from " << filepath
+              << std::endl;
+    return true;
+}
+
+bool RecipeEncyclopediaManager::loadBundle(const std::string& bundlePath,
+                                           const std::string& sourceJsonPath,
+                                           size_t cacheCapacity) {
+    resetState();
+
+    if (!bundle.open(bundlePath)) {
+        std::cerr << "[RecipeEncyclopediaManager] Could not open encyclopedia "
+                     "bundle (missing or incompatible): "
+                  << bundlePath << std::endl;
+        return false;
+    }
+    if (!sourceJsonPath.empty() && !bundle.isFreshFor(sourceJsonPath)) {
+        std::cerr << "[RecipeEncyclopediaManager] Encyclopedia bundle "
+                  << bundlePath << " is stale relative to " << sourceJsonPath
+                  << std::endl;
+        resetState();
+        return false;
+    }
+
+    // Both indexes are queried in place; nothing is rebuilt here.
+    Common::ByteReader reader(bundle.indexBlob());
+    std::string_view idTable = reader.readStringView();
+    if (!reader.ok() ||
+        !idIndex.attach(idTable, bundle.recordCount()) ||
+        !searchIndex.attach(bundle.indexBlob().substr(reader.position()),
+                            bundle.stringPool())) {
+        std::cerr << "[RecipeEncyclopediaManager] Encyclopedia bundle "
+                  << bundlePath << " has a corrupt index" << std::endl;
+        resetState();
+        return false;
+    }
+    decodedCache.setCapacity(cacheCapacity);
+    loadMode = LoadMode::Bundle;
+    std::cout << "[RecipeEncyclopediaManager] Loaded " << bundle.recordCount()
+              << " recipes from bundle " << bundlePath << std::endl;
+    return true;
+}
+
+bool RecipeEncyclopediaManager::loadPreferringBundle(
+    const std::string& bundlePath, const std::string& jsonPath,
+    size_t lazyThresholdBytes) {
+    if (!bundlePath.empty() && loadBundle(bundlePath, jsonPath)) {
+        return true;
+    }
+    // Large files are mapped and decoded on demand instead of parsed upfront
+    std::error_code sizeError;
+    std::uintmax_t fileSize =
+        jsonPath.empty() ? 0 : std::filesystem::file_size(jsonPath, sizeError);
+    if (!sizeError && fileSize >= lazyThresholdBytes) {
+        return loadRecipesLazy(jsonPath);
+    }
+    return loadRecipesParallel(jsonPath);
+}
+
+bool RecipeEncyclopediaManager::compileBundle(const std::string& jsonPath,
+                                              const std::string& bundlePath) {
+    RecipeEncyclopediaManager source;
+    if (!source.loadRecipes(jsonPath)) {
+        return false;
+    }
+    Persistence::MappedFile sourceBytes;
+    if (!sourceBytes.open(jsonPath)) {
+        std::cerr << "[RecipeEncyclopediaManager] Error: Could not map file: "
+                  << jsonPath << std::endl;
+        return false;
+    }
+
+    // Search keys are recipe IDs, so they stay valid for the bundle's record
+    // order (and for patches applied after loading it). The ID index maps to
+    // positions in encyclopediaRecipes, which become the record positions.
+    return Persistence::EncyclopediaBundle::write(
+        bundlePath, source.encyclopediaRecipes, sourceBytes.view(),
+        [&source](Common::ByteWriter& writer,
+                  const Common::StringRefWriter& writeRef) {
+            std::string idTable;
+            Common::ByteWriter idWriter(idTable);
+            source.idIndex.serialize(idWriter);
+            writer.writeString(idTable);
+            source.searchIndex.serialize(writer, writeRef);
+        });
+}
+
+size_t RecipeEncyclopediaManager::size() const {
+    switch (loadMode) {
+        case LoadMode::LazyJson:
+        case LoadMode::Bundle:
+            return overlayActive ? overlaySlots.size() : mappedRecordCount();
+        case LoadMode::Eager:
+        default:
+            return encyclopediaRecipes.size();
+    }
+}
+
 const std::vector<RecipeApp::Recipe>& RecipeEncyclopediaManager::getAllRecipes()
     const {
+    if (isLazy()) {
+        std::lock_guard<std::mutex> lock(lazyMutex);
+        if (!allMaterialized) {
+            // Decode straight into the vector; going through the LRU would
+            // only evict the entries that are actually hot.
+            size_t count = size();
+            encyclopediaRecipes.clear();
+            encyclopediaRecipes.reserve(count);
+            for (size_t i = 0; i < count; ++i) {
+                if (auto recipe = decodeRecord(i)) {
+                    encyclopediaRecipes.push_back(std::move(*recipe));
+                }
+            }
+            allMaterialized = true;
+        }
+    }
     return encyclopediaRecipes;
 }
 
-bool RecipeEncyclopediaManager::containsCaseInsensitive(
-    const std::string& text, const std::string& searchTerm) const {
-    if (searchTerm.empty())
-        return true;  // Or false, depending on desired behavior for empty
-                      // search term
-    if (text.empty()) return false;
+void RecipeEncyclopediaManager::resetState() {
+    std::lock_guard<std::mutex> lock(lazyMutex);
+    encyclopediaRecipes.clear();
+    searchIndex.clear();
+    idIndex.clear();
+    loadMode = LoadMode::Eager;
+    recordSpans.clear();
+    bundle.close();
+    decodedCache.clear();
+    allMaterialized = false;
+    mappedFile.close();
+    lazyRecordIds.clear();
+    overlayRecipes.clear();
+    removedIds.clear();
+    appendedIds.clear();
+    overlaySlots.clear();
+    overlayActive = false;
+}
 
-    std::string lowerText = toLower(text);
-    std::string lowerSearchTerm = toLower(searchTerm);
+std::optional<RecipeApp::Recipe> RecipeEncyclopediaManager::decodeRecord(
+    size_t position) const {
+    size_t slot = overlayActive ? overlaySlots[position] : position;
+    size_t mapped = mappedRecordCount();
+    if (slot >= mapped) {
+        return overlayRecipes.at(appendedIds[slot - mapped]);
+    }
+    if (!overlayRecipes.empty()) {
+        auto replaced = overlayRecipes.find(mappedRecordId(slot));
+        if (replaced != overlayRecipes.end()) {
+            return replaced->second;
+        }
+    }
+    if (loadMode == LoadMode::Bundle) {
+        return bundle.decodeRecipe(slot);
+    }
+    const auto& span = recordSpans[slot];
+    const char* begin = mappedFile.data() + span.offset;
+    try {
+        return nlohmann::json::parse(begin, begin + span.length)
+            .get<RecipeApp::Recipe>();
+    } catch (const std::exception& e) {
+        std::cerr << "[RecipeEncyclopediaManager] Error decoding recipe at "
+                     "offset "
+                  << span.offset << ": " << e.what() << std::endl;
+        return std::nullopt;
+    }
+}
 
-    return lowerText.find(lowerSearchTerm) != std::string::npos;
+std::optional<RecipeApp::Recipe> RecipeEncyclopediaManager::recipeAt(
+    size_t position) const {
+    if (!isLazy()) {
+        return encyclopediaRecipes[position];
+    }
+    std::lock_guard<std::mutex> lock(lazyMutex);
+    if (const RecipeApp::Recipe* cached = decodedCache.get(position)) {
+        return *cached;
+    }
+    std::optional<RecipeApp::Recipe> recipe = decodeRecord(position);
+    if (recipe) {
+        decodedCache.put(position, *recipe);
+    }
+    return recipe;
+}
+
+std::vector<std::string> RecipeEncyclopediaManager::searchFieldsOf(
+    const RecipeApp::Recipe& recipe) {
+    std::vector<std::string> fields;
+    fields.reserve(1 + recipe.getIngredients().size() + recipe.getTags().size());
+    fields.push_back(recipe.getName());
+    for (const auto& ingredient : recipe.getIngredients()) {
+        fields.push_back(ingredient.name);
+    }
+    for (const auto& tag : recipe.getTags()) {
+        fields.push_back(tag);
+    }
+    return fields;
+}
+
+void RecipeEncyclopediaManager::rebuildSearchIndex() {
+    searchIndex.clear();
+    for (size_t i = 0; i < encyclopediaRecipes.size(); ++i) {
+        const auto& recipe = encyclopediaRecipes[i];
+        // Keyed by ID; a duplicate ID is only reachable at its first position
+        if (idIndex.find(recipe.getRecipeId()) == i) {
+            searchIndex.addDocument(recipe.getRecipeId(), searchFieldsOf(recipe));
+        }
+    }
+}
+
+std::vector<size_t> RecipeEncyclopediaManager::positionsInFileOrder(
+    const std::vector<int>& ids) const {
+    std::vector<size_t> positions;
+    positions.reserve(ids.size());
+    for (int id : ids) {
+        size_t position = idIndex.find(id);
+        if (position != Search::IdPositionIndex::npos) {
+            positions.push_back(position);
+        }
+    }
+    std::sort(positions.begin(), positions.end());
+    return positions;
+}
+
+std::vector<size_t> RecipeEncyclopediaManager::findRecipePositions(
+    const std::string& searchTerm) const {
+    if (searchTerm.empty()) {
+        std::vector<size_t> positions(size());
+        std::iota(positions.begin(), positions.end(), size_t{0});
+        return positions;
+    }
+    return positionsInFileOrder(searchIndex.search(searchTerm));
+}
+
+std::vector<RecipeApp::Recipe> RecipeEncyclopediaManager::getRecipesAtPositions(
+    const std::vector<size_t>& positions) const {
+    std::vector<RecipeApp::Recipe> recipes;
+    recipes.reserve(positions.size());
+    size_t count = size();
+    if (!isLazy()) {
+        for (size_t position : positions) {
+            if (position < count) {
+                recipes.push_back(encyclopediaRecipes[position]);
+            }
+        }
+        return recipes;
+    }
+    std::lock_guard<std::mutex> lock(lazyMutex);
+    for (size_t position : positions) {
+        if (position >= count) {
+            continue;
+        }
+        // Reuse a cached decode, but do not cache a one-off streaming read
+        if (const RecipeApp::Recipe* cached = decodedCache.get(position)) {
+            recipes.push_back(*cached);
+        } else if (auto recipe = decodeRecord(position)) {
+            recipes.push_back(std::move(*recipe));
+        }
+    }
+    return recipes;
 }
 
 std::vector<RecipeApp::Recipe> RecipeEncyclopediaManager::searchRecipes(
     const std::string& searchTerm) const {
-    std::vector<RecipeApp::Recipe> results;
     if (searchTerm.empty()) {
-        return encyclopediaRecipes;  // Return all if search term is empty
+        return getAllRecipes();  // Return all if search term is empty
     }
 
-    for (const auto& recipe : encyclopediaRecipes) {
-        // Search in name
-        if (containsCaseInsensitive(recipe.getName(), searchTerm)) {
-            results.push_back(recipe);
-            continue;  // Found in name, no need to check other fields for this
-                       // recipe
+    // The index returns recipe IDs; results are reported in file order.
+    std::vector<RecipeApp::Recipe> results;
+    std::vector<size_t> positions =
+        positionsInFileOrder(searchIndex.search(searchTerm));
+    results.reserve(positions.size());
+    for (size_t position : positions) {
+        if (auto recipe = recipeAt(position)) {
+            results.push_back(std::move(*recipe));
         }
+    }
+    return results;
+}
 
-        // Search in ingredients
-        for (const auto& ingredient : recipe.getIngredients()) {
-            if (containsCaseInsensitive(ingredient.name, searchTerm)) {
-                results.push_back(recipe);
-                goto next_recipe;  // Found in ingredients, move to next recipe
-            }
+std::vector<Search::RecipeSearchHit>
+RecipeEncyclopediaManager::searchRecipesWithMatches(
+    const std::string& searchTerm) const {
+    std::vector<Search::NGramIndex::Hit> hits =
+        searchIndex.searchWithMatches(searchTerm);
+
+    // (position, hit) pairs, sorted into file order
+    std::vector<std::pair<size_t, const Search::NGramIndex::Hit*>> ordered;
+    ordered.reserve(hits.size());
+    for (const auto& hit : hits) {
+        size_t position = idIndex.find(hit.docKey);
+        if (position != Search::IdPositionIndex::npos) {
+            ordered.emplace_back(position, &hit);
         }
+    }
+    std::sort(ordered.begin(), ordered.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
 
-        // Search in tags
-        for (const auto& tag : recipe.getTags()) {
-            if (containsCaseInsensitive(tag, searchTerm)) {
-                results.push_back(recipe);
-                goto next_recipe;  // Found in tags, move to next recipe
+    std::vector<Search::RecipeSearchHit> results;
+    results.reserve(ordered.size());
+    for (const auto& [position, hit] : ordered) {
+        auto recipe = recipeAt(position);
+        if (!recipe) {
+            continue;
+        }
+        // Index fields are laid out as name, ingredient names, tags.
+        const size_t ingredientCount = recipe->getIngredients().size();
+        std::vector<Search::MatchSpan> matches;
+        matches.reserve(hit->matches.size());
+        for (const auto& match : hit->matches) {
+            Search::MatchSpan span{Search::MatchField::Name, 0, match.offset,
+                                   searchTerm.size()};
+            if (match.fieldIndex > ingredientCount) {
+                span.field = Search::MatchField::Tag;
+                span.fieldIndex = match.fieldIndex - 1 - ingredientCount;
+            } else if (match.fieldIndex > 0) {
+                span.field = Search::MatchField::Ingredient;
+                span.fieldIndex = match.fieldIndex - 1;
             }
+            matches.push_back(span);
         }
-    next_recipe:;  // Label for goto
+        results.push_back({std::move(*recipe), std::move(matches)});
     }
     return results;
 }
 
+void RecipeEncyclopediaManager::rebuildIdIndex() {
+    std::vector<int> ids;
+    ids.reserve(encyclopediaRecipes.size());
+    for (const auto& recipe : encyclopediaRecipes) {
+        ids.push_back(recipe.getRecipeId());
+    }
+    idIndex.build(ids);
+}
+
 std::optional<RecipeApp::Recipe> RecipeEncyclopediaManager::getRecipeById(
     int recipeId) const {
-    for (const auto& recipe : encyclopediaRecipes) {
-        if (recipe.getRecipeId() == recipeId) {
-            return recipe;
-        }
+    size_t position = idIndex.find(recipeId);
+    if (position == Search::IdPositionIndex::npos) {
+        return std::nullopt;  // Return empty optional if not found
     }
-    return std::nullopt;  // Return empty optional if not found
+    return recipeAt(position);
 }
 
 }  // namespace Encyclopedia
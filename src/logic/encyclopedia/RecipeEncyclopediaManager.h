@@ -2,12 +2,22 @@
 #define RECIPE_ENCYCLOPEDIA_MANAGER_H
 
 #include <memory>  // For std::unique_ptr if needed, or just raw pointers for now
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <optional> // For std::optional
 
 #include "../../domain/recipe/Recipe.h"  // Assuming Recipe.h is in domain/recipe
 #include "../../../include/json.hpp"     // For nlohmann::json (Corrected relative path)
+#include "../../persistence/EncyclopediaBundle.h"
+#include "../../persistence/JsonRecordScanner.h"
+#include "../../persistence/MappedFile.h"
+#include "../search/IdPositionIndex.h"
+#include "../search/NGramIndex.h"
+#include "../search/SearchMatch.h"
+#include "DecodedRecipeCache.h"
 
 // Forward declaration if RecipeRepository is used, though for encyclopedia it
 // might be simpler namespace RecipeApp { namespace Domain { namespace Recipe {
@@ -19,25 +29,148 @@ namespace Encyclopedia {
 
 class RecipeEncyclopediaManager {
    public:
+    enum class LoadMode {
+        Eager,     ///< Every recipe parsed into memory (loadRecipes)
+        LazyJson,  ///< JSON mapped, recipes decoded on demand (loadRecipesLazy)
+        Bundle     ///< Prebuilt binary bundle (loadBundle)
+    };
+
     RecipeEncyclopediaManager();
     ~RecipeEncyclopediaManager();
 
     /**
-     * @brief Loads recipes from a JSON file.
+     * @brief Loads recipes from a JSON file. Files ending in .ndjson or
+     *        .jsonl are read as one recipe per line; a corrupt line is
+     *        skipped instead of failing the load.
      * @param filepath Path to the JSON file.
      * @return True if loading was successful, false otherwise.
      */
     bool loadRecipes(const std::string& filepath);
 
     /**
-     * @brief Gets all recipes from the encyclopedia.
+     * @brief Loads recipes like loadRecipes, but splits the file at record
+     *        boundaries (array elements or NDJSON lines) and parses the
+     *        chunks on a pool of worker threads. Results keep the file order.
+     * @param filepath Path to the JSON or NDJSON file.
+     * @param threadCount Number of workers; 0 uses the hardware concurrency.
+     * @return True if loading was successful, false otherwise.
+     */
+    bool loadRecipesParallel(const std::string& filepath,
+                             unsigned threadCount = 0);
+
+    /**
+     * @brief Writes every recipe as NDJSON (one compact JSON object per line).
+     * @return True on success.
+     */
+    bool saveRecipesNdjson(const std::string& filepath) const;
+
+    static constexpr size_t kDefaultDecodedCacheCapacity = 128;
+
+    /**
+     * @brief Loads recipes lazily: the file is memory-mapped, each record's
+     *        byte range is recorded in an offset table and only the
+     *        searchable fields (id, name, ingredient names, tags) are parsed
+     *        and indexed. Full Recipe objects are decoded on demand and kept
+     *        in a small LRU cache. Accepts a JSON array or NDJSON.
+     * @param filepath Path to the JSON file.
+     * @param cacheCapacity Number of decoded recipes to keep (0 = unbounded).
+     * @return True if loading was successful, false otherwise.
+     */
+    bool loadRecipesLazy(const std::string& filepath,
+                         size_t cacheCapacity = kDefaultDecodedCacheCapacity);
+
+    /**
+     * @brief Loads a binary bundle produced by compileBundle. The search
+     *        and ID indexes are queried in place from the mapping and
+     *        recipes are decoded on demand, so loading costs a header check
+     *        and no per-record work.
+     * @param bundlePath Path to the bundle.
+     * @param sourceJsonPath JSON file the bundle was compiled from; if it
+     *        exists and differs from what was compiled, the bundle is stale
+     *        and rejected. May be empty to skip the check.
+     * @param cacheCapacity Number of decoded recipes to keep (0 = unbounded).
+     * @return False if the bundle is missing, stale or corrupt.
+     */
+    bool loadBundle(const std::string& bundlePath,
+                    const std::string& sourceJsonPath = "",
+                    size_t cacheCapacity = kDefaultDecodedCacheCapacity);
+
+    /// JSON files at least this large are loaded lazily by loadPreferringBundle.
+    static constexpr size_t kDefaultLazyThresholdBytes = 16u * 1024u * 1024u;
+
+    /**
+     * @brief Loads the bundle if it is present and up to date. Otherwise
+     *        loads the JSON file: with loadRecipesLazy when it is at least
+     *        lazyThresholdBytes large, with loadRecipesParallel below that.
+     * @param bundlePath May be empty to go straight to the JSON file.
+     */
+    bool loadPreferringBundle(
+        const std::string& bundlePath, const std::string& jsonPath,
+        size_t lazyThresholdBytes = kDefaultLazyThresholdBytes);
+
+    /**
+     * @brief Parses a JSON encyclopedia and writes it as a binary bundle
+     *        (string pool, recipe records and the prebuilt search index).
+     * @return True on success.
+     */
+    static bool compileBundle(const std::string& jsonPath,
+                              const std::string& bundlePath);
+
+    LoadMode getLoadMode() const { return loadMode; }
+
+    /**
+     * @brief Whether recipes are decoded on demand (lazy JSON or bundle).
+     */
+    bool isLazy() const { return loadMode != LoadMode::Eager; }
+
+    /**
+     * @brief Number of recipes in the encyclopedia, without decoding them.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Counts of what applyPatch() did.
+     */
+    struct PatchSummary {
+        size_t added = 0;
+        size_t replaced = 0;
+        size_t removed = 0;
+        size_t skipped = 0;  ///< Invalid operations or IDs in the wrong state
+    };
+
+    /**
+     * @brief Applies a delta file to the loaded encyclopedia without a full
+     *        reload. Operations run in file order:
+     *          {"op": "add",     "recipe": {...}}  new ID, appended
+     *          {"op": "replace", "recipe": {...}}  existing ID, kept in place
+     *          {"op": "remove",  "id": 1001}
+     *        The file is a JSON array of operations or NDJSON (one per line).
+     *        Only the touched recipes are re-indexed; the ID index is rebuilt
+     *        from the ID column (no recipe parsing) when recipes are added or
+     *        removed. In the lazy modes the mapped records are left alone:
+     *        patched recipes are kept in an overlay (recipes by ID plus
+     *        tombstones) that lookups consult before decoding a record.
+     *        Must not run concurrently with readers.
+     * @param patchPath Path to the patch file.
+     * @param summary Optional; receives the operation counts.
+     * @return False (with the encyclopedia unchanged) if the file cannot be
+     *         read or parsed. Individual invalid operations are skipped.
+     */
+    bool applyPatch(const std::string& patchPath,
+                    PatchSummary* summary = nullptr);
+
+    /**
+     * @brief Gets all recipes from the encyclopedia. In lazy mode this
+     *        decodes every record on the first call.
      * @return A const reference to the vector of recipes.
      */
     const std::vector<RecipeApp::Recipe>& getAllRecipes() const;
 
     /**
      * @brief Searches recipes in the encyclopedia based on a search term.
-     *        The search term can match recipe name, ingredients, or tags.
+     *        The search term can match recipe name, ingredients, or tags
+     *        (case-insensitive substring). Answered from an n-gram index
+     *        built by loadRecipes; results keep the file order.
      * @param searchTerm The string to search for.
      * @return A vector of recipes matching the search term.
      */
@@ -45,18 +178,90 @@ class RecipeEncyclopediaManager {
         const std::string& searchTerm) const;
 
     /**
-     * @brief Gets a specific recipe by its ID.
+     * @brief Same matching as searchRecipes(), but each result also carries
+     *        the field and byte range of every occurrence of the term, taken
+     *        from the index's verification pass.
+     * @param searchTerm The string to search for. An empty term returns
+     *        every recipe without matches.
+     */
+    std::vector<Search::RecipeSearchHit> searchRecipesWithMatches(
+        const std::string& searchTerm) const;
+
+    /**
+     * @brief Gets a specific recipe by its ID (constant-time lookup through
+     *        an ID -> position index built by loadRecipes).
      * @param recipeId The ID of the recipe to retrieve.
      * @return An std::optional<RecipeApp::Recipe> containing the recipe if found,
      *         otherwise an empty optional.
      */
     std::optional<RecipeApp::Recipe> getRecipeById(int recipeId) const;
 
+    /**
+     * @brief File positions (0 .. size() - 1) of the recipes matching
+     *        searchTerm, in file order, found through the index without
+     *        decoding any recipe. An empty term returns every position.
+     *        Positions stay valid until the next load or applyPatch().
+     */
+    std::vector<size_t> findRecipePositions(const std::string& searchTerm) const;
+
+    /**
+     * @brief The recipes at the given positions, in the given order;
+     *        out-of-range positions are skipped. Lazy modes decode only these
+     *        records and do not add them to the LRU cache, so streaming the
+     *        encyclopedia in batches never holds all of it in memory.
+     */
+    std::vector<RecipeApp::Recipe> getRecipesAtPositions(
+        const std::vector<size_t>& positions) const;
+
    private:
-    std::vector<RecipeApp::Recipe> encyclopediaRecipes;
-    // Helper method for case-insensitive string comparison if needed for search
-    bool containsCaseInsensitive(const std::string& text,
-                                 const std::string& searchTerm) const;
+    // Eager mode: every recipe. Lazy modes: filled by getAllRecipes() on
+    // first use, hence mutable.
+    mutable std::vector<RecipeApp::Recipe> encyclopediaRecipes;
+    // Searchable fields (name, ingredient names, tags) keyed by recipe ID, so
+    // entries survive the position shifts caused by patches.
+    Search::NGramIndex searchIndex;
+    // Recipe ID -> position in encyclopediaRecipes or the lazy record set
+    Search::IdPositionIndex idIndex;
+
+    LoadMode loadMode = LoadMode::Eager;
+    // LazyJson state
+    Persistence::MappedFile mappedFile;
+    std::vector<Persistence::RecordSpan> recordSpans;
+    // Bundle state
+    Persistence::EncyclopediaBundle bundle;
+    // LazyJson: ID of every mapped record (a bundle stores its own column)
+    std::vector<int> lazyRecordIds;
+    // Lazy modes: patches layered over the mapped records. Slots below
+    // mappedRecordCount() are mapped records, the rest index appendedIds.
+    std::unordered_map<int, RecipeApp::Recipe> overlayRecipes;  // Added or replaced
+    std::unordered_set<int> removedIds;  // Tombstones for mapped records
+    std::vector<int> appendedIds;        // Added recipes, in patch order
+    std::vector<size_t> overlaySlots;    // Position -> slot, once patched
+    bool overlayActive = false;
+    // Shared by the lazy modes
+    mutable DecodedRecipeCache decodedCache;
+    mutable bool allMaterialized = false;
+    mutable std::mutex lazyMutex;  // Guards decodedCache and materialization
+
+    void resetState();
+    bool loadRecipesNdjson(const std::string& filepath);
+    void rebuildSearchIndex();
+    void rebuildIdIndex();
+    void applyPatchToRecipes(const std::vector<nlohmann::json>& operations,
+                             const std::string& patchPath,
+                             PatchSummary& counts);
+    void applyPatchToOverlay(const std::vector<nlohmann::json>& operations,
+                             const std::string& patchPath,
+                             PatchSummary& counts);
+    void rebuildOverlaySlots();
+    static void logSkippedOperation(const std::string& patchPath, size_t index,
+                                    const std::string& reason);
+    size_t mappedRecordCount() const;
+    int mappedRecordId(size_t slot) const;
+    static std::vector<std::string> searchFieldsOf(const RecipeApp::Recipe& recipe);
+    std::vector<size_t> positionsInFileOrder(const std::vector<int>& ids) const;
+    std::optional<RecipeApp::Recipe> recipeAt(size_t position) const;
+    std::optional<RecipeApp::Recipe> decodeRecord(size_t position) const;
 };
 
 }  // namespace Encyclopedia
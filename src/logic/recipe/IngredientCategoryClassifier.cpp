@@ -0,0 +1,133 @@
+#include "IngredientCategoryClassifier.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+
+#include "spdlog/spdlog.h"
+
+namespace RecipeApp {
+
+namespace {
+std::string toLower(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    return s;
+}
+}  // namespace
+
+bool IngredientCategoryClassifier::loadFromFile(const std::string &filepath) {
+    std::ifstream file(filepath);
+    if (!file.is_open()) {
+        spdlog::warn("无法打开食材类别文件: {}", filepath);
+        return false;
+    }
+    try {
+        nlohmann::json categoriesJson;
+        file >> categoriesJson;
+        return loadFromJson(categoriesJson);
+    } catch (const nlohmann::json::exception &e) {
+        spdlog::error("解析食材类别文件 {} 失败: {}", filepath, e.what());
+        return false;
+    }
+}
+
+bool IngredientCategoryClassifier::loadFromJson(
+    const nlohmann::json &categoriesJson) {
+    if (!categoriesJson.is_object() || !categoriesJson.contains("categories") ||
+        !categoriesJson["categories"].is_array()) {
+        spdlog::error("食材类别数据格式无效: 缺少 'categories' 数组。");
+        return false;
+    }
+    const auto &entries = categoriesJson["categories"];
+    if (entries.size() > kMaxCategories) {
+        spdlog::error("食材类别数量 ({}) 超过上限 {}。", entries.size(),
+                      kMaxCategories);
+        return false;
+    }
+
+    std::vector<Category> categories;
+    std::unordered_map<std::string, std::size_t> lookup;
+    try {
+        for (const auto &entry : entries) {
+            Category category;
+            category.name = entry.at("name").get<std::string>();
+            if (category.name.empty()) {
+                spdlog::error("食材类别名称不能为空。");
+                return false;
+            }
+            for (const auto &keyword :
+                 entry.value("keywords", std::vector<std::string>{})) {
+                if (!keyword.empty()) {
+                    category.keywords.push_back(toLower(keyword));
+                }
+            }
+
+            std::size_t bit = categories.size();
+            if (!lookup.emplace(toLower(category.name), bit).second) {
+                spdlog::error("食材类别 '{}' 重复定义。", category.name);
+                return false;
+            }
+            for (const auto &alias :
+                 entry.value("aliases", std::vector<std::string>{})) {
+                lookup.emplace(toLower(alias), bit);
+            }
+            categories.push_back(std::move(category));
+        }
+    } catch (const nlohmann::json::exception &e) {
+        spdlog::error("食材类别条目格式无效: {}", e.what());
+        return false;
+    }
+
+    m_categories = std::move(categories);
+    m_lookup = std::move(lookup);
+    spdlog::info("已加载 {} 个食材类别。", m_categories.size());
+    return true;
+}
+
+CategoryMask IngredientCategoryClassifier::classify(
+    const std::string &ingredientName) const {
+    CategoryMask mask = 0;
+    if (m_categories.empty()) {
+        return mask;
+    }
+    std::string normalized = toLower(ingredientName);
+    for (std::size_t bit = 0; bit < m_categories.size(); ++bit) {
+        for (const auto &keyword : m_categories[bit].keywords) {
+            if (normalized.find(keyword) != std::string::npos) {
+                mask |= CategoryMask{1} << bit;
+                break;
+            }
+        }
+    }
+    return mask;
+}
+
+CategoryMask IngredientCategoryClassifier::classifyRecipe(
+    const Recipe &recipe) const {
+    CategoryMask mask = 0;
+    for (const auto &ingredient : recipe.getIngredients()) {
+        mask |= classify(ingredient.name);
+    }
+    return mask;
+}
+
+std::optional<CategoryMask> IngredientCategoryClassifier::categoryMask(
+    const std::string &category) const {
+    auto it = m_lookup.find(toLower(category));
+    if (it == m_lookup.end()) {
+        return std::nullopt;
+    }
+    return CategoryMask{1} << it->second;
+}
+
+std::vector<std::string> IngredientCategoryClassifier::categoryNames() const {
+    std::vector<std::string> names;
+    names.reserve(m_categories.size());
+    for (const auto &category : m_categories) {
+        names.push_back(category.name);
+    }
+    return names;
+}
+
+}  // namespace RecipeApp
@@ -0,0 +1,83 @@
+#ifndef INGREDIENT_CATEGORY_CLASSIFIER_H
+#define INGREDIENT_CATEGORY_CLASSIFIER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../../../include/json.hpp"
+#include "domain/recipe/Recipe.h"
+
+namespace RecipeApp {
+
+/// One bit per ingredient category (allergen, dietary group, ...).
+using CategoryMask = std::uint64_t;
+
+/**
+ * @brief 将食材名称归类到可配置的类别 (过敏原、忌口等)，每个类别占用一个比特位。
+ *
+ * 类别定义来自数据文件，格式如下:
+ * @code
+ * { "categories": [
+ *     { "name": "peanut", "aliases": ["花生"], "keywords": ["花生", "peanut"] }
+ * ] }
+ * @endcode
+ * 食材名称 (规范化为小写) 只要包含某个关键词即归入该类别。
+ */
+class IngredientCategoryClassifier {
+   public:
+    static constexpr std::size_t kMaxCategories = 64;
+
+    /**
+     * @brief 从 JSON 文件加载类别定义，替换当前定义
+     * @param filepath 数据文件路径
+     * @return 加载成功返回 true；失败时保留原有定义并返回 false
+     */
+    bool loadFromFile(const std::string &filepath);
+
+    /**
+     * @brief 从已解析的 JSON 加载类别定义，替换当前定义
+     * @param categoriesJson 含 "categories" 数组的 JSON 对象
+     * @return 加载成功返回 true；格式错误或类别超过 kMaxCategories 时返回 false
+     */
+    bool loadFromJson(const nlohmann::json &categoriesJson);
+
+    /**
+     * @brief 计算单个食材名称所属类别的位掩码
+     */
+    CategoryMask classify(const std::string &ingredientName) const;
+
+    /**
+     * @brief 计算菜谱所有食材所属类别的位掩码 (按位或)
+     */
+    CategoryMask classifyRecipe(const Recipe &recipe) const;
+
+    /**
+     * @brief 按类别名称或别名查找其位掩码 (大小写不敏感)
+     * @return 未知类别返回 std::nullopt
+     */
+    std::optional<CategoryMask> categoryMask(const std::string &category) const;
+
+    /**
+     * @brief 按定义顺序返回所有类别名称
+     */
+    std::vector<std::string> categoryNames() const;
+
+    bool empty() const { return m_categories.empty(); }
+
+   private:
+    struct Category {
+        std::string name;
+        std::vector<std::string> keywords;  ///< Normalized (lowercase)
+    };
+
+    std::vector<Category> m_categories;  ///< Index in vector == bit position
+    std::unordered_map<std::string, std::size_t> m_lookup;  ///< name/alias -> bit
+};
+
+}  // namespace RecipeApp
+
+#endif  // INGREDIENT_CATEGORY_CLASSIFIER_H
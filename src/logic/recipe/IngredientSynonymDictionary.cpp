@@ -0,0 +1,201 @@
+#include "IngredientSynonymDictionary.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <numeric>
+#include <unordered_map>
+
+#include "spdlog/spdlog.h"
+
+namespace RecipeApp {
+
+namespace {
+std::string toLower(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    return s;
+}
+
+// Seeded FNV-1a with a final avalanche step. Seed 0 selects the bucket,
+// the bucket's displacement selects the slot.
+std::uint64_t seededHash(std::string_view key, std::uint64_t seed) {
+    std::uint64_t h = 14695981039346656037ull ^ (seed * 0x9E3779B97F4A7C15ull);
+    for (unsigned char c : key) {
+        h ^= c;
+        h *= 1099511628211ull;
+    }
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    return h;
+}
+
+constexpr std::uint32_t kMaxDisplacementAttempts = 1u << 20;
+}  // namespace
+
+bool IngredientSynonymDictionary::loadFromFile(const std::string &filepath) {
+    std::ifstream file(filepath);
+    if (!file.is_open()) {
+        spdlog::warn("无法打开食材同义词文件: {}", filepath);
+        return false;
+    }
+    try {
+        nlohmann::json synonymsJson;
+        file >> synonymsJson;
+        return loadFromJson(synonymsJson);
+    } catch (const nlohmann::json::exception &e) {
+        spdlog::error("解析食材同义词文件 {} 失败: {}", filepath, e.what());
+        return false;
+    }
+}
+
+bool IngredientSynonymDictionary::loadFromJson(
+    const nlohmann::json &synonymsJson) {
+    if (!synonymsJson.is_object() || !synonymsJson.contains("synonyms") ||
+        !synonymsJson["synonyms"].is_array()) {
+        spdlog::error("食材同义词数据格式无效: 缺少 'synonyms' 数组。");
+        return false;
+    }
+
+    std::vector<std::string> keys;
+    std::vector<std::uint32_t> values;
+    std::vector<std::string> canonicals;
+    std::unordered_map<std::string, std::uint32_t> seen;  // alias -> canonical
+    try {
+        for (const auto &entry : synonymsJson["synonyms"]) {
+            std::string canonical =
+                toLower(entry.at("canonical").get<std::string>());
+            if (canonical.empty()) {
+                spdlog::error("食材同义词条目的 'canonical' 不能为空。");
+                return false;
+            }
+            auto canonicalIndex = static_cast<std::uint32_t>(canonicals.size());
+            canonicals.push_back(canonical);
+            for (const auto &aliasRaw :
+                 entry.value("aliases", std::vector<std::string>{})) {
+                std::string alias = toLower(aliasRaw);
+                if (alias.empty() || alias == canonical) {
+                    continue;
+                }
+                auto inserted = seen.emplace(alias, canonicalIndex);
+                if (!inserted.second) {
+                    if (canonicals[inserted.first->second] != canonical) {
+                        spdlog::warn(
+                            "食材别名 '{}' 同时映射到 '{}' 和 '{}'，保留前者。",
+                            alias, canonicals[inserted.first->second],
+                            canonical);
+                    }
+                    continue;
+                }
+                keys.push_back(alias);
+                values.push_back(canonicalIndex);
+            }
+        }
+    } catch (const nlohmann::json::exception &e) {
+        spdlog::error("食材同义词条目格式无效: {}", e.what());
+        return false;
+    }
+
+    IngredientSynonymDictionary compiled;
+    compiled.m_keys = std::move(keys);
+    compiled.m_values = std::move(values);
+    compiled.m_canonicals = std::move(canonicals);
+    if (!compiled.compile()) {
+        spdlog::error("无法为 {} 个食材别名构建完美哈希表。",
+                      compiled.m_keys.size());
+        return false;
+    }
+    *this = std::move(compiled);
+    spdlog::info("已加载 {} 个食材别名 ({} 个规范词条)。", m_keys.size(),
+                 m_canonicals.size());
+    return true;
+}
+
+bool IngredientSynonymDictionary::compile() {
+    m_displacements.clear();
+    m_slots.clear();
+    const std::size_t n = m_keys.size();
+    if (n == 0) {
+        return true;
+    }
+
+    // ~4 keys per bucket, table at ~80% load.
+    const std::size_t bucketCount = (n + 3) / 4;
+    const std::size_t tableSize = n + n / 4 + 1;
+
+    std::vector<std::vector<std::uint32_t>> buckets(bucketCount);
+    for (std::uint32_t i = 0; i < n; ++i) {
+        buckets[seededHash(m_keys[i], 0) % bucketCount].push_back(i);
+    }
+    std::vector<std::size_t> order(bucketCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&buckets](std::size_t a, std::size_t b) {
+                         return buckets[a].size() > buckets[b].size();
+                     });
+
+    m_displacements.assign(bucketCount, 0);
+    m_slots.assign(tableSize, -1);
+    std::vector<std::size_t> positions;
+    for (std::size_t b : order) {
+        const auto &bucket = buckets[b];
+        if (bucket.empty()) {
+            break;  // Sorted by size, the rest are empty too
+        }
+        bool placed = false;
+        for (std::uint32_t d = 1; d < kMaxDisplacementAttempts && !placed;
+             ++d) {
+            positions.clear();
+            placed = true;
+            for (std::uint32_t key : bucket) {
+                std::size_t pos = seededHash(m_keys[key], d) % tableSize;
+                if (m_slots[pos] != -1 ||
+                    std::find(positions.begin(), positions.end(), pos) !=
+                        positions.end()) {
+                    placed = false;
+                    break;
+                }
+                positions.push_back(pos);
+            }
+            if (placed) {
+                m_displacements[b] = d;
+                for (std::size_t k = 0; k < bucket.size(); ++k) {
+                    m_slots[positions[k]] =
+                        static_cast<std::int32_t>(bucket[k]);
+                }
+            }
+        }
+        if (!placed) {
+            m_displacements.clear();
+            m_slots.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+const std::string *IngredientSynonymDictionary::lookup(
+    std::string_view normalizedTerm) const {
+    if (m_keys.empty()) {
+        return nullptr;
+    }
+    std::uint32_t d =
+        m_displacements[seededHash(normalizedTerm, 0) % m_displacements.size()];
+    if (d == 0) {
+        return nullptr;  // Empty bucket
+    }
+    std::int32_t entry = m_slots[seededHash(normalizedTerm, d) % m_slots.size()];
+    if (entry < 0 || m_keys[entry] != normalizedTerm) {
+        return nullptr;
+    }
+    return &m_canonicals[m_values[entry]];
+}
+
+std::string IngredientSynonymDictionary::canonicalize(
+    const std::string &normalizedTerm) const {
+    const std::string *canonical = lookup(normalizedTerm);
+    return canonical ? *canonical : normalizedTerm;
+}
+
+}  // namespace RecipeApp
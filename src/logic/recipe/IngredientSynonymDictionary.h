@@ -0,0 +1,71 @@
+#ifndef INGREDIENT_SYNONYM_DICTIONARY_H
+#define INGREDIENT_SYNONYM_DICTIONARY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../../../include/json.hpp"
+
+namespace RecipeApp {
+
+/**
+ * @brief 食材同义词/别名词典，将 "鸡胸"、"green onion" 等别名规范化为同一个词条。
+ *
+ * 数据文件格式:
+ * @code
+ * { "synonyms": [
+ *     { "canonical": "鸡胸肉", "aliases": ["鸡胸", "chicken breast"] }
+ * ] }
+ * @endcode
+ * 所有词条均按小写存储。加载时别名表被编译为静态的最小冲突完美哈希
+ * (hash-and-displace)：每次查询只计算两次哈希并做一次字符串比较。
+ */
+class IngredientSynonymDictionary {
+   public:
+    /**
+     * @brief 从 JSON 文件加载词典，替换当前内容
+     * @param filepath 数据文件路径
+     * @return 加载成功返回 true；失败时保留原有内容并返回 false
+     */
+    bool loadFromFile(const std::string &filepath);
+
+    /**
+     * @brief 从已解析的 JSON 加载词典，替换当前内容
+     * @param synonymsJson 含 "synonyms" 数组的 JSON 对象
+     * @return 加载成功返回 true
+     */
+    bool loadFromJson(const nlohmann::json &synonymsJson);
+
+    /**
+     * @brief 查找别名对应的规范词条
+     * @param normalizedTerm 已规范化 (小写) 的食材名称
+     * @return 规范词条；如果不是已知别名则返回 nullptr
+     */
+    const std::string *lookup(std::string_view normalizedTerm) const;
+
+    /**
+     * @brief 返回规范词条；未知词条原样返回
+     */
+    std::string canonicalize(const std::string &normalizedTerm) const;
+
+    /// Number of alias entries (canonical terms are not counted).
+    std::size_t size() const { return m_keys.size(); }
+    bool empty() const { return m_keys.empty(); }
+
+   private:
+    // Compiled perfect hash: bucket -> displacement, slot -> entry index.
+    std::vector<std::uint32_t> m_displacements;
+    std::vector<std::int32_t> m_slots;
+    std::vector<std::string> m_keys;            ///< Alias per entry
+    std::vector<std::uint32_t> m_values;        ///< Entry -> canonical index
+    std::vector<std::string> m_canonicals;
+
+    bool compile();
+};
+
+}  // namespace RecipeApp
+
+#endif  // INGREDIENT_SYNONYM_DICTIONARY_H
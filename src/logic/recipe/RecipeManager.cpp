@@ -10,6 +10,7 @@
 // They will be fully replaced by the new exception types.
 #include <optional>
 #include <set>  // Required for index value type
+#include <unordered_set>
 #include <vector>
 
 #include "../../cli/ExitCodes.h"         // Include ExitCodes for exceptions
@@ -23,7 +24,18 @@ using RecipeApp::Domain::Recipe::RecipeRepository;
 namespace RecipeApp {
 
 RecipeManager::RecipeManager(RecipeRepository &recipeRepository)
+    : RecipeManager(recipeRepository, IngredientDataFiles{}) {}
+
+RecipeManager::RecipeManager(RecipeRepository &recipeRepository,
+                             const IngredientDataFiles &ingredientData)
     : recipeRepository_(recipeRepository) {
+    // Index keys and masks depend on this data, so load it before indexing.
+    if (!ingredientData.synonymsPath.empty()) {
+        m_synonyms.loadFromFile(ingredientData.synonymsPath);
+    }
+    if (!ingredientData.categoriesPath.empty()) {
+        m_categoryClassifier.loadFromFile(ingredientData.categoriesPath);
+    }
     buildInitialIndexes();  // Build indexes on construction
 }
 
@@ -35,10 +47,25 @@ std::string RecipeManager::normalizeString(const std::string &str) const {
     return lower_str;
 }
 
+// Ingredient key used by m_ingredientIndex: normalized, then folded to the
+// canonical term if it is a known alias.
+std::string RecipeManager::normalizeIngredient(const std::string &name) const {
+    std::string normalized = normalizeString(name);
+    const std::string *canonical = m_synonyms.lookup(normalized);
+    return canonical ? *canonical : normalized;
+}
+
 void RecipeManager::buildInitialIndexes() {
     m_nameIndex.clear();
     m_ingredientIndex.clear();
     m_tagIndex.clear();
+    m_difficultyIndex.clear();
+    for (auto &bucket : m_cookingTimeIndex) {
+        bucket.clear();
+    }
+    m_stepIndex.clear();
+    m_maskColumnIds.clear();
+    m_maskColumn.clear();
 
     std::vector<Recipe> allRecipes = recipeRepository_.findAll();
     for (const auto &recipe : allRecipes) {
@@ -54,13 +81,33 @@ void RecipeManager::addRecipeToIndex(const Recipe &recipe) {
 
     // Index by ingredients
     for (const auto &ingredient : recipe.getIngredients()) {
-        m_ingredientIndex[normalizeString(ingredient.name)].insert(recipeId);
+        m_ingredientIndex[normalizeIngredient(ingredient.name)].insert(recipeId);
     }
 
     // Index by tags
     for (const auto &tag : recipe.getTags()) {
         m_tagIndex[normalizeString(tag)].insert(recipeId);
     }
+
+    // Facet postings
+    m_difficultyIndex[recipe.getDifficulty()].insert(recipeId);
+    m_cookingTimeIndex[cookingTimeBucket(recipe.getCookingTime())].insert(
+        recipeId);
+
+    // Full-text index over steps
+    m_stepIndex.addDocument(recipeId, recipe.getSteps());
+
+    // Ingredient category mask column (kept sorted by ID)
+    CategoryMask mask = m_categoryClassifier.classifyRecipe(recipe);
+    auto pos = std::lower_bound(m_maskColumnIds.begin(), m_maskColumnIds.end(),
+                                recipeId);
+    auto offset = pos - m_maskColumnIds.begin();
+    if (pos != m_maskColumnIds.end() && *pos == recipeId) {
+        m_maskColumn[offset] = mask;
+    } else {
+        m_maskColumnIds.insert(pos, recipeId);
+        m_maskColumn.insert(m_maskColumn.begin() + offset, mask);
+    }
 }
 
 void RecipeManager::removeRecipeFromIndex(const Recipe &recipe) {
@@ -77,7 +124,7 @@ void RecipeManager::removeRecipeFromIndex(const Recipe &recipe) {
 
     // Remove from ingredient index
     for (const auto &ingredient : recipe.getIngredients()) {
-        auto ingIt = m_ingredientIndex.find(normalizeString(ingredient.name));
+        auto ingIt = m_ingredientIndex.find(normalizeIngredient(ingredient.name));
         if (ingIt != m_ingredientIndex.end()) {
             ingIt->second.erase(recipeId);
             if (ingIt->second.empty()) {
@@ -96,6 +143,28 @@ void RecipeManager::removeRecipeFromIndex(const Recipe &recipe) {
             }
         }
     }
+
+    // Remove from facet postings
+    auto diffIt = m_difficultyIndex.find(recipe.getDifficulty());
+    if (diffIt != m_difficultyIndex.end()) {
+        diffIt->second.erase(recipeId);
+        if (diffIt->second.empty()) {
+            m_difficultyIndex.erase(diffIt);
+        }
+    }
+    m_cookingTimeIndex[cookingTimeBucket(recipe.getCookingTime())].erase(
+        recipeId);
+
+    m_stepIndex.removeDocument(recipeId);
+
+    // Remove from ingredient category mask column
+    auto pos = std::lower_bound(m_maskColumnIds.begin(), m_maskColumnIds.end(),
+                                recipeId);
+    if (pos != m_maskColumnIds.end() && *pos == recipeId) {
+        m_maskColumn.erase(m_maskColumn.begin() +
+                           (pos - m_maskColumnIds.begin()));
+        m_maskColumnIds.erase(pos);
+    }
 }
 
 void RecipeManager::updateRecipeInIndex(const Recipe &oldRecipe,
@@ -171,9 +240,72 @@ int RecipeManager::addRecipe(const Recipe &recipe_param) {
     }
 }
 
+RecipeImportResult RecipeManager::importRecipes(
+    const std::vector<Recipe> &recipes) {
+    RecipeImportResult result;
+    spdlog::info("尝试批量导入 {} 个菜谱", recipes.size());
+
+    // 1. One pass over the batch: drop names already in m_nameIndex or taken
+    // by an earlier recipe of the same batch.
+    std::unordered_set<std::string> batchNames;
+    std::vector<Recipe> accepted;
+    accepted.reserve(recipes.size());
+    for (const auto &recipe : recipes) {
+        std::string normalized_name = normalizeString(recipe.getName());
+        auto existing = m_nameIndex.find(normalized_name);
+        if ((existing != m_nameIndex.end() && !existing->second.empty()) ||
+            !batchNames.insert(normalized_name).second) {
+            result.skippedNames.push_back(recipe.getName());
+            continue;
+        }
+        accepted.push_back(recipe);
+    }
+    if (!result.skippedNames.empty()) {
+        spdlog::warn("批量导入时跳过 {} 个名称冲突的菜谱。", result.skippedNames.size());
+    }
+    if (accepted.empty()) {
+        return result;
+    }
+
+    // 2. Assign IDs and persist once; the repository hands back the stored
+    // recipes, so they can be indexed without a findById per recipe.
+    std::vector<Recipe> saved;
+    try {
+        saved = recipeRepository_.saveMany(accepted);
+    } catch (const RecipeApp::Common::Exceptions::PersistenceException &) {
+        throw;
+    } catch (const std::exception &e) {
+        throw RecipeApp::Common::Exceptions::PersistenceException(
+            "批量导入菜谱失败: " + std::string(e.what()));
+    }
+    if (saved.size() != accepted.size()) {
+        spdlog::error("批量导入 {} 个菜谱时持久化失败。", accepted.size());
+        throw RecipeApp::Common::Exceptions::PersistenceException(
+            "批量导入菜谱失败: 无法保存到仓库。");
+    }
+
+    result.importedIds.reserve(saved.size());
+    for (const auto &recipe : saved) {
+        addRecipeToIndex(recipe);
+        result.importedIds.push_back(recipe.getRecipeId());
+    }
+    spdlog::info("批量导入完成: 导入 {} 个，跳过 {} 个。", result.importedIds.size(),
+                 result.skippedNames.size());
+    return result;
+}
+
 // findRecipeByName now uses the m_nameIndex
 std::vector<Recipe> RecipeManager::findRecipeByName(const std::string &name,
                                                     bool partialMatch) const {
+    std::vector<int> ids_vec = findRecipeIdsByName(name, partialMatch);
+    if (ids_vec.empty()) {
+        return {};
+    }
+    return recipeRepository_.findManyByIds(ids_vec);
+}
+
+std::vector<int> RecipeManager::findRecipeIdsByName(const std::string &name,
+                                                    bool partialMatch) const {
     std::string normalized_query = normalizeString(name);
     std::set<int> matched_ids;
 
@@ -190,12 +322,67 @@ std::vector<Recipe> RecipeManager::findRecipeByName(const std::string &name,
             }
         }
     }
+    return std::vector<int>(matched_ids.begin(), matched_ids.end());
+}
 
-    if (matched_ids.empty()) {
-        return {};
+std::vector<Logic::Search::RecipeSearchHit>
+RecipeManager::findRecipeByNameWithMatches(const std::string &name,
+                                           bool partialMatch) const {
+    // Index keys are ASCII-lowercased names, so byte offsets found in a key
+    // are valid in the original name.
+    std::string normalized_query = normalizeString(name);
+    std::map<int, std::vector<std::size_t>> offsets_by_id;
+
+    auto collect = [&](const std::set<int> &ids, const std::string &key) {
+        std::vector<std::size_t> offsets;
+        if (!normalized_query.empty()) {
+            for (std::size_t pos = key.find(normalized_query);
+                 pos != std::string::npos;
+                 pos = key.find(normalized_query, pos + normalized_query.size())) {
+                offsets.push_back(pos);
+            }
+        }
+        for (int id : ids) {
+            offsets_by_id[id] = offsets;
+        }
+    };
+
+    if (!partialMatch) {
+        auto it = m_nameIndex.find(normalized_query);
+        if (it != m_nameIndex.end()) {
+            collect(it->second, it->first);
+        }
+    } else {
+        for (const auto &pair : m_nameIndex) {
+            if (pair.first.find(normalized_query) != std::string::npos) {
+                collect(pair.second, pair.first);
+            }
+        }
     }
-    std::vector<int> ids_vec(matched_ids.begin(), matched_ids.end());
-    return recipeRepository_.findManyByIds(ids_vec);
+
+    std::vector<Logic::Search::RecipeSearchHit> hits;
+    if (offsets_by_id.empty()) {
+        return hits;
+    }
+    std::vector<int> ids_vec;
+    ids_vec.reserve(offsets_by_id.size());
+    for (const auto &entry : offsets_by_id) {
+        ids_vec.push_back(entry.first);
+    }
+    for (auto &recipe : recipeRepository_.findManyByIds(ids_vec)) {
+        auto offsetsIt = offsets_by_id.find(recipe.getRecipeId());
+        if (offsetsIt == offsets_by_id.end()) {
+            continue;
+        }
+        std::vector<Logic::Search::MatchSpan> matches;
+        matches.reserve(offsetsIt->second.size());
+        for (std::size_t offset : offsetsIt->second) {
+            matches.push_back({Logic::Search::MatchField::Name, 0, offset,
+                               normalized_query.size()});
+        }
+        hits.push_back({std::move(recipe), std::move(matches)});
+    }
+    return hits;
 }
 
 bool RecipeManager::deleteRecipe(int recipeId) {
@@ -204,6 +391,9 @@ bool RecipeManager::deleteRecipe(int recipeId) {
     if (recipeToDeleteOpt.has_value()) {
         if (recipeRepository_.remove(recipeId)) {
             removeRecipeFromIndex(recipeToDeleteOpt.value());
+            for (const auto &listener : m_deletedListeners) {
+                listener(recipeId);
+            }
             return true;
         }
     }
@@ -244,6 +434,9 @@ bool RecipeManager::updateRecipe(const Recipe &updated_recipe_param) {
         // existingRecipe is the state *before* the update.
         // updated_recipe_param is the state *after* the update.
         updateRecipeInIndex(existingRecipe, updated_recipe_param);
+        for (const auto &listener : m_updatedListeners) {
+            listener(updated_recipe_param);
+        }
         return true;
     }
     return false;
@@ -293,7 +486,7 @@ std::vector<Recipe> RecipeManager::findRecipesByIngredients(
 
     std::vector<std::set<int>> id_sets;
     for (const auto &ing_name : ingredientsToFind) {
-        std::string normalized_ing = normalizeString(ing_name);
+        std::string normalized_ing = normalizeIngredient(ing_name);
         auto it = m_ingredientIndex.find(normalized_ing);
         if (it != m_ingredientIndex.end() && !it->second.empty()) {
             id_sets.push_back(it->second);
@@ -361,6 +554,30 @@ std::vector<Recipe> RecipeManager::findRecipesByTag(
     return {};
 }
 
+std::vector<int> RecipeManager::getAllRecipeIds() const {
+    return m_maskColumnIds;  // Holds every indexed recipe, sorted by ID
+}
+
+void RecipeManager::addRecipeDeletedListener(RecipeDeletedListener listener) {
+    m_deletedListeners.push_back(std::move(listener));
+}
+
+void RecipeManager::addRecipeUpdatedListener(RecipeUpdatedListener listener) {
+    m_updatedListeners.push_back(std::move(listener));
+}
+
+std::vector<int> RecipeManager::findRecipeIdsByTag(
+    const std::string &tag) const {
+    if (tag.empty()) {
+        return {};
+    }
+    auto it = m_tagIndex.find(normalizeString(tag));
+    if (it == m_tagIndex.end()) {
+        return {};
+    }
+    return std::vector<int>(it->second.begin(), it->second.end());
+}
+
 std::vector<Recipe> RecipeManager::findRecipesByTags(
     const std::vector<std::string> &tagsToFind, bool matchAll) const {
     if (tagsToFind.empty()) {
@@ -420,6 +637,178 @@ std::vector<Recipe> RecipeManager::findRecipesByIds(
     return recipeRepository_.findManyByIds(ids);
 }
 
+// --- Ingredient Category (Exclusion Filter) Methods ---
+
+bool RecipeManager::loadIngredientSynonyms(const std::string &filepath) {
+    if (!m_synonyms.loadFromFile(filepath)) {
+        return false;
+    }
+    // Index keys depend on the dictionary, so rebuild with canonical terms.
+    buildInitialIndexes();
+    return true;
+}
+
+bool RecipeManager::loadIngredientCategories(const std::string &filepath) {
+    if (!m_categoryClassifier.loadFromFile(filepath)) {
+        return false;
+    }
+    // Masks depend on the category definitions, so recompute them all.
+    buildInitialIndexes();
+    return true;
+}
+
+std::vector<std::string> RecipeManager::getIngredientCategoryNames() const {
+    return m_categoryClassifier.categoryNames();
+}
+
+CategoryMask RecipeManager::resolveCategoryMask(
+    const std::vector<std::string> &categories) const {
+    CategoryMask excluded = 0;
+    for (const auto &category : categories) {
+        std::optional<CategoryMask> bit =
+            m_categoryClassifier.categoryMask(category);
+        if (!bit.has_value()) {
+            spdlog::warn("未知的食材类别: '{}'", category);
+            throw RecipeApp::Common::Exceptions::ValidationException(
+                "未知的食材类别: '" + category + "'");
+        }
+        excluded |= bit.value();
+    }
+    return excluded;
+}
+
+std::vector<int> RecipeManager::findRecipeIdsExcludingCategories(
+    const std::vector<std::string> &categories) const {
+    CategoryMask excluded = resolveCategoryMask(categories);
+    std::vector<int> result;
+    result.reserve(m_maskColumnIds.size());
+    for (size_t i = 0; i < m_maskColumn.size(); ++i) {
+        if ((m_maskColumn[i] & excluded) == 0) {
+            result.push_back(m_maskColumnIds[i]);
+        }
+    }
+    return result;
+}
+
+std::vector<int> RecipeManager::filterRecipeIdsExcludingCategories(
+    const std::vector<int> &recipeIds,
+    const std::vector<std::string> &categories) const {
+    CategoryMask excluded = resolveCategoryMask(categories);
+    std::vector<int> result;
+    result.reserve(recipeIds.size());
+    for (int id : recipeIds) {
+        auto pos = std::lower_bound(m_maskColumnIds.begin(),
+                                    m_maskColumnIds.end(), id);
+        if (pos != m_maskColumnIds.end() && *pos == id &&
+            (m_maskColumn[pos - m_maskColumnIds.begin()] & excluded) == 0) {
+            result.push_back(id);
+        }
+    }
+    return result;
+}
+
+std::vector<Recipe> RecipeManager::findRecipesExcludingCategories(
+    const std::vector<std::string> &categories) const {
+    std::vector<int> ids = findRecipeIdsExcludingCategories(categories);
+    if (ids.empty()) {
+        return {};
+    }
+    return recipeRepository_.findManyByIds(ids);
+}
+
+// --- Step Full-Text Search ---
+
+std::vector<int> RecipeManager::findRecipeIdsByStepText(const std::string &text,
+                                                        bool phrase) const {
+    return phrase ? m_stepIndex.searchPhrase(text)
+                  : m_stepIndex.searchAllTerms(text);
+}
+
+std::vector<Recipe> RecipeManager::findRecipesByStepText(
+    const std::string &text, bool phrase) const {
+    std::vector<int> ids = findRecipeIdsByStepText(text, phrase);
+    if (ids.empty()) {
+        return {};
+    }
+    return recipeRepository_.findManyByIds(ids);
+}
+
+// --- Facet Aggregation ---
+
+namespace {
+// Size of the intersection between a sorted, de-duplicated ID vector and a
+// posting set. Iterates the smaller side and probes the larger one.
+std::size_t intersectionCardinality(const std::vector<int> &sortedIds,
+                                    const std::set<int> &postings) {
+    std::size_t count = 0;
+    if (postings.size() < sortedIds.size()) {
+        for (int id : postings) {
+            if (std::binary_search(sortedIds.begin(), sortedIds.end(), id)) {
+                ++count;
+            }
+        }
+    } else {
+        for (int id : sortedIds) {
+            count += postings.count(id);
+        }
+    }
+    return count;
+}
+}  // namespace
+
+std::size_t RecipeManager::cookingTimeBucket(int cookingTime) {
+    if (cookingTime <= 15) return 0;
+    if (cookingTime <= 30) return 1;
+    if (cookingTime <= 60) return 2;
+    return 3;
+}
+
+const std::array<std::string, RecipeManager::kCookingTimeBucketCount>
+    &RecipeManager::cookingTimeBucketLabels() {
+    static const std::array<std::string, kCookingTimeBucketCount> labels = {
+        "≤15分钟", "16-30分钟", "31-60分钟", ">60分钟"};
+    return labels;
+}
+
+RecipeFacets RecipeManager::computeFacets(
+    const std::vector<int> &recipeIds) const {
+    std::vector<int> ids = recipeIds;
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+
+    RecipeFacets facets;
+    for (Difficulty difficulty :
+         {Difficulty::Easy, Difficulty::Medium, Difficulty::Hard}) {
+        auto it = m_difficultyIndex.find(difficulty);
+        facets.difficultyCounts[difficulty] =
+            it == m_difficultyIndex.end()
+                ? 0
+                : intersectionCardinality(ids, it->second);
+    }
+
+    const auto &labels = cookingTimeBucketLabels();
+    for (std::size_t i = 0; i < kCookingTimeBucketCount; ++i) {
+        facets.cookingTimeCounts.emplace_back(
+            labels[i], intersectionCardinality(ids, m_cookingTimeIndex[i]));
+    }
+
+    if (ids.empty()) {
+        return facets;
+    }
+    for (const auto &pair : m_tagIndex) {
+        std::size_t count = intersectionCardinality(ids, pair.second);
+        if (count > 0) {
+            facets.tagCounts.emplace_back(pair.first, count);
+        }
+    }
+    std::sort(facets.tagCounts.begin(), facets.tagCounts.end(),
+              [](const auto &a, const auto &b) {
+                  return a.second != b.second ? a.second > b.second
+                                              : a.first < b.first;
+              });
+    return facets;
+}
+
 }  // namespace RecipeApp
 
 // Add new method implementations at the end of the file, before the closing
@@ -1,6 +1,10 @@
 #ifndef RECIPE_MANAGER_H
 #define RECIPE_MANAGER_H
 
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <map>
 #include <optional>  // For handling optional Recipe from repository
 #include <set>
 #include <string>
@@ -9,6 +13,10 @@
 
 #include "domain/recipe/Recipe.h"
 #include "domain/recipe/RecipeRepository.h"  // Added RecipeRepository include
+#include "logic/recipe/IngredientCategoryClassifier.h"
+#include "logic/recipe/IngredientSynonymDictionary.h"
+#include "logic/search/FullTextIndex.h"
+#include "logic/search/SearchMatch.h"
 
 // Forward declaration for Recipe class if not fully included by
 // RecipeRepository.h namespace RecipeApp { namespace Domain { namespace Recipe
@@ -20,7 +28,45 @@ namespace RecipeApp {
 // Recipe; } } using Domain::Recipe::Recipe; However, Recipe.h is already
 // included, so direct use of Recipe should be fine.
 
+/**
+ * @brief 一组菜谱结果的分面统计 (用于在搜索结果旁显示 "川菜 (132)" 等计数)
+ */
+struct RecipeFacets {
+    /// (规范化标签, 数量)，按数量降序、标签升序排列，不含计数为 0 的标签
+    std::vector<std::pair<std::string, std::size_t>> tagCounts;
+    /// 各难度的数量，键覆盖所有难度
+    std::map<Difficulty, std::size_t> difficultyCounts;
+    /// (烹饪时长分桶标签, 数量)，按 RecipeManager::cookingTimeBucketLabels() 的顺序
+    std::vector<std::pair<std::string, std::size_t>> cookingTimeCounts;
+};
+
+/**
+ * @brief 批量导入的结果
+ */
+struct RecipeImportResult {
+    /// 新分配的菜谱 ID，与成功导入的菜谱一一对应 (保持输入顺序)
+    std::vector<int> importedIds;
+    /// 因名称与已有菜谱或本批次中更早的菜谱冲突而跳过的菜谱名称
+    std::vector<std::string> skippedNames;
+};
+
+/**
+ * @brief 构造时加载的食材数据文件 (路径为空表示不加载)
+ */
+struct IngredientDataFiles {
+    std::string synonymsPath;    ///< 同义词词典 (见 IngredientSynonymDictionary)
+    std::string categoriesPath;  ///< 类别定义 (见 IngredientCategoryClassifier)
+};
+
 class RecipeManager {
+   public:
+    static constexpr std::size_t kCookingTimeBucketCount = 4;
+
+    /// 菜谱删除后的回调，参数为被删除的菜谱 ID
+    using RecipeDeletedListener = std::function<void(int recipeId)>;
+    /// 菜谱更新后的回调，参数为更新后的菜谱
+    using RecipeUpdatedListener = std::function<void(const Recipe &recipe)>;
+
    private:
     Domain::Recipe::RecipeRepository
         &recipeRepository_;  ///< Reference to the recipe repository
@@ -29,6 +75,23 @@ class RecipeManager {
     std::unordered_map<std::string, std::set<int>> m_nameIndex;
     std::unordered_map<std::string, std::set<int>> m_ingredientIndex;
     std::unordered_map<std::string, std::set<int>> m_tagIndex;
+    std::map<Difficulty, std::set<int>> m_difficultyIndex;
+    std::array<std::set<int>, kCookingTimeBucketCount> m_cookingTimeIndex;
+    Logic::Search::FullTextIndex m_stepIndex;  ///< Positional index of steps
+
+    // Ingredient aliases are folded to a canonical term before they reach
+    // m_ingredientIndex, both when indexing and when querying.
+    IngredientSynonymDictionary m_synonyms;
+
+    // Ingredient category (allergen) classification, computed once per recipe
+    // at index time. Stored as two parallel columns sorted by recipe ID so
+    // exclusion filters are a linear scan over packed masks.
+    IngredientCategoryClassifier m_categoryClassifier;
+    std::vector<int> m_maskColumnIds;
+    std::vector<CategoryMask> m_maskColumn;
+
+    std::vector<RecipeDeletedListener> m_deletedListeners;
+    std::vector<RecipeUpdatedListener> m_updatedListeners;
 
     // Private helper methods for index management
     void buildInitialIndexes();
@@ -37,6 +100,10 @@ class RecipeManager {
     void updateRecipeInIndex(const Recipe &oldRecipe, const Recipe &newRecipe);
     std::string normalizeString(
         const std::string &str) const;  // For consistent indexing/searching
+    std::string normalizeIngredient(const std::string &name) const;
+    static std::size_t cookingTimeBucket(int cookingTime);
+    CategoryMask resolveCategoryMask(
+        const std::vector<std::string> &categories) const;
 
    public:
     /**
@@ -45,6 +112,16 @@ class RecipeManager {
      */
     explicit RecipeManager(Domain::Recipe::RecipeRepository &recipeRepository);
 
+    /**
+     * @brief 构造函数，先加载食材同义词与类别数据，再一次性建立索引
+     *        (避免构造后再调用 loadIngredient* 造成的重复重建)
+     * @param recipeRepository 菜谱仓储的引用
+     * @param ingredientData 食材数据文件；加载失败的文件被跳过，可通过
+     *        hasIngredientSynonyms()/hasIngredientCategories() 检查
+     */
+    RecipeManager(Domain::Recipe::RecipeRepository &recipeRepository,
+                  const IngredientDataFiles &ingredientData);
+
     /**
      * @brief 默认析构函数
      */
@@ -57,6 +134,17 @@ class RecipeManager {
      */
     int addRecipe(const Recipe &recipe_param);
 
+    /**
+     * @brief 批量添加菜谱 (例如从食谱大全导入)
+     *
+     * 名称冲突在一次索引遍历中检查，冲突的菜谱被跳过而不是中止整个导入；
+     * 其余菜谱通过 RecipeRepository::saveMany 一次性分配连续 ID 并只持久化一次。
+     * @param recipes 待导入的菜谱 (其 ID 会被忽略)
+     * @return 导入结果
+     * @throws PersistenceException 如果持久化失败 (此时不会导入任何菜谱)
+     */
+    RecipeImportResult importRecipes(const std::vector<Recipe> &recipes);
+
     /**
      * @brief 根据名称查找菜谱
      * @param name 菜谱名称
@@ -66,6 +154,26 @@ class RecipeManager {
     std::vector<Recipe> findRecipeByName(const std::string &name,
                                          bool partialMatch = false) const;
 
+    /**
+     * @brief 与 findRecipeByName 相同的匹配，只返回菜谱 ID (升序)，不加载菜谱对象
+     * @param name 菜谱名称或其片段
+     * @param partialMatch 是否部分匹配 (默认为 false)
+     * @return 匹配菜谱的 ID 列表
+     */
+    std::vector<int> findRecipeIdsByName(const std::string &name,
+                                         bool partialMatch = false) const;
+
+    /**
+     * @brief 与 findRecipeByName 相同的匹配，同时返回名称中每处匹配的 UTF-8 字节偏移
+     *
+     * 偏移在扫描名称索引时顺带得出，供界面直接高亮，无需再次扫描菜谱。
+     * @param name 菜谱名称或其片段
+     * @param partialMatch 是否部分匹配 (默认为 false)
+     * @return 匹配结果 (按 ID 升序)，空查询不附带匹配片段
+     */
+    std::vector<Logic::Search::RecipeSearchHit> findRecipeByNameWithMatches(
+        const std::string &name, bool partialMatch = false) const;
+
     /**
      * @brief 根据食材组合查找菜谱（包含所有，精确匹配）
      * @param ingredients 食材名称列表
@@ -125,6 +233,27 @@ class RecipeManager {
      */
     void setNextRecipeIdFromPersistence(int nextId);
 
+    /**
+     * @brief 获取所有菜谱的 ID (升序)，只查索引、不加载菜谱对象
+     */
+    std::vector<int> getAllRecipeIds() const;
+
+    /**
+     * @brief 注册菜谱删除监听器，在 deleteRecipe 成功后按注册顺序调用
+     *
+     * 用于级联清理引用该菜谱的数据 (例如餐馆的特色菜谱)。
+     * @param listener 回调函数
+     */
+    void addRecipeDeletedListener(RecipeDeletedListener listener);
+
+    /**
+     * @brief 注册菜谱更新监听器，在 updateRecipe 成功后按注册顺序调用
+     *
+     * 用于维护依赖菜谱字段的派生数据 (例如餐馆的菜单统计)。
+     * @param listener 回调函数
+     */
+    void addRecipeUpdatedListener(RecipeUpdatedListener listener);
+
     /**
      * @brief 根据单个标签查找食谱
      * @param tag 要搜索的标签
@@ -132,6 +261,13 @@ class RecipeManager {
      */
     std::vector<Recipe> findRecipesByTag(const std::string &tag) const;
 
+    /**
+     * @brief 根据单个标签查找菜谱 ID (升序)，只查索引、不加载菜谱对象
+     * @param tag 要搜索的标签 (不区分大小写)
+     * @return 带有该标签的菜谱 ID 列表
+     */
+    std::vector<int> findRecipeIdsByTag(const std::string &tag) const;
+
     /**
      * @brief 根据多个标签查找食谱
      * @param tags 要搜索的标签列表
@@ -142,6 +278,92 @@ class RecipeManager {
     std::vector<Recipe> findRecipesByTags(const std::vector<std::string> &tags,
                                           bool matchAll = true) const;
 
+    /**
+     * @brief 从数据文件加载食材同义词/别名词典，并以规范词条重建索引
+     * @param filepath 词典文件路径 (见 IngredientSynonymDictionary)
+     * @return 加载成功返回 true；失败时保留原有词典
+     */
+    bool loadIngredientSynonyms(const std::string &filepath);
+
+    /**
+     * @brief 从数据文件加载食材类别 (过敏原、忌口等) 定义，并重新计算所有菜谱的类别掩码
+     * @param filepath 类别定义文件路径 (见 IngredientCategoryClassifier)
+     * @return 加载成功返回 true；失败时保留原有类别定义
+     */
+    bool loadIngredientCategories(const std::string &filepath);
+
+    bool hasIngredientSynonyms() const { return !m_synonyms.empty(); }
+    bool hasIngredientCategories() const {
+        return !m_categoryClassifier.empty();
+    }
+
+    /**
+     * @brief 获取当前已配置的食材类别名称
+     */
+    std::vector<std::string> getIngredientCategoryNames() const;
+
+    /**
+     * @brief 查找不含任何指定类别食材的菜谱 ID (升序)
+     * @param categories 要排除的类别名称或别名
+     * @return 匹配的菜谱 ID 列表
+     * @throws ValidationException 如果包含未知类别
+     */
+    std::vector<int> findRecipeIdsExcludingCategories(
+        const std::vector<std::string> &categories) const;
+
+    /**
+     * @brief 从给定的菜谱 ID 中过滤掉含有指定类别食材的菜谱，保持输入顺序
+     * @param recipeIds 待过滤的菜谱 ID
+     * @param categories 要排除的类别名称或别名
+     * @return 过滤后的菜谱 ID 列表 (未被索引的 ID 会被丢弃)
+     * @throws ValidationException 如果包含未知类别
+     */
+    std::vector<int> filterRecipeIdsExcludingCategories(
+        const std::vector<int> &recipeIds,
+        const std::vector<std::string> &categories) const;
+
+    /**
+     * @brief 查找不含任何指定类别食材的菜谱
+     * @param categories 要排除的类别名称或别名
+     * @return 匹配的菜谱列表
+     * @throws ValidationException 如果包含未知类别
+     */
+    std::vector<Recipe> findRecipesExcludingCategories(
+        const std::vector<std::string> &categories) const;
+
+    /**
+     * @brief 根据步骤文本查找菜谱 ID (升序)
+     * @param text 查询文本，支持中文 (二元分词) 和空格分隔的语言
+     * @param phrase 为 true 时要求各词按顺序相邻出现 (短语查询)；否则只要求全部出现
+     * @return 匹配的菜谱 ID 列表
+     */
+    std::vector<int> findRecipeIdsByStepText(const std::string &text,
+                                             bool phrase = true) const;
+
+    /**
+     * @brief 根据步骤文本查找菜谱，例如步骤中提到 "炖" 的菜谱
+     * @param text 查询文本
+     * @param phrase 是否按短语匹配
+     * @return 匹配的菜谱列表
+     */
+    std::vector<Recipe> findRecipesByStepText(const std::string &text,
+                                              bool phrase = true) const;
+
+    /**
+     * @brief 计算给定菜谱 ID 集合的标签、难度和烹饪时长分面计数
+     *
+     * 直接对倒排索引做交集基数统计 (遍历较小一侧并在较大一侧查找)，不加载菜谱对象。
+     * @param recipeIds 结果集中的菜谱 ID (可无序、可重复)
+     * @return 分面计数
+     */
+    RecipeFacets computeFacets(const std::vector<int> &recipeIds) const;
+
+    /**
+     * @brief 烹饪时长分桶标签 (≤15、16-30、31-60、>60 分钟)
+     */
+    static const std::array<std::string, kCookingTimeBucketCount>
+        &cookingTimeBucketLabels();
+
     // Methods like addRecipeDirectly, setNextRecipeId are removed
     // as their responsibilities are now handled by the RecipeRepository.
 };
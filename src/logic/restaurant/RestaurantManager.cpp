@@ -1,15 +1,20 @@
 #include "logic/restaurant/RestaurantManager.h"
 
-#include <algorithm>  // For std::transform, std::find_if
+#include <algorithm>  // For std::transform, std::remove_if
 #include <cctype>     // For ::tolower
 #include <iostream>   // For potential logging
+#include <iterator>   // For std::prev
 #include <optional>
+#include <set>
+#include <unordered_set>
 #include <vector>
 
 #include "domain/recipe/Recipe.h"          // For getFeaturedRecipes
 #include "domain/restaurant/Restaurant.h"  // Ensure Restaurant is fully defined
 #include "domain/restaurant/RestaurantRepository.h"
+#include "common/exceptions/PersistenceException.h"
 #include "logic/recipe/RecipeManager.h"  // For getFeaturedRecipes
+#include "spdlog/spdlog.h"
 
 // Using declarations for convenience
 using RecipeApp::Recipe;  // Need Recipe type
@@ -19,14 +24,165 @@ using RecipeApp::Domain::Restaurant::RestaurantRepository;
 namespace RecipeApp {
 
 RestaurantManager::RestaurantManager(RestaurantRepository &restaurantRepository)
-    : restaurantRepository_(restaurantRepository) {}
+    : restaurantRepository_(restaurantRepository) {
+    buildInitialIndexes();  // Build indexes on construction
+}
+
+std::string RestaurantManager::normalizeName(const std::string &name) {
+    std::string lowered = name;
+    std::transform(lowered.begin(), lowered.end(), lowered.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    return lowered;
+}
+
+void RestaurantManager::buildInitialIndexes() {
+    m_recipeToRestaurants.clear();
+    m_nameIndex.clear();
+    m_nameNGramIndex.clear();
+    m_indexedRestaurants.clear();
+    m_openSegments = {{0, {}}};
+    m_geoIndex.clear();
+    for (const auto &restaurant : restaurantRepository_.findAll()) {
+        addRestaurantToIndex(restaurant.getRestaurantId(), restaurant);
+    }
+}
+
+void RestaurantManager::addRestaurantToIndex(int restaurantId,
+                                             const Restaurant &restaurant) {
+    removeRestaurantFromIndex(restaurantId);
+    IndexedRestaurant indexed{normalizeName(restaurant.getName()),
+                              restaurant.getFeaturedRecipeIds(),
+                              restaurant.getParsedOpeningHours().intervals()};
+    m_nameIndex[indexed.normalizedName].insert(restaurantId);
+    for (const auto &interval : indexed.openIntervals) {
+        splitOpenSegmentAt(interval.start);
+        splitOpenSegmentAt(interval.end);
+        for (auto it = m_openSegments.find(interval.start);
+             it != m_openSegments.end() && it->first < interval.end; ++it) {
+            it->second.insert(restaurantId);
+        }
+    }
+    m_nameNGramIndex.addDocument(restaurantId, {restaurant.getName()});
+    if (restaurant.getLocation()) {
+        m_geoIndex.insert(restaurantId, *restaurant.getLocation());
+    }
+    for (int recipeId : indexed.featuredRecipeIds) {
+        m_recipeToRestaurants[recipeId].insert(restaurantId);
+    }
+    if (m_menuRecipeSource) {
+        aggregateMenu(restaurantId, indexed.featuredRecipeIds);
+    }
+    m_indexedRestaurants[restaurantId] = std::move(indexed);
+}
+
+void RestaurantManager::removeRestaurantFromIndex(int restaurantId) {
+    auto indexed = m_indexedRestaurants.find(restaurantId);
+    if (indexed == m_indexedRestaurants.end()) {
+        return;
+    }
+    auto nameIt = m_nameIndex.find(indexed->second.normalizedName);
+    if (nameIt != m_nameIndex.end()) {
+        nameIt->second.erase(restaurantId);
+        if (nameIt->second.empty()) {
+            m_nameIndex.erase(nameIt);
+        }
+    }
+    m_nameNGramIndex.removeDocument(restaurantId);
+    m_geoIndex.remove(restaurantId);
+    for (const auto &interval : indexed->second.openIntervals) {
+        for (auto it = m_openSegments.find(interval.start);
+             it != m_openSegments.end() && it->first < interval.end; ++it) {
+            it->second.erase(restaurantId);
+        }
+        mergeOpenSegmentAt(interval.start);
+        mergeOpenSegmentAt(interval.end);
+    }
+    for (int recipeId : indexed->second.featuredRecipeIds) {
+        auto it = m_recipeToRestaurants.find(recipeId);
+        if (it != m_recipeToRestaurants.end()) {
+            it->second.erase(restaurantId);
+            if (it->second.empty()) {
+                m_recipeToRestaurants.erase(it);
+                m_recipeProfiles.erase(recipeId);
+            }
+        }
+    }
+    m_menuAggregates.erase(restaurantId);
+    m_indexedRestaurants.erase(indexed);
+}
+
+// Makes minuteOfWeek a segment boundary; the new segment starts out with the
+// same restaurants as the one it was split from.
+void RestaurantManager::splitOpenSegmentAt(int minuteOfWeek) {
+    if (minuteOfWeek >= OpeningHours::kMinutesPerWeek) {
+        return;
+    }
+    auto next = m_openSegments.upper_bound(minuteOfWeek);
+    auto containing = std::prev(next);
+    if (containing->first != minuteOfWeek) {
+        m_openSegments.emplace_hint(next, minuteOfWeek, containing->second);
+    }
+}
+
+// Drops the boundary at minuteOfWeek if it no longer separates different
+// sets, so the index does not keep growing as restaurants change.
+void RestaurantManager::mergeOpenSegmentAt(int minuteOfWeek) {
+    auto it = m_openSegments.find(minuteOfWeek);
+    if (it != m_openSegments.end() && it != m_openSegments.begin() &&
+        std::prev(it)->second == it->second) {
+        m_openSegments.erase(it);
+    }
+}
+
+const std::set<int> &RestaurantManager::restaurantIdsOpenAt(
+    int minuteOfWeek) const {
+    int minute = ((minuteOfWeek % OpeningHours::kMinutesPerWeek) +
+                  OpeningHours::kMinutesPerWeek) %
+                 OpeningHours::kMinutesPerWeek;
+    return std::prev(m_openSegments.upper_bound(minute))->second;
+}
+
+bool RestaurantManager::isNameTakenByOther(const std::string &name,
+                                           int restaurantId) const {
+    auto it = m_nameIndex.find(normalizeName(name));
+    if (it == m_nameIndex.end()) {
+        return false;
+    }
+    return it->second.size() > 1 || *it->second.begin() != restaurantId;
+}
+
+std::vector<Restaurant> RestaurantManager::loadRestaurants(
+    const std::set<int> &restaurantIds) const {
+    std::vector<Restaurant> restaurants;
+    restaurants.reserve(restaurantIds.size());
+    for (int restaurantId : restaurantIds) {
+        std::optional<Restaurant> restaurant =
+            restaurantRepository_.findById(restaurantId);
+        if (restaurant.has_value()) {
+            restaurants.push_back(std::move(restaurant.value()));
+        }
+    }
+    return restaurants;
+}
+
+std::vector<NearbyRestaurant> RestaurantManager::loadNearby(
+    const std::vector<Logic::Search::GeoGridIndex::Hit> &hits) const {
+    std::vector<NearbyRestaurant> nearby;
+    nearby.reserve(hits.size());
+    for (const auto &hit : hits) {
+        std::optional<Restaurant> restaurant =
+            restaurantRepository_.findById(hit.key);
+        if (restaurant.has_value()) {
+            nearby.push_back({std::move(restaurant.value()), hit.distanceMeters});
+        }
+    }
+    return nearby;
+}
 
 int RestaurantManager::addRestaurant(const Restaurant &restaurant_param) {
-    // 1. Check for name uniqueness using the repository
-    if (!restaurantRepository_.findByName(restaurant_param.getName(), false)
-             .empty()) {
-        // std::cerr << "RestaurantManager: Restaurant name '" <<
-        // restaurant_param.getName() << "' already exists." << std::endl;
+    retryPendingRecipeRemovals();
+    // 1. Check for name uniqueness using the name index
+    if (isNameTakenByOther(restaurant_param.getName(), 0)) {
         return -1;  // Name conflict
     }
 
@@ -38,10 +194,15 @@ int RestaurantManager::addRestaurant(const Restaurant &restaurant_param) {
             .withOpeningHours(restaurant_param.getOpeningHours())
             .withFeaturedRecipeIds(restaurant_param.getFeaturedRecipeIds())
             .build();
+    newRestaurantToAdd.setLocation(restaurant_param.getLocation());
 
     // 3. Save using the repository and return the assigned ID (or -1 on
     // failure)
-    return restaurantRepository_.save(newRestaurantToAdd);
+    int newId = restaurantRepository_.save(newRestaurantToAdd);
+    if (newId != -1) {
+        addRestaurantToIndex(newId, newRestaurantToAdd);
+    }
+    return newId;
 }
 
 std::optional<Restaurant> RestaurantManager::findRestaurantById(
@@ -51,10 +212,17 @@ std::optional<Restaurant> RestaurantManager::findRestaurantById(
 
 std::vector<Restaurant> RestaurantManager::findRestaurantByName(
     const std::string &name, bool partialMatch) const {
-    // Basic implementation - delegates directly to repository.
-    // Could add caching or additional logic here later if needed.
-    // Consider case-insensitivity handling here or in repository.
-    return restaurantRepository_.findByName(name, partialMatch);
+    std::set<int> restaurantIds;
+    if (partialMatch) {
+        std::vector<int> matches = m_nameNGramIndex.search(name);
+        restaurantIds.insert(matches.begin(), matches.end());
+    } else {
+        auto it = m_nameIndex.find(normalizeName(name));
+        if (it != m_nameIndex.end()) {
+            restaurantIds = it->second;
+        }
+    }
+    return loadRestaurants(restaurantIds);
 }
 
 std::vector<Restaurant> RestaurantManager::getAllRestaurants() const {
@@ -63,6 +231,7 @@ std::vector<Restaurant> RestaurantManager::getAllRestaurants() const {
 
 bool RestaurantManager::updateRestaurant(
     const Restaurant &updated_restaurant_param) {
+    retryPendingRecipeRemovals();
     // 1. Check if the restaurant exists
     std::optional<Restaurant> existingRestaurantOpt =
         restaurantRepository_.findById(
@@ -76,29 +245,29 @@ bool RestaurantManager::updateRestaurant(
     Restaurant existingRestaurant = existingRestaurantOpt.value();
 
     // 2. Check for name conflict if the name has changed
-    if (existingRestaurant.getName() != updated_restaurant_param.getName()) {
-        // Check if the new name exists for any *other* restaurant
-        std::vector<Restaurant> potentialConflicts =
-            restaurantRepository_.findByName(updated_restaurant_param.getName(),
-                                             false);
-        for (const auto &conflict : potentialConflicts) {
-            if (conflict.getRestaurantId() !=
-                updated_restaurant_param.getRestaurantId()) {
-                // std::cerr << "RestaurantManager: Updated restaurant name '"
-                // << updated_restaurant_param.getName() << "' conflicts with
-                // existing restaurant (ID: " << conflict.getRestaurantId() <<
-                // ")." << std::endl;
-                return false;  // Name conflict with another restaurant
-            }
-        }
+    if (normalizeName(existingRestaurant.getName()) !=
+            normalizeName(updated_restaurant_param.getName()) &&
+        isNameTakenByOther(updated_restaurant_param.getName(),
+                           updated_restaurant_param.getRestaurantId())) {
+        return false;  // Name conflict with another restaurant
     }
 
     // 3. Save the updated restaurant using the repository
-    return restaurantRepository_.save(updated_restaurant_param) != -1;
+    if (restaurantRepository_.save(updated_restaurant_param) == -1) {
+        return false;
+    }
+    addRestaurantToIndex(updated_restaurant_param.getRestaurantId(),
+                         updated_restaurant_param);
+    return true;
 }
 
 bool RestaurantManager::deleteRestaurant(int restaurantId) {
-    return restaurantRepository_.remove(restaurantId);
+    retryPendingRecipeRemovals();
+    if (!restaurantRepository_.remove(restaurantId)) {
+        return false;
+    }
+    removeRestaurantFromIndex(restaurantId);
+    return true;
 }
 
 std::vector<Recipe> RestaurantManager::getFeaturedRecipes(
@@ -125,6 +294,42 @@ std::vector<Recipe> RestaurantManager::getFeaturedRecipes(
     return featuredRecipesResult;
 }
 
+std::unordered_map<int, std::vector<Recipe>>
+RestaurantManager::getFeaturedRecipesForRestaurants(
+    const std::vector<Restaurant> &restaurants,
+    const RecipeManager &recipeManager) const {
+    std::vector<int> recipeIds;
+    std::unordered_set<int> seen;
+    for (const auto &restaurant : restaurants) {
+        for (int recipeId : restaurant.getFeaturedRecipeIds()) {
+            if (seen.insert(recipeId).second) {
+                recipeIds.push_back(recipeId);
+            }
+        }
+    }
+
+    std::unordered_map<int, Recipe> recipesById;
+    if (!recipeIds.empty()) {
+        for (auto &recipe : recipeManager.findRecipesByIds(recipeIds)) {
+            int recipeId = recipe.getRecipeId();
+            recipesById.emplace(recipeId, std::move(recipe));
+        }
+    }
+
+    std::unordered_map<int, std::vector<Recipe>> featured;
+    featured.reserve(restaurants.size());
+    for (const auto &restaurant : restaurants) {
+        auto &recipes = featured[restaurant.getRestaurantId()];
+        for (int recipeId : restaurant.getFeaturedRecipeIds()) {
+            auto it = recipesById.find(recipeId);
+            if (it != recipesById.end()) {
+                recipes.push_back(it->second);
+            }
+        }
+    }
+    return featured;
+}
+
 // Removed persistence-specific methods: setNextRestaurantId,
 // getNextRestaurantId, addRestaurantDirectly
 
@@ -139,59 +344,349 @@ int RestaurantManager::getNextRestaurantId() const {
 
 void RestaurantManager::addRestaurantFromPersistence(
     const Restaurant &restaurant) {
-    restaurantRepository_.save(restaurant);  // Assuming save handles both new
-                                             // and existing if ID is set
+    // Assuming save handles both new and existing if ID is set
+    if (restaurantRepository_.save(restaurant) != -1) {
+        addRestaurantToIndex(restaurant.getRestaurantId(), restaurant);
+    }
 }
 
 void RestaurantManager::setNextRestaurantIdFromPersistence(
     int nextId) {
     restaurantRepository_.setNextId(nextId);
 }
+std::set<int> RestaurantManager::restaurantIdsByCuisine(
+    const std::string &cuisineTag, const RecipeManager &recipeManager) const {
+    // Join the tag's postings with the reverse index: only recipes carrying
+    // the tag are visited, and the set removes duplicate restaurants.
+    std::set<int> restaurantIds;
+    if (cuisineTag.empty()) {
+        return restaurantIds;
+    }
+    for (int recipeId : recipeManager.findRecipeIdsByTag(cuisineTag)) {
+        auto it = m_recipeToRestaurants.find(recipeId);
+        if (it != m_recipeToRestaurants.end()) {
+            restaurantIds.insert(it->second.begin(), it->second.end());
+        }
+    }
+    return restaurantIds;
+}
+
 std::vector<Restaurant> RestaurantManager::findRestaurantsByCuisine(
     const std::string &cuisineTag, const RecipeManager &recipeManager) const {
-    std::vector<Restaurant> matchingRestaurants;
-    std::vector<Restaurant> allRestaurants = this->getAllRestaurants(); // Uses repository via manager method
+    return loadRestaurants(restaurantIdsByCuisine(cuisineTag, recipeManager));
+}
 
-    if (cuisineTag.empty()) {
-        // spdlog::warn("findRestaurantsByCuisine called with empty cuisineTag.");
-        return matchingRestaurants; // Or return allRestaurants? For now, empty.
-    }
-
-    std::string lowerCuisineTag = cuisineTag;
-    std::transform(lowerCuisineTag.begin(), lowerCuisineTag.end(), lowerCuisineTag.begin(),
-                   [](unsigned char c){ return std::tolower(c); });
-
-    for (const auto &restaurant : allRestaurants) {
-        std::vector<Recipe> featuredRecipes = this->getFeaturedRecipes(restaurant.getRestaurantId(), recipeManager); // Corrected getId to getRestaurantId
-        bool foundMatchInRestaurant = false;
-        for (const auto &recipe : featuredRecipes) {
-            const auto &recipeTags = recipe.getTags();
-            for (const auto &tag : recipeTags) {
-                std::string lowerTag = tag;
-                std::transform(lowerTag.begin(), lowerTag.end(), lowerTag.begin(),
-                               [](unsigned char c){ return std::tolower(c); });
-                if (lowerTag == lowerCuisineTag) {
-                    // Check if restaurant is already added to avoid duplicates if multiple recipes match
-                    bool alreadyAdded = false;
-                    for(const auto& addedRest : matchingRestaurants) {
-                        if(addedRest.getRestaurantId() == restaurant.getRestaurantId()) { // Corrected getId to getRestaurantId
-                            alreadyAdded = true;
-                            break;
-                        }
-                    }
-                    if (!alreadyAdded) {
-                        matchingRestaurants.push_back(restaurant);
-                    }
-                    foundMatchInRestaurant = true;
-                    break; // Found matching tag in this recipe, move to next recipe or restaurant
-                }
+std::vector<Restaurant> RestaurantManager::findRestaurantsOpenAt(
+    int minuteOfWeek) const {
+    return loadRestaurants(restaurantIdsOpenAt(minuteOfWeek));
+}
+
+std::vector<Restaurant> RestaurantManager::findRestaurantsByCuisineOpenAt(
+    const std::string &cuisineTag, int minuteOfWeek,
+    const RecipeManager &recipeManager) const {
+    std::set<int> byCuisine = restaurantIdsByCuisine(cuisineTag, recipeManager);
+    const std::set<int> &open = restaurantIdsOpenAt(minuteOfWeek);
+    const std::set<int> &smaller = byCuisine.size() <= open.size() ? byCuisine : open;
+    const std::set<int> &larger = byCuisine.size() <= open.size() ? open : byCuisine;
+    std::set<int> both;
+    for (int restaurantId : smaller) {
+        if (larger.count(restaurantId)) {
+            both.insert(both.end(), restaurantId);
+        }
+    }
+    return loadRestaurants(both);
+}
+
+std::vector<Restaurant> RestaurantManager::findRestaurantsFeaturingRecipe(
+    int recipeId) const {
+    auto it = m_recipeToRestaurants.find(recipeId);
+    if (it == m_recipeToRestaurants.end()) {
+        return {};
+    }
+    return loadRestaurants(it->second);
+}
+
+std::vector<NearbyRestaurant> RestaurantManager::findNearestRestaurants(
+    const GeoPoint &origin, std::size_t k, double maxDistanceMeters,
+    std::optional<int> featuringRecipeId) const {
+    using Logic::Search::GeoGridIndex;
+    if (!featuringRecipeId) {
+        return loadNearby(m_geoIndex.nearest(origin, k, maxDistanceMeters));
+    }
+    auto featuring = m_recipeToRestaurants.find(*featuringRecipeId);
+    if (featuring == m_recipeToRestaurants.end() || k == 0) {
+        return {};
+    }
+    const std::set<int> &candidates = featuring->second;
+    // A short posting list is cheaper to rank directly than to filter a
+    // grid walk that may have to pass many non-featuring restaurants.
+    constexpr std::size_t kDirectRankLimit = 4096;
+    if (candidates.size() > kDirectRankLimit) {
+        return loadNearby(m_geoIndex.nearest(
+            origin, k, maxDistanceMeters,
+            [&candidates](int restaurantId) { return candidates.count(restaurantId) > 0; }));
+    }
+    std::vector<GeoGridIndex::Hit> hits;
+    for (int restaurantId : candidates) {
+        if (std::optional<GeoPoint> location = m_geoIndex.location(restaurantId)) {
+            double distance = GeoPoint::distanceMeters(origin, *location);
+            if (distance <= maxDistanceMeters) {
+                hits.push_back({restaurantId, distance});
             }
-            if (foundMatchInRestaurant) {
-                break; // Found matching recipe in this restaurant, move to next restaurant
+        }
+    }
+    auto nearer = [](const GeoGridIndex::Hit &a, const GeoGridIndex::Hit &b) {
+        return a.distanceMeters != b.distanceMeters ? a.distanceMeters < b.distanceMeters
+                                                    : a.key < b.key;
+    };
+    if (hits.size() > k) {
+        std::partial_sort(hits.begin(), hits.begin() + static_cast<std::ptrdiff_t>(k), hits.end(), nearer);
+        hits.resize(k);
+    } else {
+        std::sort(hits.begin(), hits.end(), nearer);
+    }
+    return loadNearby(hits);
+}
+
+std::vector<Restaurant> RestaurantManager::findRestaurantsInBounds(
+    double south, double west, double north, double east,
+    std::size_t limit) const {
+    std::vector<int> ids = m_geoIndex.withinBounds(south, west, north, east, limit);
+    return loadRestaurants(std::set<int>(ids.begin(), ids.end()));
+}
+
+int RestaurantManager::removeRecipeReferences(
+    const std::vector<int> &recipeIds) {
+    std::set<int> removedIds = m_pendingRecipeRemovals;
+    removedIds.insert(recipeIds.begin(), recipeIds.end());
+    std::set<int> affected;
+    for (int recipeId : removedIds) {
+        auto it = m_recipeToRestaurants.find(recipeId);
+        if (it != m_recipeToRestaurants.end()) {
+            affected.insert(it->second.begin(), it->second.end());
+        }
+    }
+    if (affected.empty()) {
+        m_pendingRecipeRemovals.clear();
+        return 0;
+    }
+
+    std::vector<Restaurant> updated = loadRestaurants(affected);
+    for (auto &restaurant : updated) {
+        std::vector<int> featured = restaurant.getFeaturedRecipeIds();
+        featured.erase(std::remove_if(featured.begin(), featured.end(),
+                                      [&removedIds](int id) {
+                                          return removedIds.count(id) > 0;
+                                      }),
+                       featured.end());
+        restaurant.setFeaturedRecipeIds(featured);
+    }
+    if (!restaurantRepository_.updateMany(updated)) {
+        // The reverse index still lists the references, so a retry finds them
+        spdlog::error("Failed to remove references to deleted recipes from {} "
+                      "restaurants; will retry on the next restaurant write.",
+                      updated.size());
+        m_pendingRecipeRemovals = std::move(removedIds);
+        return -1;
+    }
+    m_pendingRecipeRemovals.clear();
+    for (const auto &restaurant : updated) {
+        addRestaurantToIndex(restaurant.getRestaurantId(), restaurant);
+    }
+    return static_cast<int>(updated.size());
+}
+
+void RestaurantManager::retryPendingRecipeRemovals() {
+    if (!m_pendingRecipeRemovals.empty()) {
+        removeRecipeReferences({});
+    }
+}
+
+void RestaurantManager::followRecipeDeletions(RecipeManager &recipeManager) {
+    recipeManager.addRecipeDeletedListener(
+        [this](int recipeId) { removeRecipeReferences({recipeId}); });
+}
+
+std::vector<std::pair<std::string, std::size_t>> MenuAggregates::topTags(
+    std::size_t n) const {
+    std::vector<std::pair<std::string, std::size_t>> tags(tagCounts.begin(),
+                                                          tagCounts.end());
+    std::size_t count = std::min(n, tags.size());
+    std::partial_sort(tags.begin(), tags.begin() + count, tags.end(),
+                      [](const auto &a, const auto &b) {
+                          return a.second != b.second ? a.second > b.second
+                                                      : a.first < b.first;
+                      });
+    tags.resize(count);
+    return tags;
+}
+
+// Returns the cached profile of a featured recipe, loading it on first use;
+// nullptr if the recipe does not exist.
+const RestaurantManager::RecipeProfile *RestaurantManager::profileFor(
+    int recipeId) {
+    auto it = m_recipeProfiles.find(recipeId);
+    if (it != m_recipeProfiles.end()) {
+        return &it->second;
+    }
+    auto recipe = m_menuRecipeSource->findRecipeById(recipeId);
+    if (!recipe) {
+        return nullptr;
+    }
+    auto inserted = m_recipeProfiles.emplace(
+        recipeId, RecipeProfile{recipe->getCookingTime(),
+                                recipe->getDifficulty(), recipe->getTags()});
+    return &inserted.first->second;
+}
+
+// Adds (sign = 1) or removes (sign = -1) one recipe's contribution.
+void RestaurantManager::applyProfile(MenuAggregates &aggregates,
+                                     const RecipeProfile &profile, int sign) {
+    auto &difficultyCount =
+        aggregates.difficultyCounts[static_cast<std::size_t>(profile.difficulty)];
+    aggregates.totalCookingTime += sign * profile.cookingTime;
+    if (sign > 0) {
+        ++aggregates.recipeCount;
+        ++difficultyCount;
+        for (const auto &tag : profile.tags) {
+            ++aggregates.tagCounts[tag];
+        }
+        return;
+    }
+    --aggregates.recipeCount;
+    --difficultyCount;
+    for (const auto &tag : profile.tags) {
+        auto it = aggregates.tagCounts.find(tag);
+        if (it != aggregates.tagCounts.end() && --it->second == 0) {
+            aggregates.tagCounts.erase(it);
+        }
+    }
+}
+
+void RestaurantManager::aggregateMenu(int restaurantId,
+                                      const std::vector<int> &featuredRecipeIds) {
+    MenuAggregates aggregates;
+    std::unordered_set<int> counted;
+    for (int recipeId : featuredRecipeIds) {
+        if (!counted.insert(recipeId).second) {
+            continue;
+        }
+        if (const RecipeProfile *profile = profileFor(recipeId)) {
+            applyProfile(aggregates, *profile, 1);
+        }
+    }
+    m_menuAggregates[restaurantId] = std::move(aggregates);
+}
+
+void RestaurantManager::onRecipeUpdated(const Recipe &recipe) {
+    auto featuring = m_recipeToRestaurants.find(recipe.getRecipeId());
+    if (featuring == m_recipeToRestaurants.end()) {
+        return;
+    }
+    RecipeProfile updated{recipe.getCookingTime(), recipe.getDifficulty(),
+                          recipe.getTags()};
+    auto cached = m_recipeProfiles.find(recipe.getRecipeId());
+    for (int restaurantId : featuring->second) {
+        auto &aggregates = m_menuAggregates[restaurantId];
+        if (cached != m_recipeProfiles.end()) {
+            applyProfile(aggregates, cached->second, -1);
+        }
+        applyProfile(aggregates, updated, 1);
+    }
+    m_recipeProfiles[recipe.getRecipeId()] = std::move(updated);
+}
+
+void RestaurantManager::onRecipeDeleted(int recipeId) {
+    auto cached = m_recipeProfiles.find(recipeId);
+    if (cached == m_recipeProfiles.end()) {
+        return;
+    }
+    auto featuring = m_recipeToRestaurants.find(recipeId);
+    if (featuring != m_recipeToRestaurants.end()) {
+        for (int restaurantId : featuring->second) {
+            applyProfile(m_menuAggregates[restaurantId], cached->second, -1);
+        }
+    }
+    m_recipeProfiles.erase(cached);
+}
+
+void RestaurantManager::trackMenuAggregates(RecipeManager &recipeManager) {
+    bool firstCall = m_menuRecipeSource == nullptr;
+    m_menuRecipeSource = &recipeManager;
+    if (firstCall) {
+        recipeManager.addRecipeUpdatedListener(
+            [this](const Recipe &recipe) { onRecipeUpdated(recipe); });
+        recipeManager.addRecipeDeletedListener(
+            [this](int recipeId) { onRecipeDeleted(recipeId); });
+    }
+
+    // Load every featured recipe in one batch rather than one lookup each
+    m_recipeProfiles.clear();
+    std::vector<int> recipeIds;
+    recipeIds.reserve(m_recipeToRestaurants.size());
+    for (const auto &entry : m_recipeToRestaurants) {
+        recipeIds.push_back(entry.first);
+    }
+    if (!recipeIds.empty()) {
+        for (const auto &recipe : recipeManager.findRecipesByIds(recipeIds)) {
+            m_recipeProfiles.emplace(
+                recipe.getRecipeId(),
+                RecipeProfile{recipe.getCookingTime(), recipe.getDifficulty(),
+                              recipe.getTags()});
+        }
+    }
+    m_menuAggregates.clear();
+    for (const auto &entry : m_indexedRestaurants) {
+        aggregateMenu(entry.first, entry.second.featuredRecipeIds);
+    }
+}
+
+std::optional<MenuAggregates> RestaurantManager::getMenuAggregates(
+    int restaurantId) const {
+    auto it = m_menuAggregates.find(restaurantId);
+    if (it == m_menuAggregates.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+RestaurantIntegrityReport RestaurantManager::verifyRecipeReferences(
+    const RecipeManager &recipeManager, bool repair) {
+    std::vector<int> ids = recipeManager.getAllRecipeIds();
+    std::unordered_set<int> existing(ids.begin(), ids.end());
+
+    RestaurantIntegrityReport report;
+    std::vector<Restaurant> toRepair;
+    for (auto &restaurant : restaurantRepository_.findAll()) {
+        ++report.restaurantsChecked;
+        std::vector<int> kept;
+        const auto &featured = restaurant.getFeaturedRecipeIds();
+        kept.reserve(featured.size());
+        for (int recipeId : featured) {
+            if (existing.count(recipeId)) {
+                kept.push_back(recipeId);
+            } else {
+                report.danglingReferences.emplace_back(
+                    restaurant.getRestaurantId(), recipeId);
             }
         }
+        if (repair && kept.size() != featured.size()) {
+            restaurant.setFeaturedRecipeIds(kept);
+            toRepair.push_back(std::move(restaurant));
+        }
+    }
+
+    if (!toRepair.empty()) {
+        if (!restaurantRepository_.updateMany(toRepair)) {
+            throw Common::Exceptions::PersistenceException(
+                "Failed to persist repaired restaurants.");
+        }
+        for (const auto &restaurant : toRepair) {
+            addRestaurantToIndex(restaurant.getRestaurantId(), restaurant);
+        }
+        report.restaurantsRepaired = toRepair.size();
     }
-    return matchingRestaurants;
+    return report;
 }
 
 }  // namespace RecipeApp
\ No newline at end of file
@@ -5,12 +5,65 @@
 #include "domain/restaurant/RestaurantRepository.h" // Added RestaurantRepository include
 #include "logic/recipe/RecipeManager.h"             // Still needed for getFeaturedRecipes
 #include "domain/recipe/Recipe.h"                   // Need Recipe definition
+#include "logic/search/GeoGridIndex.h"
+#include "logic/search/NGramIndex.h"
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <set>
 #include <string>
+#include <utility>
+#include <unordered_map>
 #include <vector>
 #include <optional> // For findById return type
 
 namespace RecipeApp
 {
+    /**
+     * @brief Outcome of RestaurantManager::verifyRecipeReferences.
+     */
+    struct RestaurantIntegrityReport
+    {
+        std::size_t restaurantsChecked = 0;
+        /// (restaurant ID, missing recipe ID) pairs, in restaurant order.
+        std::vector<std::pair<int, int>> danglingReferences;
+        /// Restaurants rewritten by a repair pass (0 when only verifying).
+        std::size_t restaurantsRepaired = 0;
+    };
+
+    /**
+     * @brief Statistics over a restaurant's featured recipes (see
+     *        RestaurantManager::trackMenuAggregates). Featured IDs whose recipe no
+     *        longer exists are not counted.
+     */
+    struct MenuAggregates
+    {
+        std::size_t recipeCount = 0;
+        long long totalCookingTime = 0; ///< Minutes, summed over the counted recipes
+        /// Recipe counts indexed by Difficulty (Easy, Medium, Hard).
+        std::array<std::size_t, 3> difficultyCounts{};
+        /// Tag -> number of counted recipes carrying it.
+        std::map<std::string, std::size_t> tagCounts;
+
+        double averageCookingTime() const
+        {
+            return recipeCount ? static_cast<double>(totalCookingTime) / recipeCount : 0.0;
+        }
+
+        /// The n most common tags, most frequent first (ties by tag).
+        std::vector<std::pair<std::string, std::size_t>> topTags(std::size_t n) const;
+    };
+
+    /**
+     * @brief A restaurant returned by a proximity query.
+     */
+    struct NearbyRestaurant
+    {
+        Restaurant restaurant;
+        double distanceMeters;
+    };
+
     // Forward declare if needed
     // class RecipeManager;
     // class Recipe;
@@ -21,6 +74,69 @@ namespace RecipeApp
         Domain::Restaurant::RestaurantRepository &restaurantRepository_; ///< Reference to the restaurant repository
         // Removed internal list and nextId
 
+        /// Reverse index: featured recipe ID -> IDs of the restaurants featuring it.
+        /// Cuisine (tag) lookups are derived from it by joining with RecipeManager's
+        /// tag index, so recipe tag edits are reflected without notifying this class.
+        std::unordered_map<int, std::set<int>> m_recipeToRestaurants;
+        /// Normalized (lowercased) name -> restaurant IDs, for exact lookups and
+        /// O(1) name-conflict checks.
+        std::unordered_map<std::string, std::set<int>> m_nameIndex;
+        /// Substring index over restaurant names, keyed by restaurant ID.
+        Logic::Search::NGramIndex m_nameNGramIndex;
+
+        /// Opening-hours interval index over the week: segment start (minute of
+        /// week) -> IDs of the restaurants open from that minute until the next
+        /// key. Always has a key at 0. Restaurants with unparsed hours are absent.
+        std::map<int, std::set<int>> m_openSegments;
+        /// Spatial index over the restaurants that have coordinates, keyed by ID.
+        Logic::Search::GeoGridIndex m_geoIndex;
+
+        /// What an indexed restaurant contributed to the indexes, so it can be
+        /// unindexed without reading it back from the repository.
+        struct IndexedRestaurant
+        {
+            std::string normalizedName;
+            std::vector<int> featuredRecipeIds;
+            std::vector<OpeningHours::Interval> openIntervals;
+        };
+        std::unordered_map<int, IndexedRestaurant> m_indexedRestaurants;
+
+        /// Deleted recipes whose references could not be removed because persisting
+        /// the affected restaurants failed. Retried before the next restaurant write
+        /// and along with the next cascade.
+        std::set<int> m_pendingRecipeRemovals;
+
+        /// The fields of a featured recipe that feed MenuAggregates.
+        struct RecipeProfile
+        {
+            int cookingTime;
+            Difficulty difficulty;
+            std::vector<std::string> tags;
+        };
+        /// Set by trackMenuAggregates; aggregates are maintained only while set.
+        const RecipeManager *m_menuRecipeSource = nullptr;
+        /// Profiles of the recipes featured by at least one restaurant.
+        std::unordered_map<int, RecipeProfile> m_recipeProfiles;
+        std::unordered_map<int, MenuAggregates> m_menuAggregates;
+
+        void buildInitialIndexes();
+        void addRestaurantToIndex(int restaurantId, const Restaurant &restaurant);
+        void removeRestaurantFromIndex(int restaurantId);
+        bool isNameTakenByOther(const std::string &name, int restaurantId) const;
+        void splitOpenSegmentAt(int minuteOfWeek);
+        void mergeOpenSegmentAt(int minuteOfWeek);
+        const std::set<int> &restaurantIdsOpenAt(int minuteOfWeek) const;
+        std::set<int> restaurantIdsByCuisine(const std::string &cuisineTag, const RecipeManager &recipeManager) const;
+        static std::string normalizeName(const std::string &name);
+        std::vector<Restaurant> loadRestaurants(const std::set<int> &restaurantIds) const;
+        const RecipeProfile *profileFor(int recipeId);
+        static void applyProfile(MenuAggregates &aggregates, const RecipeProfile &profile, int sign);
+        void aggregateMenu(int restaurantId, const std::vector<int> &featuredRecipeIds);
+        void onRecipeUpdated(const Recipe &recipe);
+        void onRecipeDeleted(int recipeId);
+        std::vector<NearbyRestaurant> loadNearby(const std::vector<Logic::Search::GeoGridIndex::Hit> &hits) const;
+        void retryPendingRecipeRemovals();
+
     public:
         /**
          * @brief Constructor, takes repository reference.
@@ -80,6 +196,18 @@ namespace RecipeApp
          */
         std::vector<Recipe> getFeaturedRecipes(int restaurantId, const RecipeManager &recipeManager) const; // Changed return type
 
+        /**
+         * @brief Batch form of getFeaturedRecipes for listings: the union of the featured
+         *        IDs is fetched with one recipe lookup and handed back per restaurant, so
+         *        the cost is linear in restaurants + references.
+         * @param restaurants The restaurants to resolve (e.g. from getAllRestaurants()).
+         * @param recipeManager Reference to RecipeManager to fetch recipe details.
+         * @return Restaurant ID -> featured Recipes in featured-list order. Recipes that no
+         *         longer exist are skipped; every given restaurant has an entry.
+         */
+        std::unordered_map<int, std::vector<Recipe>> getFeaturedRecipesForRestaurants(
+            const std::vector<Restaurant> &restaurants, const RecipeManager &recipeManager) const;
+
         /**
          * @brief Gets the next available ID for a new restaurant (for persistence).
          * @return The next available ID.
@@ -106,6 +234,113 @@ namespace RecipeApp
          */
         std::vector<Restaurant> findRestaurantsByCuisine(const std::string &cuisineTag, const RecipeManager &recipeManager) const;
 
+        /**
+         * @brief Find restaurants open at a given time of the week, from the opening-hours
+         *        interval index (O(log R + k)). Restaurants whose opening hours could not
+         *        be parsed are never returned.
+         * @param minuteOfWeek Minutes since Monday 00:00 (see OpeningHours::minuteOfWeek).
+         * @return std::vector of open Restaurants ordered by ID.
+         */
+        std::vector<Restaurant> findRestaurantsOpenAt(int minuteOfWeek) const;
+
+        /**
+         * @brief findRestaurantsByCuisine restricted to restaurants open at a given time.
+         * @param cuisineTag The cuisine tag to search for.
+         * @param minuteOfWeek Minutes since Monday 00:00.
+         * @param recipeManager Reference to RecipeManager for the tag lookup.
+         * @return std::vector of matching Restaurants ordered by ID.
+         */
+        std::vector<Restaurant> findRestaurantsByCuisineOpenAt(const std::string &cuisineTag, int minuteOfWeek,
+                                                               const RecipeManager &recipeManager) const;
+
+        /**
+         * @brief The k restaurants nearest to a point, from the spatial index. Restaurants
+         *        without coordinates are never returned.
+         * @param origin Query position.
+         * @param k Maximum number of results.
+         * @param maxDistanceMeters Ignore restaurants further away (default: no limit).
+         * @param featuringRecipeId If set, only restaurants featuring this recipe.
+         * @return Restaurants nearest first, with their great-circle distance.
+         */
+        std::vector<NearbyRestaurant> findNearestRestaurants(
+            const GeoPoint &origin, std::size_t k,
+            double maxDistanceMeters = std::numeric_limits<double>::infinity(),
+            std::optional<int> featuringRecipeId = std::nullopt) const;
+
+        /**
+         * @brief Restaurants inside a latitude/longitude box (e.g. the visible map area).
+         * @param west,east Longitudes; west > east means the box crosses the antimeridian.
+         * @param limit Maximum number of results (0 = no limit); which ones are returned
+         *        when the limit is hit is unspecified.
+         * @return Matching Restaurants ordered by ID.
+         */
+        std::vector<Restaurant> findRestaurantsInBounds(double south, double west, double north, double east,
+                                                        std::size_t limit = 0) const;
+
+        /**
+         * @brief Find the restaurants that feature a given recipe.
+         * @param recipeId The recipe ID.
+         * @return std::vector of Restaurants ordered by ID (empty if none).
+         */
+        std::vector<Restaurant> findRestaurantsFeaturingRecipe(int recipeId) const;
+
+        /**
+         * @brief Remove deleted recipes from the featured lists of the restaurants that
+         *        reference them. Only those restaurants (found through the reverse index)
+         *        are loaded, and they are persisted in one batch.
+         *        IDs left over from an earlier failed call are retried with them.
+         * @param recipeIds IDs of recipes that no longer exist.
+         * @return Number of restaurants updated, or -1 if persisting the batch failed
+         *         (the IDs are then kept in pendingRecipeReferenceRemovals()).
+         */
+        int removeRecipeReferences(const std::vector<int> &recipeIds);
+
+        /**
+         * @brief Deleted recipes that restaurants still reference because removing
+         *        the references failed to persist. Empty unless a cascade failed;
+         *        the next restaurant write or cascade retries them.
+         */
+        const std::set<int> &pendingRecipeReferenceRemovals() const { return m_pendingRecipeRemovals; }
+
+        /**
+         * @brief Cascade recipe deletions into restaurants: registers a listener on
+         *        recipeManager that calls removeRecipeReferences for each deleted recipe.
+         *        A failed cascade is logged and left pending (see
+         *        pendingRecipeReferenceRemovals()); the deletion itself stands.
+         * @param recipeManager Manager whose deletions should be followed. Must not
+         *        outlive this RestaurantManager's use.
+         */
+        void followRecipeDeletions(RecipeManager &recipeManager);
+
+        /**
+         * @brief Offline check for featured recipe IDs that no longer exist, in one pass
+         *        over all restaurants (linear in restaurants + references + recipes).
+         * @param recipeManager Source of the existing recipe IDs.
+         * @param repair If true, strips the dangling IDs and persists the affected
+         *        restaurants in one batch.
+         * @return What was found (and repaired).
+         * @throws PersistenceException if repair is requested and persisting fails.
+         */
+        RestaurantIntegrityReport verifyRecipeReferences(const RecipeManager &recipeManager, bool repair = false);
+
+        /**
+         * @brief Start maintaining MenuAggregates for every restaurant. Builds them once
+         *        (one batch recipe lookup), then keeps them current: a restaurant is
+         *        re-aggregated when its featured list changes, and a recipe edit or
+         *        deletion adjusts only the restaurants featuring that recipe.
+         * @param recipeManager Source of recipe fields; registers update and deletion
+         *        listeners on it. Must outlive this RestaurantManager's use.
+         */
+        void trackMenuAggregates(RecipeManager &recipeManager);
+
+        /**
+         * @brief The maintained menu statistics of a restaurant, O(1).
+         * @param restaurantId The restaurant ID.
+         * @return The aggregates, or std::nullopt if the restaurant is unknown or
+         *         trackMenuAggregates has not been called.
+         */
+        std::optional<MenuAggregates> getMenuAggregates(int restaurantId) const;
+
         // Removed persistence-specific methods: setNextRestaurantId, getNextRestaurantId, addRestaurantDirectly
     };
 
@@ -0,0 +1,189 @@
+#include "FederatedSearchService.h"
+
+#include <algorithm>
+#include <cctype>
+#include <future>
+#include <iterator>
+#include <mutex>
+
+#include "../encyclopedia/RecipeEncyclopediaManager.h"
+#include "../recipe/RecipeManager.h"
+
+namespace RecipeApp {
+namespace Logic {
+namespace Search {
+
+namespace {
+// Score weights; a name match always outranks tag and ingredient matches.
+constexpr int kNameExact = 100;
+constexpr int kNamePrefix = 70;
+constexpr int kNameContains = 50;
+constexpr int kTagExact = 30;
+constexpr int kTagContains = 15;
+constexpr int kIngredientExact = 25;
+constexpr int kIngredientContains = 12;
+
+std::string toLowerAscii(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    return s;
+}
+
+std::string trim(const std::string& s) {
+    const char* whitespace = " \t\r\n";
+    auto first = s.find_first_not_of(whitespace);
+    if (first == std::string::npos) {
+        return "";
+    }
+    auto last = s.find_last_not_of(whitespace);
+    return s.substr(first, last - first + 1);
+}
+
+bool endsWith(const std::string& s, const std::string& suffix) {
+    return s.size() >= suffix.size() &&
+           s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// Best score of the query against a list of terms.
+int bestTermScore(const std::string& query, const std::vector<std::string>& terms,
+                  int exact, int contains) {
+    int best = 0;
+    for (const auto& term : terms) {
+        std::string lowered = toLowerAscii(term);
+        if (lowered == query) {
+            return exact;
+        }
+        if (lowered.find(query) != std::string::npos) {
+            best = contains;
+        }
+    }
+    return best;
+}
+
+bool rankBefore(const FederatedSearchHit& a, const FederatedSearchHit& b) {
+    if (a.score != b.score) {
+        return a.score > b.score;
+    }
+    if (a.source != b.source) {
+        return a.source == RecipeSource::UserCatalogue;
+    }
+    std::string nameA = FederatedSearchService::normalizeName(a.recipe.getName());
+    std::string nameB = FederatedSearchService::normalizeName(b.recipe.getName());
+    if (nameA != nameB) {
+        return nameA < nameB;
+    }
+    return a.recipe.getRecipeId() < b.recipe.getRecipeId();
+}
+}  // namespace
+
+FederatedSearchService::FederatedSearchService(
+    const RecipeApp::RecipeManager& recipeManager,
+    const Encyclopedia::RecipeEncyclopediaManager& encyclopediaManager)
+    : m_recipeManager(recipeManager), m_encyclopediaManager(encyclopediaManager) {}
+
+std::string FederatedSearchService::normalizeName(const std::string& name) {
+    std::string normalized = trim(toLowerAscii(name));
+    for (const std::string suffix : {"(百科)", "（百科）"}) {
+        if (endsWith(normalized, suffix)) {
+            normalized = trim(normalized.substr(0, normalized.size() - suffix.size()));
+            break;
+        }
+    }
+    return normalized;
+}
+
+int FederatedSearchService::scoreRecipe(const std::string& query,
+                                        const RecipeApp::Recipe& recipe) {
+    std::string q = trim(toLowerAscii(query));
+    if (q.empty()) {
+        return 0;
+    }
+
+    int score = 0;
+    std::string name = normalizeName(recipe.getName());
+    if (name == q) {
+        score += kNameExact;
+    } else if (name.compare(0, q.size(), q) == 0) {
+        score += kNamePrefix;
+    } else if (name.find(q) != std::string::npos) {
+        score += kNameContains;
+    }
+
+    score += bestTermScore(q, recipe.getTags(), kTagExact, kTagContains);
+
+    std::vector<std::string> ingredientNames;
+    ingredientNames.reserve(recipe.getIngredients().size());
+    for (const auto& ingredient : recipe.getIngredients()) {
+        ingredientNames.push_back(ingredient.name);
+    }
+    score += bestTermScore(q, ingredientNames, kIngredientExact, kIngredientContains);
+    return score;
+}
+
+std::vector<FederatedSearchHit> FederatedSearchService::searchUserCatalogue(
+    const std::string& query) const {
+    // The catalogue is small and its indexes are exact-match, so score every
+    // recipe directly to get the same substring semantics as the encyclopedia.
+    std::vector<FederatedSearchHit> hits;
+    for (auto& recipe : m_recipeManager.getAllRecipes()) {
+        int score = scoreRecipe(query, recipe);
+        if (score > 0) {
+            hits.push_back({RecipeSource::UserCatalogue, std::move(recipe), score});
+        }
+    }
+    return hits;
+}
+
+bool FederatedSearchService::isImported(
+    const RecipeApp::Recipe& encyclopediaRecipe) const {
+    return !m_recipeManager.findRecipeByName(encyclopediaRecipe.getName()).empty() ||
+           !m_recipeManager.findRecipeByName(normalizeName(encyclopediaRecipe.getName()))
+                .empty();
+}
+
+std::vector<FederatedSearchHit> FederatedSearchService::searchEncyclopedia(
+    const std::string& query) const {
+    std::vector<FederatedSearchHit> hits;
+    for (auto& recipe : m_encyclopediaManager.searchRecipes(query)) {
+        int score = scoreRecipe(query, recipe);
+        if (score > 0 && !isImported(recipe)) {
+            hits.push_back({RecipeSource::Encyclopedia, std::move(recipe), score});
+        }
+    }
+    return hits;
+}
+
+std::vector<FederatedSearchHit> FederatedSearchService::search(
+    const std::string& query, std::size_t topK,
+    const UpdateCallback& onUpdate) const {
+    std::mutex mergeMutex;
+    std::vector<FederatedSearchHit> merged;
+
+    // Keeping only the running top-K is exact: the final top-K is contained
+    // in the union of each source's top-K.
+    auto mergeHits = [&](std::vector<FederatedSearchHit> hits, RecipeSource source) {
+        std::lock_guard<std::mutex> lock(mergeMutex);
+        std::move(hits.begin(), hits.end(), std::back_inserter(merged));
+        std::sort(merged.begin(), merged.end(), rankBefore);
+        if (topK > 0 && merged.size() > topK) {
+            merged.erase(merged.begin() + static_cast<std::ptrdiff_t>(topK), merged.end());
+        }
+        if (onUpdate) {
+            onUpdate(merged, source);
+        }
+    };
+
+    auto userSearch = std::async(std::launch::async, [&] {
+        mergeHits(searchUserCatalogue(query), RecipeSource::UserCatalogue);
+    });
+    auto encyclopediaSearch = std::async(std::launch::async, [&] {
+        mergeHits(searchEncyclopedia(query), RecipeSource::Encyclopedia);
+    });
+    userSearch.get();
+    encyclopediaSearch.get();
+    return merged;
+}
+
+}  // namespace Search
+}  // namespace Logic
+}  // namespace RecipeApp
@@ -0,0 +1,96 @@
+#ifndef RECIPE_SEARCH_FEDERATED_SEARCH_SERVICE_H
+#define RECIPE_SEARCH_FEDERATED_SEARCH_SERVICE_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "../../domain/recipe/Recipe.h"
+
+namespace RecipeApp {
+class RecipeManager;
+namespace Logic {
+namespace Encyclopedia {
+class RecipeEncyclopediaManager;
+}
+
+namespace Search {
+
+enum class RecipeSource {
+    UserCatalogue,  ///< The user's own recipes (RecipeManager)
+    Encyclopedia    ///< Read-only reference recipes (RecipeEncyclopediaManager)
+};
+
+struct FederatedSearchHit {
+    RecipeSource source;
+    RecipeApp::Recipe recipe;
+    int score;
+};
+
+/**
+ * @brief Searches the user catalogue and the encyclopedia concurrently and
+ *        merges the results under one scoring function.
+ *
+ * Both sources are asked for candidates whose name, tags or ingredients match
+ * the query; every candidate is then scored by scoreRecipe(), so ranks are
+ * comparable across sources. Encyclopedia entries that were already imported
+ * into the user catalogue (same normalized name) are dropped in favour of the
+ * user's copy.
+ */
+class FederatedSearchService {
+   public:
+    /**
+     * @brief Called whenever a source has finished and its hits have been
+     *        merged. Receives the current top-K and the source that arrived.
+     *        Invoked from worker threads, one call at a time.
+     */
+    using UpdateCallback = std::function<void(
+        const std::vector<FederatedSearchHit>& topK, RecipeSource arrived)>;
+
+    FederatedSearchService(
+        const RecipeApp::RecipeManager& recipeManager,
+        const Encyclopedia::RecipeEncyclopediaManager& encyclopediaManager);
+
+    /**
+     * @brief Runs the query against both sources.
+     * @param query Search text (case-insensitive).
+     * @param topK Maximum number of hits to return (0 = all).
+     * @param onUpdate Optional callback for streaming partial results.
+     * @return Hits ordered by descending score; ties prefer the user
+     *         catalogue, then the name.
+     */
+    std::vector<FederatedSearchHit> search(
+        const std::string& query, std::size_t topK,
+        const UpdateCallback& onUpdate = nullptr) const;
+
+    /**
+     * @brief Shared relevance score: name matches weigh most (exact > prefix
+     *        > substring), then tags, then ingredients. 0 means no match.
+     */
+    static int scoreRecipe(const std::string& query,
+                           const RecipeApp::Recipe& recipe);
+
+    /**
+     * @brief Name key used for ranking and duplicate detection: ASCII
+     *        lowercased, trimmed, with the encyclopedia's "(百科)" suffix
+     *        removed.
+     */
+    static std::string normalizeName(const std::string& name);
+
+   private:
+    const RecipeApp::RecipeManager& m_recipeManager;
+    const Encyclopedia::RecipeEncyclopediaManager& m_encyclopediaManager;
+
+    std::vector<FederatedSearchHit> searchUserCatalogue(
+        const std::string& query) const;
+    std::vector<FederatedSearchHit> searchEncyclopedia(
+        const std::string& query) const;
+    bool isImported(const RecipeApp::Recipe& encyclopediaRecipe) const;
+};
+
+}  // namespace Search
+}  // namespace Logic
+}  // namespace RecipeApp
+
+#endif  // RECIPE_SEARCH_FEDERATED_SEARCH_SERVICE_H
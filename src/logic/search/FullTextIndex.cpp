@@ -0,0 +1,195 @@
+#include "FullTextIndex.h"
+
+#include <algorithm>
+#include <set>
+
+#include "Utf8.h"
+
+namespace RecipeApp {
+namespace Logic {
+namespace Search {
+
+namespace {
+// Word characters of whitespace-separated languages: ASCII alphanumerics
+// and Latin-1/Latin Extended-A letters.
+bool isWordChar(char32_t cp) {
+    return isAsciiWordChar(cp) ||
+           (cp >= 0xC0 && cp <= 0x24F && cp != 0xD7 && cp != 0xF7);
+}
+}  // namespace
+
+std::vector<FullTextIndex::Token> FullTextIndex::tokenize(
+    const std::string& text, TokenizeMode mode, std::uint32_t startPosition) {
+    std::vector<Token> tokens;
+    std::vector<CodePoint> cps = decodeUtf8(text);
+    std::uint32_t pos = startPosition;
+    std::size_t i = 0;
+    while (i < cps.size()) {
+        char32_t cp = cps[i].value;
+        if (isWordChar(cp)) {
+            std::string word;
+            for (; i < cps.size() && isWordChar(cps[i].value); ++i) {
+                appendUtf8(word, foldAscii(cps[i].value));
+            }
+            tokens.push_back({std::move(word), pos++});
+        } else if (isCjk(cp)) {
+            std::size_t runEnd = i;
+            while (runEnd < cps.size() && isCjk(cps[runEnd].value)) {
+                ++runEnd;
+            }
+            std::size_t runLength = runEnd - i;
+            for (std::size_t k = 0; k < runLength; ++k) {
+                const CodePoint& c = cps[i + k];
+                std::uint32_t at = pos + static_cast<std::uint32_t>(k);
+                if (mode == TokenizeMode::Index || runLength == 1) {
+                    tokens.push_back({text.substr(c.offset, c.length), at});
+                }
+                if (k + 1 < runLength) {
+                    const CodePoint& next = cps[i + k + 1];
+                    tokens.push_back(
+                        {text.substr(c.offset, c.length + next.length), at});
+                }
+            }
+            pos += static_cast<std::uint32_t>(runLength);
+            i = runEnd;
+        } else {
+            ++i;  // Whitespace and punctuation separate tokens
+        }
+    }
+    return tokens;
+}
+
+void FullTextIndex::addDocument(int docId,
+                                const std::vector<std::string>& fields) {
+    removeDocument(docId);
+
+    std::set<std::string> distinctTerms;
+    std::uint32_t nextPosition = 0;
+    for (const auto& field : fields) {
+        std::vector<Token> tokens =
+            tokenize(field, TokenizeMode::Index, nextPosition);
+        for (auto& token : tokens) {
+            m_postings[token.term][docId].push_back(token.position);
+            nextPosition = std::max(nextPosition, token.position + 2);
+            distinctTerms.insert(std::move(token.term));
+        }
+    }
+    m_docTerms[docId].assign(distinctTerms.begin(), distinctTerms.end());
+}
+
+void FullTextIndex::removeDocument(int docId) {
+    auto docIt = m_docTerms.find(docId);
+    if (docIt == m_docTerms.end()) {
+        return;
+    }
+    for (const auto& term : docIt->second) {
+        auto postingIt = m_postings.find(term);
+        if (postingIt != m_postings.end()) {
+            postingIt->second.erase(docId);
+            if (postingIt->second.empty()) {
+                m_postings.erase(postingIt);
+            }
+        }
+    }
+    m_docTerms.erase(docIt);
+}
+
+void FullTextIndex::clear() {
+    m_postings.clear();
+    m_docTerms.clear();
+}
+
+bool FullTextIndex::collectPostings(
+    const std::vector<Token>& tokens,
+    std::vector<const PostingList*>& lists) const {
+    lists.clear();
+    lists.reserve(tokens.size());
+    for (const auto& token : tokens) {
+        auto it = m_postings.find(token.term);
+        if (it == m_postings.end()) {
+            return false;
+        }
+        lists.push_back(&it->second);
+    }
+    return true;
+}
+
+std::vector<int> FullTextIndex::searchPhrase(const std::string& phrase) const {
+    std::vector<Token> tokens = tokenize(phrase, TokenizeMode::Query);
+    std::vector<const PostingList*> lists;
+    if (tokens.empty() || !collectPostings(tokens, lists)) {
+        return {};
+    }
+
+    // Drive the match from the rarest term.
+    std::size_t driver = 0;
+    for (std::size_t k = 1; k < lists.size(); ++k) {
+        if (lists[k]->size() < lists[driver]->size()) {
+            driver = k;
+        }
+    }
+
+    std::vector<int> result;
+    for (const auto& [docId, driverPositions] : *lists[driver]) {
+        // Look up this document in every other list once.
+        std::vector<const std::vector<std::uint32_t>*> docPositions(
+            lists.size());
+        bool present = true;
+        for (std::size_t k = 0; k < lists.size() && present; ++k) {
+            auto it = lists[k]->find(docId);
+            present = it != lists[k]->end();
+            if (present) {
+                docPositions[k] = &it->second;
+            }
+        }
+        if (!present) {
+            continue;
+        }
+
+        for (std::uint32_t p : driverPositions) {
+            if (p < tokens[driver].position) {
+                continue;
+            }
+            std::uint32_t base = p - tokens[driver].position;
+            bool matched = true;
+            for (std::size_t k = 0; k < tokens.size() && matched; ++k) {
+                matched = std::binary_search(docPositions[k]->begin(),
+                                             docPositions[k]->end(),
+                                             base + tokens[k].position);
+            }
+            if (matched) {
+                result.push_back(docId);
+                break;
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<int> FullTextIndex::searchAllTerms(const std::string& query) const {
+    std::vector<Token> tokens = tokenize(query, TokenizeMode::Query);
+    std::vector<const PostingList*> lists;
+    if (tokens.empty() || !collectPostings(tokens, lists)) {
+        return {};
+    }
+    std::sort(lists.begin(), lists.end(),
+              [](const PostingList* a, const PostingList* b) {
+                  return a->size() < b->size();
+              });
+
+    std::vector<int> result;
+    for (const auto& entry : *lists.front()) {
+        bool inAll = true;
+        for (std::size_t k = 1; k < lists.size() && inAll; ++k) {
+            inAll = lists[k]->count(entry.first) > 0;
+        }
+        if (inAll) {
+            result.push_back(entry.first);
+        }
+    }
+    return result;
+}
+
+}  // namespace Search
+}  // namespace Logic
+}  // namespace RecipeApp
@@ -0,0 +1,96 @@
+#ifndef RECIPE_SEARCH_FULL_TEXT_INDEX_H
+#define RECIPE_SEARCH_FULL_TEXT_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace RecipeApp {
+namespace Logic {
+namespace Search {
+
+/**
+ * @brief Positional inverted index over free text (e.g. recipe steps).
+ *
+ * Tokenization handles both whitespace-separated languages and CJK text:
+ * - runs of Latin letters/digits become one lowercased word token;
+ * - runs of CJK characters are segmented into overlapping bigrams. At index
+ *   time every character also gets a unigram at the same position so single
+ *   character queries (e.g. "炖") still match.
+ * Each character of a CJK run and each word occupies one position, so a
+ * query's tokens match a document when they occur at the same relative
+ * offsets (phrase query). Separate fields of a document are kept one
+ * position apart so phrases never span two fields.
+ */
+class FullTextIndex {
+   public:
+    struct Token {
+        std::string term;
+        std::uint32_t position;
+    };
+
+    enum class TokenizeMode {
+        Index,  ///< Bigrams plus unigrams for CJK runs
+        Query   ///< Bigrams only (unigram for single-character runs)
+    };
+
+    /**
+     * @brief Splits text into terms with their positions.
+     * @param text UTF-8 text.
+     * @param mode Whether the tokens are for indexing or for a query.
+     * @param startPosition Position assigned to the first token.
+     */
+    static std::vector<Token> tokenize(const std::string& text,
+                                       TokenizeMode mode,
+                                       std::uint32_t startPosition = 0);
+
+    /**
+     * @brief Indexes a document, replacing any previous version of it.
+     * @param docId Document identifier (e.g. recipe ID).
+     * @param fields Text fields of the document (e.g. each step).
+     */
+    void addDocument(int docId, const std::vector<std::string>& fields);
+
+    /**
+     * @brief Removes a document from the index. Unknown IDs are ignored.
+     */
+    void removeDocument(int docId);
+
+    void clear();
+
+    /**
+     * @brief Finds documents containing the query tokens at consecutive
+     *        positions (phrase match).
+     * @return Matching document IDs in ascending order.
+     */
+    std::vector<int> searchPhrase(const std::string& phrase) const;
+
+    /**
+     * @brief Finds documents containing every query token anywhere.
+     * @return Matching document IDs in ascending order.
+     */
+    std::vector<int> searchAllTerms(const std::string& query) const;
+
+    std::size_t documentCount() const { return m_docTerms.size(); }
+    std::size_t termCount() const { return m_postings.size(); }
+
+   private:
+    // term -> (docId -> sorted positions)
+    using PostingList = std::map<int, std::vector<std::uint32_t>>;
+    std::unordered_map<std::string, PostingList> m_postings;
+    // docId -> distinct terms, so documents can be removed without rescanning
+    std::unordered_map<int, std::vector<std::string>> m_docTerms;
+
+    // Resolves query tokens to posting lists; returns false if any is missing.
+    bool collectPostings(const std::vector<Token>& tokens,
+                         std::vector<const PostingList*>& lists) const;
+};
+
+}  // namespace Search
+}  // namespace Logic
+}  // namespace RecipeApp
+
+#endif  // RECIPE_SEARCH_FULL_TEXT_INDEX_H
@@ -0,0 +1,316 @@
+#include "GeoGridIndex.h"
+
+#include <algorithm>
+#include <cmath>
+#include <queue>
+#include <stdexcept>
+
+namespace RecipeApp {
+namespace Logic {
+namespace Search {
+
+namespace {
+bool hitBefore(const GeoGridIndex::Hit& a, const GeoGridIndex::Hit& b) {
+    if (a.distanceMeters != b.distanceMeters) {
+        return a.distanceMeters < b.distanceMeters;
+    }
+    return a.key < b.key;
+}
+
+double toDegrees(double radians) { return radians * 180.0 / GeoPoint::kPi; }
+
+// Longitude in [-180, 180), so +180 and -180 land in the same column.
+GeoPoint normalized(const GeoPoint& point) {
+    GeoPoint result = point;
+    if (result.longitude >= 180.0) {
+        result.longitude -= 360.0;
+    }
+    return result;
+}
+}  // namespace
+
+GeoGridIndex::GeoGridIndex(double cellDegrees) {
+    if (!(cellDegrees > 0.0) || cellDegrees > 180.0) {
+        throw std::invalid_argument("GeoGridIndex cell size must be in (0, 180] degrees.");
+    }
+    m_latCells = std::max(1, static_cast<int>(std::lround(180.0 / cellDegrees)));
+    m_lonCells = std::max(1, static_cast<int>(std::lround(360.0 / cellDegrees)));
+    m_cellLat = 180.0 / m_latCells;
+    m_cellLon = 360.0 / m_lonCells;
+}
+
+int GeoGridIndex::latCell(double latitude) const {
+    int cell = static_cast<int>(std::floor((latitude + 90.0) / m_cellLat));
+    return std::clamp(cell, 0, m_latCells - 1);
+}
+
+int GeoGridIndex::lonCell(double longitude) const {
+    int cell = static_cast<int>(std::floor((longitude + 180.0) / m_cellLon)) % m_lonCells;
+    return cell < 0 ? cell + m_lonCells : cell;
+}
+
+const std::vector<GeoGridIndex::Entry>* GeoGridIndex::cellAt(int latCell, int lonCell) const {
+    auto it = m_cells.find(cellKey(latCell, lonCell));
+    return it == m_cells.end() ? nullptr : &it->second;
+}
+
+void GeoGridIndex::insert(int key, const GeoPoint& point) {
+    if (!point.isValid()) {
+        throw std::invalid_argument("GeoGridIndex: coordinates out of range.");
+    }
+    remove(key);
+    GeoPoint stored = normalized(point);
+    m_cells[cellKey(latCell(stored.latitude), lonCell(stored.longitude))].push_back({key, stored});
+    m_positions.emplace(key, point);
+}
+
+void GeoGridIndex::remove(int key) {
+    auto position = m_positions.find(key);
+    if (position == m_positions.end()) {
+        return;
+    }
+    GeoPoint stored = normalized(position->second);
+    auto cell = m_cells.find(cellKey(latCell(stored.latitude), lonCell(stored.longitude)));
+    if (cell != m_cells.end()) {
+        auto& entries = cell->second;
+        auto it = std::find_if(entries.begin(), entries.end(),
+                               [key](const Entry& entry) { return entry.key == key; });
+        if (it != entries.end()) {
+            *it = entries.back();
+            entries.pop_back();
+        }
+        if (entries.empty()) {
+            m_cells.erase(cell);
+        }
+    }
+    m_positions.erase(position);
+}
+
+void GeoGridIndex::clear() {
+    m_cells.clear();
+    m_positions.clear();
+}
+
+std::optional<GeoPoint> GeoGridIndex::location(int key) const {
+    auto it = m_positions.find(key);
+    if (it == m_positions.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+void GeoGridIndex::forEachCellIn(
+    int firstLat, int lastLat, int firstLon, int lonCount,
+    const std::function<bool(const std::vector<Entry>&)>& visit) const {
+    if (firstLat > lastLat || lonCount <= 0) {
+        return;
+    }
+    auto rows = static_cast<std::size_t>(lastLat - firstLat + 1);
+    if (rows * static_cast<std::size_t>(lonCount) > m_cells.size()) {
+        // Fewer occupied cells than cells in the window: test those instead
+        for (const auto& [key, entries] : m_cells) {
+            int row = static_cast<int>(key / m_lonCells);
+            int column = static_cast<int>(key % m_lonCells);
+            int offset = ((column - firstLon) % m_lonCells + m_lonCells) % m_lonCells;
+            if (row >= firstLat && row <= lastLat && offset < lonCount && !visit(entries)) {
+                return;
+            }
+        }
+        return;
+    }
+    for (int row = firstLat; row <= lastLat; ++row) {
+        for (int i = 0; i < lonCount; ++i) {
+            const auto* entries = cellAt(row, (firstLon + i) % m_lonCells);
+            if (entries && !visit(*entries)) {
+                return;
+            }
+        }
+    }
+}
+
+std::vector<GeoGridIndex::Hit> GeoGridIndex::nearest(const GeoPoint& origin, std::size_t k,
+                                                     double maxDistanceMeters,
+                                                     const KeyFilter& accept) const {
+    if (k == 0 || m_cells.empty() || !origin.isValid()) {
+        return {};
+    }
+    const GeoPoint o = normalized(origin);
+    // Max-heap on (distance, key): the top is the worst of the current best k
+    std::priority_queue<Hit, std::vector<Hit>, decltype(&hitBefore)> best(hitBefore);
+    auto consider = [&](const std::vector<Entry>& entries) {
+        for (const auto& entry : entries) {
+            if (accept && !accept(entry.key)) {
+                continue;
+            }
+            Hit hit{entry.key, GeoPoint::distanceMeters(o, entry.point)};
+            if (hit.distanceMeters > maxDistanceMeters) {
+                continue;
+            }
+            if (best.size() < k) {
+                best.push(hit);
+            } else if (hitBefore(hit, best.top())) {
+                best.pop();
+                best.push(hit);
+            }
+        }
+    };
+
+    const int centerLat = latCell(o.latitude);
+    const int centerLon = lonCell(o.longitude);
+    const double cosOrigin = std::cos(GeoPoint::toRadians(o.latitude));
+    std::size_t cellsVisited = 0;
+    for (int r = 0;; ++r) {
+        std::size_t ringCells = r == 0 ? 1 : 8 * static_cast<std::size_t>(r);
+        if (2 * r + 1 > m_lonCells || cellsVisited + ringCells > m_cells.size()) {
+            // Cheaper to finish with the occupied cells outside rings 0..r-1
+            for (const auto& [key, entries] : m_cells) {
+                int dLat = std::abs(static_cast<int>(key / m_lonCells) - centerLat);
+                int dLon = std::abs(static_cast<int>(key % m_lonCells) - centerLon);
+                dLon = std::min(dLon, m_lonCells - dLon);
+                if (std::max(dLat, dLon) >= r) {
+                    consider(entries);
+                }
+            }
+            break;
+        }
+
+        for (int dLat = -r; dLat <= r; ++dLat) {
+            int row = centerLat + dLat;
+            if (row < 0 || row >= m_latCells) {
+                continue;
+            }
+            int step = (std::abs(dLat) == r || r == 0) ? 1 : 2 * r;
+            for (int dLon = -r; dLon <= r; dLon += step) {
+                int column = ((centerLon + dLon) % m_lonCells + m_lonCells) % m_lonCells;
+                if (const auto* entries = cellAt(row, column)) {
+                    consider(*entries);
+                }
+            }
+        }
+        cellsVisited += ringCells;
+
+        // Lower bound on the distance to any point outside rings 0..r. A point
+        // beyond the visited rows differs in latitude by at least the gap; one
+        // in those rows but beyond the visited columns differs in longitude by
+        // at least dLon, and haversine gives d >= 2*asin(sqrt(cos(lat1) *
+        // cos(lat2)) * sin(dLon/2)) with cos(lat2) minimal at the band's edge.
+        const int southRow = centerLat - r;
+        const int northRow = centerLat + r;
+        const double south = southRow * m_cellLat - 90.0;
+        const double north = (northRow + 1) * m_cellLat - 90.0;
+        double bound = std::numeric_limits<double>::infinity();
+        if (southRow > 0) {
+            bound = std::min(bound, GeoPoint::toRadians(o.latitude - south) *
+                                        GeoPoint::kEarthRadiusMeters);
+        }
+        if (northRow < m_latCells - 1) {
+            bound = std::min(bound, GeoPoint::toRadians(north - o.latitude) *
+                                        GeoPoint::kEarthRadiusMeters);
+        }
+        if (2 * r + 1 < m_lonCells) {
+            double cellWest = std::floor((o.longitude + 180.0) / m_cellLon) * m_cellLon - 180.0;
+            double west = cellWest - r * m_cellLon;
+            double east = cellWest + (r + 1) * m_cellLon;
+            double dLon = std::min(o.longitude - west, east - o.longitude);
+            double widest = std::min(90.0, std::max(std::abs(std::max(south, -90.0)),
+                                                    std::abs(std::min(north, 90.0))));
+            double c = std::max(0.0, cosOrigin * std::cos(GeoPoint::toRadians(widest)));
+            double s = std::sin(std::min(GeoPoint::kPi, GeoPoint::toRadians(dLon)) / 2);
+            bound = std::min(bound, 2 * GeoPoint::kEarthRadiusMeters *
+                                        std::asin(std::min(1.0, std::sqrt(c) * s)));
+        }
+        if (std::isinf(bound) || bound > maxDistanceMeters ||
+            (best.size() == k && bound > best.top().distanceMeters)) {
+            break;
+        }
+    }
+
+    std::vector<Hit> hits;
+    hits.reserve(best.size());
+    while (!best.empty()) {
+        hits.push_back(best.top());
+        best.pop();
+    }
+    std::reverse(hits.begin(), hits.end());
+    return hits;
+}
+
+std::vector<GeoGridIndex::Hit> GeoGridIndex::withinRadius(const GeoPoint& origin,
+                                                          double radiusMeters) const {
+    std::vector<Hit> hits;
+    if (!(radiusMeters >= 0.0) || !origin.isValid()) {
+        return hits;
+    }
+    const GeoPoint o = normalized(origin);
+    const double angle = radiusMeters / GeoPoint::kEarthRadiusMeters;
+    const double south = o.latitude - toDegrees(angle);
+    const double north = o.latitude + toDegrees(angle);
+
+    int firstLon = 0;
+    int lonCount = m_lonCells;
+    // Longitude half-width of a spherical cap: asin(sin(angle) / cos(lat))
+    double ratio = std::sin(angle) / std::cos(GeoPoint::toRadians(o.latitude));
+    if (south > -90.0 && north < 90.0 && angle < GeoPoint::kPi / 2 && ratio < 1.0) {
+        double halfWidth = toDegrees(std::asin(ratio));
+        int first = static_cast<int>(std::floor((o.longitude - halfWidth + 180.0) / m_cellLon));
+        int last = static_cast<int>(std::floor((o.longitude + halfWidth + 180.0) / m_cellLon));
+        lonCount = std::min(m_lonCells, last - first + 1);
+        firstLon = ((first % m_lonCells) + m_lonCells) % m_lonCells;
+    }
+
+    forEachCellIn(latCell(std::max(south, -90.0)), latCell(std::min(north, 90.0)), firstLon,
+                  lonCount, [&](const std::vector<Entry>& entries) {
+                      for (const auto& entry : entries) {
+                          double distance = GeoPoint::distanceMeters(o, entry.point);
+                          if (distance <= radiusMeters) {
+                              hits.push_back({entry.key, distance});
+                          }
+                      }
+                      return true;
+                  });
+    std::sort(hits.begin(), hits.end(), hitBefore);
+    return hits;
+}
+
+std::vector<int> GeoGridIndex::withinBounds(double south, double west, double north,
+                                            double east, std::size_t limit) const {
+    std::vector<int> keys;
+    south = std::max(south, -90.0);
+    north = std::min(north, 90.0);
+    if (!(south <= north) || !std::isfinite(west) || !std::isfinite(east)) {
+        return keys;
+    }
+    const bool wraps = west > east;
+    int first = static_cast<int>(std::floor((west + 180.0) / m_cellLon));
+    int last = static_cast<int>(std::floor(((wraps ? east + 360.0 : east) + 180.0) / m_cellLon));
+    int lonCount = std::min(m_lonCells, last - first + 1);
+    int firstLon = ((first % m_lonCells) + m_lonCells) % m_lonCells;
+
+    auto inside = [&](const GeoPoint& point) {
+        if (point.latitude < south || point.latitude > north) {
+            return false;
+        }
+        // Stored longitudes are in [-180, 180), so also test the +180 alias
+        auto inLon = [&](double lon) {
+            return wraps ? (lon >= west || lon <= east) : (lon >= west && lon <= east);
+        };
+        return inLon(point.longitude) || (point.longitude == -180.0 && inLon(180.0));
+    };
+    forEachCellIn(latCell(south), latCell(north), firstLon, lonCount,
+                  [&](const std::vector<Entry>& entries) {
+                      for (const auto& entry : entries) {
+                          if (inside(entry.point)) {
+                              keys.push_back(entry.key);
+                              if (limit && keys.size() == limit) {
+                                  return false;
+                              }
+                          }
+                      }
+                      return true;
+                  });
+    return keys;
+}
+
+}  // namespace Search
+}  // namespace Logic
+}  // namespace RecipeApp
@@ -0,0 +1,111 @@
+#ifndef RECIPE_SEARCH_GEO_GRID_INDEX_H
+#define RECIPE_SEARCH_GEO_GRID_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "../../domain/restaurant/GeoPoint.h"
+
+namespace RecipeApp {
+namespace Logic {
+namespace Search {
+
+/**
+ * @brief Uniform latitude/longitude grid over keyed points, for k-nearest,
+ *        radius and bounding-box queries.
+ *
+ * Only occupied cells are stored (hashed by cell number), so memory is
+ * O(points) whatever the cell size. Queries visit the cells around the query
+ * point ring by ring and stop as soon as no unvisited cell can hold a closer
+ * point; the lower bound for that is a true great-circle bound, so results
+ * are exact at any latitude and across the antimeridian. When a query would
+ * touch more cells than are occupied, it scans the occupied cells instead,
+ * which bounds its cost for sparse data.
+ */
+class GeoGridIndex {
+   public:
+    struct Hit {
+        int key;
+        double distanceMeters;
+    };
+
+    /// A predicate restricting nearest() to some keys.
+    using KeyFilter = std::function<bool(int key)>;
+
+    /**
+     * @param cellDegrees Approximate cell edge in degrees. The default
+     *        (~1.1 km north-south) suits city-level queries.
+     */
+    explicit GeoGridIndex(double cellDegrees = 0.01);
+
+    /// Indexes a point, replacing any previous position of the key.
+    void insert(int key, const GeoPoint& point);
+
+    /// Removes a key. Unknown keys are ignored.
+    void remove(int key);
+
+    void clear();
+
+    std::size_t size() const { return m_positions.size(); }
+
+    std::optional<GeoPoint> location(int key) const;
+
+    /**
+     * @brief The k points closest to origin, nearest first (ties by key).
+     * @param maxDistanceMeters Points further away are ignored.
+     * @param accept Optional filter; rejected keys are skipped.
+     */
+    std::vector<Hit> nearest(
+        const GeoPoint& origin, std::size_t k,
+        double maxDistanceMeters = std::numeric_limits<double>::infinity(),
+        const KeyFilter& accept = nullptr) const;
+
+    /// All points within radiusMeters of origin, nearest first.
+    std::vector<Hit> withinRadius(const GeoPoint& origin,
+                                  double radiusMeters) const;
+
+    /**
+     * @brief Keys of the points inside a latitude/longitude box, in no
+     *        particular order. west > east means the box crosses the
+     *        antimeridian.
+     * @param limit Stop after this many keys (0 = no limit).
+     */
+    std::vector<int> withinBounds(double south, double west, double north,
+                                  double east, std::size_t limit = 0) const;
+
+   private:
+    struct Entry {
+        int key;
+        GeoPoint point;
+    };
+
+    int m_latCells;
+    int m_lonCells;
+    double m_cellLat;  ///< Cell height in degrees (180 / m_latCells)
+    double m_cellLon;  ///< Cell width in degrees (360 / m_lonCells)
+    std::unordered_map<std::int64_t, std::vector<Entry>> m_cells;
+    std::unordered_map<int, GeoPoint> m_positions;
+
+    int latCell(double latitude) const;
+    int lonCell(double longitude) const;
+    std::int64_t cellKey(int latCell, int lonCell) const {
+        return static_cast<std::int64_t>(latCell) * m_lonCells + lonCell;
+    }
+    const std::vector<Entry>* cellAt(int latCell, int lonCell) const;
+
+    // Calls visit(entries) for every occupied cell in the rows/columns given
+    // (columns wrap; lonCount may not exceed m_lonCells).
+    void forEachCellIn(int firstLat, int lastLat, int firstLon, int lonCount,
+                       const std::function<bool(const std::vector<Entry>&)>& visit) const;
+};
+
+}  // namespace Search
+}  // namespace Logic
+}  // namespace RecipeApp
+
+#endif  // RECIPE_SEARCH_GEO_GRID_INDEX_H
@@ -0,0 +1,164 @@
+#include "IdPositionIndex.h"
+
+#include <algorithm>
+
+namespace RecipeApp {
+namespace Logic {
+namespace Search {
+
+namespace {
+// A dense table is used while the ID span stays within this factor of the
+// record count (plus some slack for tiny collections).
+constexpr std::size_t kMaxDenseSpanFactor = 2;
+constexpr std::size_t kDenseSlack = 64;
+
+// Serialized layout: u32 layout, u32 ID count, then
+//   dense:  u64 base (two's complement), u32 slot count, u32 per slot
+//   sparse: (i32 id, u32 position) per ID, ascending by ID
+constexpr std::uint32_t kDenseLayout = 0;
+constexpr std::uint32_t kSparseLayout = 1;
+constexpr std::size_t kHeaderSize = 8;
+constexpr std::size_t kDenseHeaderSize = kHeaderSize + 12;
+constexpr std::size_t kSparseEntrySize = 8;
+}  // namespace
+
+void IdPositionIndex::build(const std::vector<int>& ids) {
+    clear();
+    if (ids.empty()) {
+        return;
+    }
+
+    auto [minIt, maxIt] = std::minmax_element(ids.begin(), ids.end());
+    std::uint64_t span = static_cast<std::uint64_t>(
+                             static_cast<std::int64_t>(*maxIt) - *minIt) +
+                         1;
+    m_dense = ids.size() < std::numeric_limits<std::uint32_t>::max() &&
+              span <= ids.size() * kMaxDenseSpanFactor + kDenseSlack;
+
+    if (m_dense) {
+        m_base = *minIt;
+        m_offsets.assign(static_cast<std::size_t>(span), 0);
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            std::uint32_t& slot = m_offsets[static_cast<std::size_t>(ids[i] - m_base)];
+            if (slot == 0) {
+                slot = static_cast<std::uint32_t>(i + 1);
+                ++m_size;
+            }
+        }
+    } else {
+        m_sparse.reserve(ids.size());
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            m_sparse.emplace(ids[i], i);
+        }
+        m_size = m_sparse.size();
+    }
+}
+
+void IdPositionIndex::serialize(Common::ByteWriter& writer) const {
+    if (m_attached) {
+        writer.writeBytes(m_bytes);
+        return;
+    }
+    writer.writeU32(m_dense ? kDenseLayout : kSparseLayout);
+    writer.writeU32(static_cast<std::uint32_t>(m_size));
+    if (m_dense) {
+        writer.writeU64(static_cast<std::uint64_t>(m_base));
+        writer.writeU32(static_cast<std::uint32_t>(m_offsets.size()));
+        for (std::uint32_t slot : m_offsets) {
+            writer.writeU32(slot);
+        }
+        return;
+    }
+    std::vector<std::pair<int, std::size_t>> entries(m_sparse.begin(),
+                                                     m_sparse.end());
+    std::sort(entries.begin(), entries.end());
+    for (const auto& [id, position] : entries) {
+        writer.writeI32(id);
+        writer.writeU32(static_cast<std::uint32_t>(position));
+    }
+}
+
+bool IdPositionIndex::attach(std::string_view bytes,
+                             std::size_t positionCount) {
+    clear();
+    if (bytes.size() < kHeaderSize) {
+        return false;
+    }
+    std::uint32_t layout = Common::loadU32(bytes.data());
+    std::uint32_t count = Common::loadU32(bytes.data() + 4);
+    if (layout == kDenseLayout) {
+        if (bytes.size() < kDenseHeaderSize) {
+            return false;
+        }
+        std::uint32_t slots = Common::loadU32(bytes.data() + kHeaderSize + 8);
+        if (bytes.size() - kDenseHeaderSize != std::uint64_t{slots} * 4) {
+            return false;
+        }
+        m_dense = true;
+        m_base = static_cast<std::int64_t>(
+            Common::loadU64(bytes.data() + kHeaderSize));
+        m_table = bytes.substr(kDenseHeaderSize);
+    } else if (layout == kSparseLayout) {
+        if (bytes.size() - kHeaderSize !=
+            std::uint64_t{count} * kSparseEntrySize) {
+            return false;
+        }
+        m_table = bytes.substr(kHeaderSize);
+    } else {
+        return false;
+    }
+    m_attached = true;
+    m_bytes = bytes;
+    m_size = count;
+    m_positionCount = positionCount;
+    return true;
+}
+
+std::size_t IdPositionIndex::findAttached(int id) const {
+    std::uint32_t stored = 0;
+    if (m_dense) {
+        std::int64_t slot = static_cast<std::int64_t>(id) - m_base;
+        if (slot < 0 || slot >= static_cast<std::int64_t>(m_table.size() / 4)) {
+            return npos;
+        }
+        stored = Common::loadU32(m_table.data() + 4 * slot);
+        if (stored == 0) {
+            return npos;
+        }
+        --stored;
+    } else {
+        // Binary search over the ID-sorted pairs
+        std::size_t low = 0;
+        std::size_t high = m_size;
+        while (low < high) {
+            std::size_t mid = low + (high - low) / 2;
+            int midId = Common::loadI32(m_table.data() + mid * kSparseEntrySize);
+            if (midId < id) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        if (low == m_size ||
+            Common::loadI32(m_table.data() + low * kSparseEntrySize) != id) {
+            return npos;
+        }
+        stored = Common::loadU32(m_table.data() + low * kSparseEntrySize + 4);
+    }
+    return stored < m_positionCount ? stored : npos;
+}
+
+void IdPositionIndex::clear() {
+    m_attached = false;
+    m_bytes = m_table = std::string_view();
+    m_positionCount = 0;
+    m_dense = false;
+    m_base = 0;
+    m_offsets.clear();
+    m_sparse.clear();
+    m_size = 0;
+}
+
+}  // namespace Search
+}  // namespace Logic
+}  // namespace RecipeApp
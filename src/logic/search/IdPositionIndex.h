@@ -0,0 +1,97 @@
+#ifndef RECIPE_SEARCH_ID_POSITION_INDEX_H
+#define RECIPE_SEARCH_ID_POSITION_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "../../common/BinaryCodec.h"
+
+namespace RecipeApp {
+namespace Logic {
+namespace Search {
+
+/**
+ * @brief Maps record IDs to their position in a record array.
+ *
+ * When the IDs are compact (e.g. the 1001+ range of the encyclopedia), a
+ * dense offset table indexed by (id - minId) is used, so a lookup is one
+ * bounds check and one array read. Otherwise it falls back to a hash map.
+ *
+ * The index can also be written out and later attached to those bytes (e.g.
+ * inside a mapped file), in which case lookups read the table in place: the
+ * dense table as is, the sparse form as ID-sorted (id, position) pairs.
+ */
+class IdPositionIndex {
+   public:
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    /**
+     * @brief Rebuilds the index. Position i is assigned to ids[i]; for
+     *        duplicate IDs the first occurrence wins.
+     */
+    void build(const std::vector<int>& ids);
+
+    /**
+     * @brief Writes the index in the layout attach() reads.
+     */
+    void serialize(Common::ByteWriter& writer) const;
+
+    /**
+     * @brief Replaces the contents with a view of bytes written by
+     *        serialize(). Nothing is copied, so the bytes must outlive the
+     *        index (or the next build()/clear()).
+     * @param positionCount Positions at or beyond this are treated as
+     *        missing, so a corrupt table cannot yield out-of-range positions.
+     * @return False (leaving the index empty) if the sizes do not add up.
+     */
+    bool attach(std::string_view bytes, std::size_t positionCount);
+
+    /**
+     * @brief Returns the position of an ID, or npos if it is not indexed.
+     */
+    std::size_t find(int id) const {
+        if (m_attached) {
+            return findAttached(id);
+        }
+        if (m_dense) {
+            std::int64_t slot = static_cast<std::int64_t>(id) - m_base;
+            if (slot < 0 || slot >= static_cast<std::int64_t>(m_offsets.size())) {
+                return npos;
+            }
+            std::uint32_t stored = m_offsets[static_cast<std::size_t>(slot)];
+            return stored == 0 ? npos : stored - 1;
+        }
+        auto it = m_sparse.find(id);
+        return it == m_sparse.end() ? npos : it->second;
+    }
+
+    void clear();
+
+    bool isDense() const { return m_dense; }
+    std::size_t size() const { return m_size; }
+
+   private:
+    bool m_dense = false;
+    std::int64_t m_base = 0;
+    std::vector<std::uint32_t> m_offsets;  ///< position + 1, 0 = empty slot
+    std::unordered_map<int, std::size_t> m_sparse;
+    std::size_t m_size = 0;
+
+    // Attached mode: the serialized form, minus its header
+    bool m_attached = false;
+    std::string_view m_bytes;
+    std::string_view m_table;
+    std::size_t m_positionCount = 0;
+
+    std::size_t findAttached(int id) const;
+};
+
+}  // namespace Search
+}  // namespace Logic
+}  // namespace RecipeApp
+
+#endif  // RECIPE_SEARCH_ID_POSITION_INDEX_H
@@ -0,0 +1,449 @@
+#include "NGramIndex.h"
+
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+#include <map>
+
+#include "Utf8.h"
+
+namespace RecipeApp {
+namespace Logic {
+namespace Search {
+
+namespace {
+std::string toLower(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    return s;
+}
+
+constexpr std::uint64_t kBigramFlag = 1ull << 63;
+
+// Serialized layout: header of four u32 counts, then fixed-size entries
+constexpr std::size_t kAttachedHeaderSize = 16;
+constexpr std::size_t kDocEntrySize = 8;    // i32 docKey, u32 first field
+constexpr std::size_t kFieldRefSize = 8;    // u32 offset, u32 length
+constexpr std::size_t kGramEntrySize = 12;  // u64 gram, u32 first posting
+constexpr std::size_t kPostingSize = 4;     // i32 docKey
+constexpr std::size_t kNoSlot = static_cast<std::size_t>(-1);
+
+std::uint64_t unigramKey(char32_t cp) { return cp; }
+
+std::uint64_t bigramKey(char32_t first, char32_t second) {
+    return kBigramFlag | (static_cast<std::uint64_t>(first) << 21) | second;
+}
+
+void insertSorted(std::vector<int>& postings, int docKey) {
+    if (postings.empty() || postings.back() < docKey) {
+        postings.push_back(docKey);  // Common case: keys added in order
+        return;
+    }
+    auto pos = std::lower_bound(postings.begin(), postings.end(), docKey);
+    if (pos == postings.end() || *pos != docKey) {
+        postings.insert(pos, docKey);
+    }
+}
+}  // namespace
+
+std::vector<std::uint64_t> NGramIndex::gramsOf(const std::string& loweredText) {
+    std::vector<CodePoint> cps = decodeUtf8(loweredText);
+    std::vector<std::uint64_t> grams;
+    grams.reserve(cps.size() * 2);
+    for (std::size_t i = 0; i < cps.size(); ++i) {
+        grams.push_back(unigramKey(cps[i].value));
+        if (i + 1 < cps.size()) {
+            grams.push_back(bigramKey(cps[i].value, cps[i + 1].value));
+        }
+    }
+    return grams;
+}
+
+void NGramIndex::addDocument(int docKey,
+                             const std::vector<std::string>& fields) {
+    removeDocument(docKey);
+
+    std::vector<std::string> lowered;
+    lowered.reserve(fields.size());
+    std::vector<std::uint64_t> docGrams;
+    for (const auto& field : fields) {
+        lowered.push_back(toLower(field));
+        std::vector<std::uint64_t> grams = gramsOf(lowered.back());
+        docGrams.insert(docGrams.end(), grams.begin(), grams.end());
+    }
+    std::sort(docGrams.begin(), docGrams.end());
+    docGrams.erase(std::unique(docGrams.begin(), docGrams.end()),
+                   docGrams.end());
+    for (std::uint64_t gram : docGrams) {
+        insertSorted(m_postings[gram], docKey);
+    }
+    m_fields[docKey] = std::move(lowered);
+}
+
+void NGramIndex::removeDocument(int docKey) {
+    if (attachedSlot(docKey) != kNoSlot) {
+        m_hidden.insert(docKey);
+    }
+    auto docIt = m_fields.find(docKey);
+    if (docIt == m_fields.end()) {
+        return;
+    }
+    for (const auto& field : docIt->second) {
+        for (std::uint64_t gram : gramsOf(field)) {
+            auto postingIt = m_postings.find(gram);
+            if (postingIt == m_postings.end()) {
+                continue;  // Already removed via an earlier field
+            }
+            auto& postings = postingIt->second;
+            auto pos = std::lower_bound(postings.begin(), postings.end(), docKey);
+            if (pos != postings.end() && *pos == docKey) {
+                postings.erase(pos);
+            }
+            if (postings.empty()) {
+                m_postings.erase(postingIt);
+            }
+        }
+    }
+    m_fields.erase(docIt);
+}
+
+void NGramIndex::clear() {
+    m_postings.clear();
+    m_fields.clear();
+    m_attachedDocs = m_attachedFields = m_attachedGrams = m_attachedPostings =
+        m_stringPool = std::string_view();
+    m_attachedDocCount = 0;
+    m_hidden.clear();
+}
+
+void NGramIndex::serialize(Common::ByteWriter& writer,
+                           const Common::StringRefWriter& writeRef) const {
+    std::vector<int> keys = allKeys();
+    std::string docs;
+    std::string fieldRefs;
+    Common::ByteWriter docWriter(docs);
+    Common::ByteWriter fieldWriter(fieldRefs);
+    std::uint32_t fieldCount = 0;
+    // Ordered, and keys are visited in ascending order, so the same
+    // collection always serializes to the same bytes.
+    std::map<std::uint64_t, std::vector<int>> postings;
+    for (int docKey : keys) {
+        docWriter.writeI32(docKey);
+        docWriter.writeU32(fieldCount);
+        std::vector<std::uint64_t> docGrams;
+        for (std::string_view field : fieldsOf(docKey)) {
+            writeRef(fieldWriter, field);
+            ++fieldCount;
+            std::vector<std::uint64_t> grams = gramsOf(std::string(field));
+            docGrams.insert(docGrams.end(), grams.begin(), grams.end());
+        }
+        std::sort(docGrams.begin(), docGrams.end());
+        docGrams.erase(std::unique(docGrams.begin(), docGrams.end()),
+                       docGrams.end());
+        for (std::uint64_t gram : docGrams) {
+            postings[gram].push_back(docKey);
+        }
+    }
+
+    std::size_t postingCount = 0;
+    for (const auto& entry : postings) {
+        postingCount += entry.second.size();
+    }
+    writer.writeU32(static_cast<std::uint32_t>(keys.size()));
+    writer.writeU32(fieldCount);
+    writer.writeU32(static_cast<std::uint32_t>(postings.size()));
+    writer.writeU32(static_cast<std::uint32_t>(postingCount));
+    writer.writeBytes(docs);
+    writer.writeBytes(fieldRefs);
+    std::uint32_t firstPosting = 0;
+    for (const auto& [gram, docKeys] : postings) {
+        writer.writeU64(gram);
+        writer.writeU32(firstPosting);
+        firstPosting += static_cast<std::uint32_t>(docKeys.size());
+    }
+    for (const auto& entry : postings) {
+        for (int docKey : entry.second) {
+            writer.writeI32(docKey);
+        }
+    }
+}
+
+bool NGramIndex::attach(std::string_view bytes, std::string_view stringPool) {
+    clear();
+    if (bytes.size() < kAttachedHeaderSize) {
+        return false;
+    }
+    std::uint64_t docCount = Common::loadU32(bytes.data());
+    std::uint64_t fieldCount = Common::loadU32(bytes.data() + 4);
+    std::uint64_t gramCount = Common::loadU32(bytes.data() + 8);
+    std::uint64_t postingCount = Common::loadU32(bytes.data() + 12);
+    if (bytes.size() != kAttachedHeaderSize + docCount * kDocEntrySize +
+                            fieldCount * kFieldRefSize +
+                            gramCount * kGramEntrySize +
+                            postingCount * kPostingSize) {
+        return false;
+    }
+    std::size_t offset = kAttachedHeaderSize;
+    auto section = [&](std::uint64_t count, std::size_t entrySize) {
+        std::string_view view = bytes.substr(offset, count * entrySize);
+        offset += view.size();
+        return view;
+    };
+    m_attachedDocs = section(docCount, kDocEntrySize);
+    m_attachedFields = section(fieldCount, kFieldRefSize);
+    m_attachedGrams = section(gramCount, kGramEntrySize);
+    m_attachedPostings = section(postingCount, kPostingSize);
+    m_stringPool = stringPool;
+    m_attachedDocCount = docCount;
+    return true;
+}
+
+std::size_t NGramIndex::attachedSlot(int docKey) const {
+    std::size_t low = 0;
+    std::size_t high = m_attachedDocCount;
+    while (low < high) {
+        std::size_t mid = low + (high - low) / 2;
+        if (attachedKey(mid) < docKey) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low < m_attachedDocCount && attachedKey(low) == docKey ? low
+                                                                  : kNoSlot;
+}
+
+int NGramIndex::attachedKey(std::size_t slot) const {
+    return Common::loadI32(m_attachedDocs.data() + slot * kDocEntrySize);
+}
+
+std::pair<std::size_t, std::size_t> NGramIndex::attachedRange(
+    std::string_view table, std::size_t entrySize, std::size_t slot,
+    std::size_t firstOffset, std::size_t limit) const {
+    const char* entry = table.data() + slot * entrySize;
+    std::size_t first = Common::loadU32(entry + firstOffset);
+    std::size_t end = (slot + 1) * entrySize < table.size()
+                          ? Common::loadU32(entry + entrySize + firstOffset)
+                          : limit;
+    if (first > end || end > limit) {
+        return {0, 0};  // Corrupt; treat as empty
+    }
+    return {first, end};
+}
+
+std::vector<std::string_view> NGramIndex::attachedFieldsOf(
+    std::size_t slot) const {
+    auto [first, end] =
+        attachedRange(m_attachedDocs, kDocEntrySize, slot, 4,
+                      m_attachedFields.size() / kFieldRefSize);
+    std::vector<std::string_view> fields;
+    fields.reserve(end - first);
+    for (std::size_t f = first; f < end; ++f) {
+        const char* ref = m_attachedFields.data() + f * kFieldRefSize;
+        std::size_t offset = Common::loadU32(ref);
+        std::size_t length = Common::loadU32(ref + 4);
+        if (offset > m_stringPool.size() ||
+            length > m_stringPool.size() - offset) {
+            fields.emplace_back();
+        } else {
+            fields.push_back(m_stringPool.substr(offset, length));
+        }
+    }
+    return fields;
+}
+
+std::vector<std::string_view> NGramIndex::fieldsOf(int docKey) const {
+    auto docIt = m_fields.find(docKey);
+    if (docIt != m_fields.end()) {
+        return {docIt->second.begin(), docIt->second.end()};
+    }
+    std::size_t slot = attachedSlot(docKey);
+    if (slot == kNoSlot) {
+        return {};
+    }
+    return attachedFieldsOf(slot);
+}
+
+std::vector<int> NGramIndex::allKeys() const {
+    std::vector<int> keys;
+    keys.reserve(size());
+    for (std::size_t slot = 0; slot < m_attachedDocCount; ++slot) {
+        int docKey = attachedKey(slot);
+        if (!m_hidden.count(docKey)) {
+            keys.push_back(docKey);
+        }
+    }
+    std::size_t attachedEnd = keys.size();
+    for (const auto& entry : m_fields) {
+        keys.push_back(entry.first);
+    }
+    std::inplace_merge(keys.begin(), keys.begin() + attachedEnd, keys.end());
+    return keys;
+}
+
+std::vector<int> NGramIndex::candidates(
+    const std::vector<CodePoint>& queryCps) const {
+    std::vector<std::uint64_t> queryGrams;
+    if (queryCps.size() == 1) {
+        queryGrams.push_back(unigramKey(queryCps[0].value));
+    } else {
+        for (std::size_t i = 0; i + 1 < queryCps.size(); ++i) {
+            queryGrams.push_back(
+                bigramKey(queryCps[i].value, queryCps[i + 1].value));
+        }
+    }
+
+    // In-memory documents: posting lists of the query grams, rarest first.
+    std::vector<int> inMemory;
+    std::vector<const std::vector<int>*> lists;
+    for (std::uint64_t gram : queryGrams) {
+        auto it = m_postings.find(gram);
+        if (it == m_postings.end()) {
+            lists.clear();
+            break;
+        }
+        lists.push_back(&it->second);
+    }
+    std::sort(lists.begin(), lists.end(),
+              [](const std::vector<int>* a, const std::vector<int>* b) {
+                  return a->size() < b->size();
+              });
+    if (!lists.empty()) {
+        for (int docKey : *lists.front()) {
+            bool inAll = true;
+            for (std::size_t k = 1; k < lists.size() && inAll; ++k) {
+                inAll = std::binary_search(lists[k]->begin(), lists[k]->end(),
+                                           docKey);
+            }
+            if (inAll) {
+                inMemory.push_back(docKey);
+            }
+        }
+    }
+
+    // Attached documents: the same, over ranges of the flat posting array.
+    std::vector<int> attached;
+    std::vector<std::pair<std::size_t, std::size_t>> ranges;
+    std::size_t gramCount = m_attachedGrams.size() / kGramEntrySize;
+    std::size_t postingCount = m_attachedPostings.size() / kPostingSize;
+    for (std::uint64_t gram : queryGrams) {
+        std::size_t low = 0;
+        std::size_t high = gramCount;
+        while (low < high) {
+            std::size_t mid = low + (high - low) / 2;
+            if (Common::loadU64(m_attachedGrams.data() + mid * kGramEntrySize) <
+                gram) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+        if (low == gramCount ||
+            Common::loadU64(m_attachedGrams.data() + low * kGramEntrySize) !=
+                gram) {
+            ranges.clear();
+            break;
+        }
+        ranges.push_back(attachedRange(m_attachedGrams, kGramEntrySize, low, 8,
+                                       postingCount));
+    }
+    std::sort(ranges.begin(), ranges.end(), [](const auto& a, const auto& b) {
+        return a.second - a.first < b.second - b.first;
+    });
+    auto postingAt = [this](std::size_t i) {
+        return Common::loadI32(m_attachedPostings.data() + i * kPostingSize);
+    };
+    if (!ranges.empty()) {
+        for (std::size_t i = ranges.front().first; i < ranges.front().second;
+             ++i) {
+            int docKey = postingAt(i);
+            if (m_hidden.count(docKey)) {
+                continue;
+            }
+            bool inAll = true;
+            for (std::size_t k = 1; k < ranges.size() && inAll; ++k) {
+                std::size_t low = ranges[k].first;
+                std::size_t high = ranges[k].second;
+                while (low < high) {
+                    std::size_t mid = low + (high - low) / 2;
+                    if (postingAt(mid) < docKey) {
+                        low = mid + 1;
+                    } else {
+                        high = mid;
+                    }
+                }
+                inAll = low < ranges[k].second && postingAt(low) == docKey;
+            }
+            if (inAll) {
+                attached.push_back(docKey);
+            }
+        }
+    }
+
+    // Disjoint: replacing an attached document hides it
+    std::vector<int> result;
+    result.reserve(attached.size() + inMemory.size());
+    std::merge(attached.begin(), attached.end(), inMemory.begin(),
+               inMemory.end(), std::back_inserter(result));
+    return result;
+}
+
+std::vector<int> NGramIndex::search(const std::string& query) const {
+    std::string loweredQuery = toLower(query);
+    std::vector<CodePoint> cps = decodeUtf8(loweredQuery);
+    if (cps.empty()) {
+        return allKeys();
+    }
+
+    std::vector<int> result;
+    for (int docKey : candidates(cps)) {
+        // Bigrams may all be present without being contiguous; verify.
+        if (cps.size() <= 2) {
+            result.push_back(docKey);
+            continue;
+        }
+        std::vector<std::string_view> fields = fieldsOf(docKey);
+        if (std::any_of(fields.begin(), fields.end(),
+                        [&loweredQuery](std::string_view field) {
+                            return field.find(loweredQuery) !=
+                                   std::string_view::npos;
+                        })) {
+            result.push_back(docKey);
+        }
+    }
+    return result;
+}
+
+std::vector<NGramIndex::Hit> NGramIndex::searchWithMatches(
+    const std::string& query) const {
+    std::vector<Hit> result;
+    std::string loweredQuery = toLower(query);
+    std::vector<CodePoint> cps = decodeUtf8(loweredQuery);
+    if (cps.empty()) {
+        for (int docKey : allKeys()) {
+            result.push_back({docKey, {}});
+        }
+        return result;
+    }
+
+    for (int docKey : candidates(cps)) {
+        // The verification scan doubles as the offset computation.
+        Hit hit{docKey, {}};
+        std::vector<std::string_view> fields = fieldsOf(docKey);
+        for (std::size_t f = 0; f < fields.size(); ++f) {
+            std::size_t pos = fields[f].find(loweredQuery);
+            while (pos != std::string_view::npos) {
+                hit.matches.push_back({f, pos});
+                pos = fields[f].find(loweredQuery, pos + loweredQuery.size());
+            }
+        }
+        if (!hit.matches.empty()) {
+            result.push_back(std::move(hit));
+        }
+    }
+    return result;
+}
+
+}  // namespace Search
+}  // namespace Logic
+}  // namespace RecipeApp
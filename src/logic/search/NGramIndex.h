@@ -0,0 +1,153 @@
+#ifndef RECIPE_SEARCH_NGRAM_INDEX_H
+#define RECIPE_SEARCH_NGRAM_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "../../common/BinaryCodec.h"
+#include "Utf8.h"
+
+namespace RecipeApp {
+namespace Logic {
+namespace Search {
+
+/**
+ * @brief Case-insensitive substring index over short text fields.
+ *
+ * Every field is lowercased (ASCII) and broken into code point unigrams and
+ * bigrams. A query is answered by intersecting the posting lists of its
+ * bigrams (or its single unigram), then verifying each candidate against the
+ * cached lowercased fields. The result is exactly the set of documents for
+ * which some field contains the query, at a cost proportional to the
+ * candidates rather than to the whole collection.
+ *
+ * A serialized index can be attached in place (e.g. from a mapped file):
+ * the gram table is binary searched, posting lists are read from one flat
+ * array and fields are (offset, length) references into a string pool, so
+ * attaching allocates nothing. Documents added or removed afterwards are
+ * kept in memory on top of the attached ones.
+ */
+class NGramIndex {
+   public:
+    /**
+     * @brief One occurrence of the query inside a document field.
+     */
+    struct FieldMatch {
+        std::size_t fieldIndex;  ///< Position in the addDocument() field list
+        std::size_t offset;      ///< UTF-8 byte offset within the field
+    };
+
+    /**
+     * @brief A matching document and every (non-overlapping) occurrence of
+     *        the query in its fields, in field then offset order.
+     */
+    struct Hit {
+        int docKey;
+        std::vector<FieldMatch> matches;
+    };
+
+    /**
+     * @brief Indexes a document, replacing any previous version of it.
+     * @param docKey Caller-defined key (e.g. a record position or ID).
+     * @param fields Text fields of the document.
+     */
+    void addDocument(int docKey, const std::vector<std::string>& fields);
+
+    /**
+     * @brief Removes a document from the index. Unknown keys are ignored.
+     */
+    void removeDocument(int docKey);
+
+    void clear();
+
+    /**
+     * @brief Finds documents with a field containing the query
+     *        (case-insensitive substring match).
+     * @param query UTF-8 search text. An empty query matches every document.
+     * @return Matching document keys in ascending order.
+     */
+    std::vector<int> search(const std::string& query) const;
+
+    /**
+     * @brief Like search(), but also reports where the query occurs. The
+     *        offsets fall out of the verification step, so this costs the
+     *        same as search(). Match length is always query.size() bytes
+     *        (lowercasing is ASCII-only and keeps byte offsets).
+     * @param query UTF-8 search text. An empty query matches every document
+     *        with no matches reported.
+     */
+    std::vector<Hit> searchWithMatches(const std::string& query) const;
+
+    std::size_t size() const {
+        return m_attachedDocCount - m_hidden.size() + m_fields.size();
+    }
+
+    /**
+     * @brief Writes the index in a stable, platform-independent layout:
+     *          u32 document, field, gram and posting counts
+     *          documents  (i32 docKey, u32 first field), ascending by key
+     *          fields     lowercased fields as string-pool references
+     *          grams      (u64 gram, u32 first posting), ascending by gram
+     *          postings   i32 docKeys, ascending within each gram
+     * @param writeRef Stores a field in the caller's string pool and writes
+     *        its 8-byte reference.
+     */
+    void serialize(Common::ByteWriter& writer,
+                   const Common::StringRefWriter& writeRef) const;
+
+    /**
+     * @brief Replaces the contents with a view of an index written by
+     *        serialize(). Nothing is copied: both views must outlive the
+     *        index (or the next clear()).
+     * @param stringPool The pool the field references point into.
+     * @return False (leaving the index empty) if the sizes do not add up.
+     */
+    bool attach(std::string_view bytes, std::string_view stringPool);
+
+   private:
+    // In-memory documents: all of them, or those changed since attach().
+    // Unigram and bigram keys packed into one integer.
+    std::unordered_map<std::uint64_t, std::vector<int>> m_postings;
+    // docKey -> lowercased fields, used for verification and removal
+    std::map<int, std::vector<std::string>> m_fields;
+
+    // Attached index (sections of the serialized form)
+    std::string_view m_attachedDocs;
+    std::string_view m_attachedFields;
+    std::string_view m_attachedGrams;
+    std::string_view m_attachedPostings;
+    std::string_view m_stringPool;
+    std::size_t m_attachedDocCount = 0;
+    // Attached documents removed or replaced since
+    std::unordered_set<int> m_hidden;
+
+    static std::vector<std::uint64_t> gramsOf(const std::string& loweredText);
+
+    // Slot of an attached document (hidden or not), or npos
+    std::size_t attachedSlot(int docKey) const;
+    int attachedKey(std::size_t slot) const;
+    // Range [first, end) of a table entry whose end is the next entry's first
+    std::pair<std::size_t, std::size_t> attachedRange(
+        std::string_view table, std::size_t entrySize, std::size_t slot,
+        std::size_t firstOffset, std::size_t limit) const;
+    std::vector<std::string_view> attachedFieldsOf(std::size_t slot) const;
+    // Lowercased fields of a live document
+    std::vector<std::string_view> fieldsOf(int docKey) const;
+    // Every live document key, ascending
+    std::vector<int> allKeys() const;
+
+    // Documents whose postings contain every gram of the query (unverified).
+    std::vector<int> candidates(const std::vector<CodePoint>& queryCps) const;
+};
+
+}  // namespace Search
+}  // namespace Logic
+}  // namespace RecipeApp
+
+#endif  // RECIPE_SEARCH_NGRAM_INDEX_H
@@ -0,0 +1,58 @@
+#ifndef RECIPE_SEARCH_SEARCH_MATCH_H
+#define RECIPE_SEARCH_SEARCH_MATCH_H
+
+#include <cstddef>
+#include <vector>
+
+#include "../../domain/recipe/Recipe.h"
+
+namespace RecipeApp {
+namespace Logic {
+namespace Search {
+
+/**
+ * @brief Recipe field a search match was found in.
+ */
+enum class MatchField {
+    Name,
+    Ingredient,  ///< An ingredient name
+    Tag
+};
+
+inline const char* matchFieldName(MatchField field) {
+    switch (field) {
+        case MatchField::Name:
+            return "name";
+        case MatchField::Ingredient:
+            return "ingredient";
+        case MatchField::Tag:
+            return "tag";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Where a query matched inside a recipe, as a UTF-8 byte range of
+ *        the original field text.
+ */
+struct MatchSpan {
+    MatchField field;
+    std::size_t fieldIndex;  ///< Ingredient/tag position (0 for the name)
+    std::size_t offset;      ///< Byte offset within the field
+    std::size_t length;      ///< Byte length of the match
+};
+
+/**
+ * @brief A search result together with the spans that made it match, so
+ *        callers can highlight without re-scanning the recipe.
+ */
+struct RecipeSearchHit {
+    RecipeApp::Recipe recipe;
+    std::vector<MatchSpan> matches;
+};
+
+}  // namespace Search
+}  // namespace Logic
+}  // namespace RecipeApp
+
+#endif  // RECIPE_SEARCH_SEARCH_MATCH_H
@@ -0,0 +1,119 @@
+#ifndef RECIPE_SEARCH_UTF8_H
+#define RECIPE_SEARCH_UTF8_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace RecipeApp {
+namespace Logic {
+namespace Search {
+
+/**
+ * @brief One decoded code point and the UTF-8 byte range it came from.
+ */
+struct CodePoint {
+    char32_t value;
+    std::size_t offset;  ///< Byte offset in the source string
+    std::size_t length;  ///< Byte length of the encoded sequence
+};
+
+/**
+ * @brief Decodes UTF-8 text into code points with their byte ranges.
+ *        Invalid bytes are passed through as single-byte code points so
+ *        offsets always stay aligned with the source string.
+ */
+inline std::vector<CodePoint> decodeUtf8(const std::string& text) {
+    std::vector<CodePoint> out;
+    out.reserve(text.size());
+    std::size_t i = 0;
+    while (i < text.size()) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        std::size_t len = 1;
+        char32_t cp = c;
+        if (c >= 0xC0 && c < 0xE0) {
+            len = 2;
+            cp = c & 0x1F;
+        } else if (c >= 0xE0 && c < 0xF0) {
+            len = 3;
+            cp = c & 0x0F;
+        } else if (c >= 0xF0 && c < 0xF8) {
+            len = 4;
+            cp = c & 0x07;
+        }
+        if (len > 1) {
+            bool valid = i + len <= text.size();
+            for (std::size_t k = 1; valid && k < len; ++k) {
+                unsigned char cc = static_cast<unsigned char>(text[i + k]);
+                if ((cc & 0xC0) != 0x80) {
+                    valid = false;
+                } else {
+                    cp = (cp << 6) | (cc & 0x3F);
+                }
+            }
+            if (!valid) {
+                len = 1;
+                cp = c;
+            }
+        }
+        out.push_back({cp, i, len});
+        i += len;
+    }
+    return out;
+}
+
+/**
+ * @brief True for ideographic / kana / hangul code points, which are not
+ *        separated by whitespace and are therefore segmented as n-grams.
+ */
+inline bool isCjk(char32_t cp) {
+    return (cp >= 0x3040 && cp <= 0x30FF) ||  // Hiragana, Katakana
+           (cp >= 0x3400 && cp <= 0x4DBF) ||  // CJK Extension A
+           (cp >= 0x4E00 && cp <= 0x9FFF) ||  // CJK Unified Ideographs
+           (cp >= 0xAC00 && cp <= 0xD7AF) ||  // Hangul syllables
+           (cp >= 0xF900 && cp <= 0xFAFF) ||  // CJK Compatibility
+           (cp >= 0x20000 && cp <= 0x2FA1F);  // Extensions B+
+}
+
+/**
+ * @brief True for ASCII letters and digits (the word characters of
+ *        whitespace-separated languages handled by the tokenizers).
+ */
+inline bool isAsciiWordChar(char32_t cp) {
+    return (cp >= '0' && cp <= '9') || (cp >= 'a' && cp <= 'z') ||
+           (cp >= 'A' && cp <= 'Z');
+}
+
+/**
+ * @brief Lowercases ASCII letters, leaves every other code point as is.
+ */
+inline char32_t foldAscii(char32_t cp) {
+    return (cp >= 'A' && cp <= 'Z') ? cp + ('a' - 'A') : cp;
+}
+
+/**
+ * @brief Appends the UTF-8 encoding of a code point to a string.
+ */
+inline void appendUtf8(std::string& out, char32_t cp) {
+    if (cp < 0x80) {
+        out.push_back(static_cast<char>(cp));
+    } else if (cp < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else if (cp < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+    }
+}
+
+}  // namespace Search
+}  // namespace Logic
+}  // namespace RecipeApp
+
+#endif  // RECIPE_SEARCH_UTF8_H
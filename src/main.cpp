@@ -35,6 +35,8 @@
 #include "cli/restaurant/RestaurantCommandHandler.h"
 // #include "cli/user/UserCommandHandler.h" // Removed as part of P1.7
 #include "cli/encyclopedia/RecipeEncyclopediaCommandHandler.h" // ADDED: New encyclopedia handler
+#include "cli/search/FederatedSearchCommandHandler.h"
+#include "logic/search/FederatedSearchService.h"
 // #include "cli/handlers/AdminCommandHandler.h"  // AdminCommandHandler removed
 #include "cli/ExitCodes.h"  // Include ExitCodes
 #include "common/exceptions/ValidationException.h"
@@ -158,19 +160,7 @@ int main(int argc, char *argv[]) {
     }
     spdlog::info("餐厅数据 (restaurants.json) 加载成功。");
 
-    // 3. Instantiate Managers with Repository Dependencies
-    // RecipeApp::UserManager userManager(userRepository);                   //
-    // UserManager removed
-    RecipeApp::RecipeManager recipeManager(
-        recipeRepository);  // Inject RecipeRepository
-    RecipeApp::RestaurantManager restaurantManager(
-        restaurantRepository);  // ADDED Injection
-
-    // Instantiate RecipeEncyclopediaManager
-    RecipeApp::Logic::Encyclopedia::RecipeEncyclopediaManager encyclopediaManager;
-
-    // --- Determine the path to encyclopedia_recipes.json (Improved Logic P1.5) ---
-    std::string encyclopediaDataPath;
+    // --- Locate bundled data files (Improved Logic P1.5) ---
     std::filesystem::path execPath;
     try {
         execPath = std::filesystem::absolute(std::filesystem::path(argv[0]));
@@ -181,54 +171,102 @@ int main(int argc, char *argv[]) {
     }
     std::filesystem::path execDir = execPath.parent_path();
 
-    std::vector<std::filesystem::path> potentialPaths;
-    // 1. Relative to executable: ./data/encyclopedia_recipes.json (e.g. deployed alongside data dir)
-    potentialPaths.push_back(execDir / "data" / "encyclopedia_recipes.json");
-    // 2. Relative to executable: ../data/encyclopedia_recipes.json (common for build/config/exe)
-    potentialPaths.push_back(execDir / ".." / "data" / "encyclopedia_recipes.json");
-    // 3. Relative to executable: ../../data/encyclopedia_recipes.json (common for build/config/sub/exe)
-    potentialPaths.push_back(execDir / ".." / ".." / "data" / "encyclopedia_recipes.json");
-    // 4. Project root relative to common build structures (e.g. build/Debug/exe -> project_root/data)
-    if (execDir.has_parent_path() && execDir.parent_path().has_parent_path()) { // execDir/../.. (project_root)
-        potentialPaths.push_back(execDir.parent_path().parent_path() / "data" / "encyclopedia_recipes.json");
-        if (execDir.parent_path().parent_path().has_parent_path()){ // execDir/../../.. (e.g. if build is in a sub-sub-dir)
-             potentialPaths.push_back(execDir.parent_path().parent_path().parent_path() / "data" / "encyclopedia_recipes.json");
-        }
-    }
-    // 5. In user config directory (less common for encyclopedia, but a fallback)
-    potentialPaths.push_back(configDirPath / "encyclopedia_recipes.json");
-    // 6. In current working directory: ./data/encyclopedia_recipes.json
-    potentialPaths.push_back(std::filesystem::current_path() / "data" / "encyclopedia_recipes.json");
-    // 7. Directly in current working directory (if file is just encyclopedia_recipes.json)
-    potentialPaths.push_back(std::filesystem::current_path() / "encyclopedia_recipes.json");
-     // 8. Directly relative to executable (if file is just encyclopedia_recipes.json)
-    potentialPaths.push_back(execDir / "encyclopedia_recipes.json");
-
-
-    spdlog::debug("开始查找食谱大全数据文件 (encyclopedia_recipes.json)。可执行文件路径: {}", execPath.string());
-    for (const auto& p : potentialPaths) {
-        std::filesystem::path canonical_path;
-        try {
-            // weakly_canonical to resolve ., .. without requiring the file to exist initially for all parts of the path
-            canonical_path = std::filesystem::weakly_canonical(p);
-        } catch (const std::filesystem::filesystem_error& fs_err) {
-            spdlog::debug("  - 检查路径时发生错误 (路径: '{}'): {}", p.string(), fs_err.what());
-            canonical_path = p; // Use original path if canonicalization fails
+    // Returns the first existing location of a data file, or an empty string.
+    auto locateDataFile = [&](const std::string& fileName) -> std::string {
+        std::vector<std::filesystem::path> potentialPaths;
+        // 1. Relative to executable: ./data/<file> (e.g. deployed alongside data dir)
+        potentialPaths.push_back(execDir / "data" / fileName);
+        // 2. Relative to executable: ../data/<file> (common for build/config/exe)
+        potentialPaths.push_back(execDir / ".." / "data" / fileName);
+        // 3. Relative to executable: ../../data/<file> (common for build/config/sub/exe)
+        potentialPaths.push_back(execDir / ".." / ".." / "data" / fileName);
+        // 4. Project root relative to common build structures (e.g. build/Debug/exe -> project_root/data)
+        if (execDir.has_parent_path() && execDir.parent_path().has_parent_path()) { // execDir/../.. (project_root)
+            potentialPaths.push_back(execDir.parent_path().parent_path() / "data" / fileName);
+            if (execDir.parent_path().parent_path().has_parent_path()){ // execDir/../../.. (e.g. if build is in a sub-sub-dir)
+                 potentialPaths.push_back(execDir.parent_path().parent_path().parent_path() / "data" / fileName);
+            }
         }
-        spdlog::debug("  - 正在检查规范化路径: {}", canonical_path.string());
-        if (std::filesystem::exists(canonical_path) && std::filesystem::is_regular_file(canonical_path)) {
-            encyclopediaDataPath = canonical_path.string();
-            spdlog::info("食谱大全数据文件找到于: {}", encyclopediaDataPath);
-            break;
+        // 5. In user config directory (a fallback, also allows user overrides)
+        potentialPaths.push_back(configDirPath / fileName);
+        // 6. In current working directory: ./data/<file>
+        potentialPaths.push_back(std::filesystem::current_path() / "data" / fileName);
+        // 7. Directly in current working directory
+        potentialPaths.push_back(std::filesystem::current_path() / fileName);
+        // 8. Directly relative to executable
+        potentialPaths.push_back(execDir / fileName);
+
+        spdlog::debug("开始查找数据文件 ({})。可执行文件路径: {}", fileName, execPath.string());
+        for (const auto& p : potentialPaths) {
+            std::filesystem::path canonical_path;
+            try {
+                // weakly_canonical to resolve ., .. without requiring the file to exist initially for all parts of the path
+                canonical_path = std::filesystem::weakly_canonical(p);
+            } catch (const std::filesystem::filesystem_error& fs_err) {
+                spdlog::debug("  - 检查路径时发生错误 (路径: '{}'): {}", p.string(), fs_err.what());
+                canonical_path = p; // Use original path if canonicalization fails
+            }
+            spdlog::debug("  - 正在检查规范化路径: {}", canonical_path.string());
+            if (std::filesystem::exists(canonical_path) && std::filesystem::is_regular_file(canonical_path)) {
+                return canonical_path.string();
+            }
         }
+        return "";
+    };
+
+    // 3. Instantiate Managers with Repository Dependencies
+    // RecipeApp::UserManager userManager(userRepository);                   //
+    // UserManager removed
+    // Ingredient synonyms/aliases (applied when indexing and searching
+    // ingredients) and categories (allergens, dislikes, used by --exclude)
+    // are loaded before the recipe indexes are built, so they are built once.
+    std::string ingredientSynonymsPath = locateDataFile("ingredient_synonyms.json");
+    std::string ingredientCategoriesPath = locateDataFile("ingredient_categories.json");
+    RecipeApp::RecipeManager recipeManager(
+        recipeRepository,  // Inject RecipeRepository
+        {ingredientSynonymsPath, ingredientCategoriesPath});
+    if (!recipeManager.hasIngredientSynonyms()) {
+        spdlog::warn("无法加载食材同义词数据 (ingredient_synonyms.json)。食材搜索将只做精确匹配。");
+    }
+    if (!recipeManager.hasIngredientCategories()) {
+        spdlog::warn("无法加载食材类别数据 (ingredient_categories.json)。--exclude 过滤功能将不可用。");
+    }
+    RecipeApp::RestaurantManager restaurantManager(
+        restaurantRepository);  // ADDED Injection
+    // 删除菜谱时同步移除餐馆中对它的引用
+    restaurantManager.followRecipeDeletions(recipeManager);
+
+    // Instantiate RecipeEncyclopediaManager
+    RecipeApp::Logic::Encyclopedia::RecipeEncyclopediaManager encyclopediaManager;
+
+    std::string encyclopediaDataPath = locateDataFile("encyclopedia_recipes.json");
+    if (!encyclopediaDataPath.empty()) {
+        spdlog::info("食谱大全数据文件找到于: {}", encyclopediaDataPath);
     }
 
-    if (encyclopediaDataPath.empty()) {
+    // 构建时预编译的二进制包 (encyclopedia_bundle 目标)，与 JSON 一致时优先使用
+    std::string encyclopediaBundlePath = locateDataFile("encyclopedia_recipes.bundle");
+
+    if (encyclopediaDataPath.empty() && encyclopediaBundlePath.empty()) {
         spdlog::warn("无法在任何预期位置找到食谱大全数据文件 (encyclopedia_recipes.json)。食谱大全功能可能不可用。");
         // encyclopediaManager.loadRecipes will handle an empty path if necessary
     }
 
-    if (!encyclopediaManager.loadRecipes(encyclopediaDataPath)) { // loadRecipes should handle empty path gracefully
+    // 预编译包优先；否则按文件大小选择按需加载 (内存映射 + 按需解码) 或并行解析
+    bool encyclopediaLoaded =
+        encyclopediaManager.loadPreferringBundle(encyclopediaBundlePath, encyclopediaDataPath);
+    using EncyclopediaLoadMode = RecipeApp::Logic::Encyclopedia::RecipeEncyclopediaManager::LoadMode;
+    if (encyclopediaLoaded && encyclopediaManager.getLoadMode() == EncyclopediaLoadMode::Bundle) {
+        spdlog::debug("食谱大全从二进制包 {} 加载。", encyclopediaBundlePath);
+    } else {
+        if (!encyclopediaBundlePath.empty()) {
+            spdlog::info("食谱大全二进制包缺失或已过期，回退到 JSON 数据。");
+        }
+        if (encyclopediaLoaded && encyclopediaManager.getLoadMode() == EncyclopediaLoadMode::LazyJson) {
+            spdlog::info("食谱大全数据较大，使用按需加载模式。");
+        }
+    }
+    if (!encyclopediaLoaded) { // loadRecipes should handle empty path gracefully
         spdlog::warn("无法加载食谱大全数据 ({}). 食谱大全功能可能不可用。", encyclopediaDataPath);
     } else {
         if (RecipeApp::CliUtils::isVerbose()) { // This check is fine
@@ -242,7 +280,9 @@ int main(int argc, char *argv[]) {
     RecipeApp::CliHandlers::RestaurantCommandHandler restaurantCommandHandler(
         restaurantManager, recipeManager); // Added recipeManager
     // RecipeApp::CliHandlers::UserCommandHandler userCommandHandler; // Removed as part of P1.7
-    RecipeApp::CliHandlers::RecipeEncyclopediaCommandHandler encyclopediaCommandHandler(encyclopediaManager); // ADDED: Instantiate new handler
+    RecipeApp::CliHandlers::RecipeEncyclopediaCommandHandler encyclopediaCommandHandler(encyclopediaManager, recipeManager); // ADDED: Instantiate new handler
+    RecipeApp::Logic::Search::FederatedSearchService federatedSearchService(recipeManager, encyclopediaManager);
+    RecipeApp::CliHandlers::FederatedSearchCommandHandler federatedSearchCommandHandler(federatedSearchService);
     // RecipeApp::CliHandlers::AdminCommandHandler
     // adminCommandHandler(userManager); // AdminCommandHandler removed
 
@@ -283,6 +323,8 @@ int main(int argc, char *argv[]) {
         u8"  用法 4 (按逗号分隔的多标签 AND 匹配): recipe-cli --recipe-search --tags \"晚餐,快捷\"\n"
         u8"  用法 5 (名称和单标签): recipe-cli --recipe-search \"汤\" --tag \"冬季\"\n"
         u8"  用法 6 (名称和多标签): recipe-cli --recipe-search \"沙拉\" --tags \"夏季,健康\"\n"
+        u8"  用法 7 (按步骤文本): recipe-cli --recipe-search --steps \"炖\"\n"
+        u8"  用法 8 (排除过敏原/忌口类别): recipe-cli --recipe-search --exclude \"花生,pork\"\n"
         u8"  注意: 如果只提供标签，则仅按标签搜索。如果同时提供名称和标签，则进行组合搜索。",
         cxxopts::value<std::string>()->implicit_value(""), u8"搜索关键词 (可选)")(
         "recipe-view",
@@ -303,14 +345,40 @@ int main(int argc, char *argv[]) {
             u8"用于 --recipe-add (预设标签), --recipe-update (替换所有标签), 或 --recipe-search (AND 匹配所有列出的标签)。\n"
             u8"  格式为逗号分隔的字符串: \"标签1,标签2,标签3\"\n"
             u8"  例如 (搜索): recipe-cli --recipe-search --tags \"晚餐,快捷\"",
-            cxxopts::value<std::string>(), u8"逗号分隔的标签列表");
+            cxxopts::value<std::string>(), u8"逗号分隔的标签列表")(
+            "steps",
+            u8"用于 --recipe-search，按步骤文本过滤 (短语匹配，支持中文)。\n"
+            u8"  例如: recipe-cli --recipe-search --steps \"小火慢炖\"",
+            cxxopts::value<std::string>(), u8"步骤文本")(
+            "exclude",
+            u8"用于 --recipe-search，排除含有指定类别食材的菜谱 (如过敏原、忌口)。\n"
+            u8"  类别定义见 data/ingredient_categories.json (如 peanut, shellfish, pork 或别名 花生, 猪肉)。\n"
+            u8"  例如: recipe-cli --recipe-search --tag \"川菜\" --exclude \"花生,shellfish\"",
+            cxxopts::value<std::string>(), u8"逗号分隔的类别列表")(
+            "facets",
+            u8"用于 --recipe-search，在结果后显示标签、难度和烹饪时长的分面计数。\n"
+            u8"  例如: recipe-cli --recipe-search --tag \"川菜\" --facets");
 
     options.add_options("Encyclopedia")(
         "enc-list", u8"列出食谱大全中的所有菜谱条目。\n  例如: recipe-cli --enc-list")
         ("enc-search", u8"在食谱大全中按关键词 (如名称、食材、标签) 搜索菜谱。\n  例如: recipe-cli --enc-search \"美味的鸡肉汤\"",
          cxxopts::value<std::string>(), u8"搜索关键词 (必需)")
         ("enc-view", u8"按 ID 查看食谱大全中特定菜谱的详细信息。\n  例如: recipe-cli --enc-view 123",
-         cxxopts::value<int>(), u8"菜谱ID (必需)");
+         cxxopts::value<int>(), u8"菜谱ID (必需)")
+        ("enc-import", u8"将食谱大全中的菜谱批量导入到我的菜谱 (一次写入)。不带关键词时导入全部，名称已存在的菜谱会被跳过。关键词需用 = 连接。\n"
+                       u8"  例如: recipe-cli --enc-import=\"鸡\" 或 recipe-cli --enc-import --enc-import-tag \"川菜\"",
+         cxxopts::value<std::string>()->implicit_value(""), u8"搜索关键词 (可选)")
+        ("enc-import-tag", u8"用于 --enc-import，只导入带有该标签的菜谱。",
+         cxxopts::value<std::string>(), u8"标签");
+
+    options.add_options("Search")(
+        "search",
+        u8"同时搜索我的菜谱和食谱大全，按统一评分合并排序 (名称 > 标签 > 食材)。\n"
+        u8"  已导入到我的菜谱中的百科条目只显示一次。\n"
+        u8"  例如: recipe-cli --search \"鸡\" --top 5",
+        cxxopts::value<std::string>(), u8"搜索关键词 (必需)")(
+        "top", u8"用于 --search，返回的最多结果数 (默认 10)。",
+        cxxopts::value<int>()->default_value("10"), u8"数量");
 
     options.add_options("Restaurant")(
         "restaurant-add",
@@ -325,7 +393,11 @@ int main(int argc, char *argv[]) {
         cxxopts::value<int>(), u8"餐馆ID (必需)")(
         "restaurant-delete",
         u8"按 ID 删除已保存的餐馆。\n  例如: recipe-cli --restaurant-delete 1",
-        cxxopts::value<int>(), u8"餐馆ID (必需)");
+        cxxopts::value<int>(), u8"餐馆ID (必需)")(
+        "restaurant-verify-refs",
+        u8"检查餐馆的特色菜谱是否引用了已删除的菜谱。\n  例如: recipe-cli --restaurant-verify-refs")(
+        "restaurant-repair-refs",
+        u8"检查并从餐馆中移除对已删除菜谱的引用。\n  例如: recipe-cli --restaurant-repair-refs");
     // Admin commands removed
 
     try {
@@ -333,7 +405,7 @@ int main(int argc, char *argv[]) {
 
         if (result.count("help")) {
             // 显示所有定义的命令组
-            std::cout << options.help({"", "Recipe", "Encyclopedia", "Restaurant"})
+            std::cout << options.help({"", "Recipe", "Encyclopedia", "Search", "Restaurant"})
                       << std::endl;
             return RecipeApp::Cli::EX_OK;
         }
@@ -411,6 +483,14 @@ int main(int argc, char *argv[]) {
             // Delegate to the new handler
             exit_code = encyclopediaCommandHandler.handleViewEncyclopediaRecipe(result);
             command_handled = true;
+        } else if (result.count("enc-import")) {
+            exit_code = encyclopediaCommandHandler.handleImportEncyclopediaRecipes(result);
+            command_handled = true;
+        }
+        // Federated search across both sources
+        else if (result.count("search")) {
+            exit_code = federatedSearchCommandHandler.handleFederatedSearch(result);
+            command_handled = true;
         }
         // Restaurant Commands
         else if (result.count("restaurant-add")) {
@@ -428,6 +508,9 @@ int main(int argc, char *argv[]) {
         } else if (result.count("restaurant-delete")) {
             exit_code = restaurantCommandHandler.handleDeleteRestaurant(result);
             command_handled = true;
+        } else if (result.count("restaurant-verify-refs") || result.count("restaurant-repair-refs")) {
+            exit_code = restaurantCommandHandler.handleVerifyRecipeReferences(result);
+            command_handled = true;
         }
         // Admin Commands (Commented out)
         // else if (result.count("admin-user-list"))
@@ -464,8 +547,10 @@ int main(int argc, char *argv[]) {
                 for (const auto &cmd_opt : { // Added new encyclopedia commands to this check
                          "recipe-add", "recipe-list", "recipe-search",
                          "recipe-view", "recipe-update", "recipe-delete",
-                         "enc-list", "enc-search", "enc-view", // Added enc-view to check
-                         "restaurant-add", "restaurant-list", "restaurant-view", "restaurant-update", "restaurant-delete" // Added restaurant commands
+                         "enc-list", "enc-search", "enc-view", "enc-import", // Added enc-view to check
+                         "search",
+                         "restaurant-add", "restaurant-list", "restaurant-view", "restaurant-update", "restaurant-delete", // Added restaurant commands
+                         "restaurant-verify-refs", "restaurant-repair-refs"
                          // "admin-user-update" // Temporarily add back for
                          // testing "admin-user-list", "admin-user-create",
                          // "admin-user-delete" // Commented out
@@ -0,0 +1,321 @@
+#include "EncyclopediaBundle.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "../common/BinaryCodec.h"
+
+namespace RecipeApp {
+namespace Persistence {
+
+namespace {
+constexpr char kMagic[8] = {'R', 'E', 'C', 'I', 'P', 'E', 'N', 'C'};
+// magic + version + record count + source size + source hash + 5 sections
+constexpr std::size_t kHeaderSize = 8 + 4 + 4 + 8 + 8 + 5 * 16;
+
+constexpr std::uint8_t kHasNutritionalInfo = 1u << 0;
+constexpr std::uint8_t kHasImageUrl = 1u << 1;
+
+class StringPool {
+   public:
+    void write(Common::ByteWriter& writer, std::string_view value) {
+        auto it = m_offsets.find(std::string(value));
+        std::uint32_t offset;
+        if (it != m_offsets.end()) {
+            offset = it->second;
+        } else {
+            offset = static_cast<std::uint32_t>(m_bytes.size());
+            m_bytes += value;
+            m_offsets.emplace(std::string(value), offset);
+        }
+        writer.writeU32(offset);
+        writer.writeU32(static_cast<std::uint32_t>(value.size()));
+    }
+
+    const std::string& bytes() const { return m_bytes; }
+
+   private:
+    std::string m_bytes;
+    std::unordered_map<std::string, std::uint32_t> m_offsets;
+};
+
+std::string readPooled(Common::ByteReader& reader, std::string_view pool) {
+    std::uint32_t offset = reader.readU32();
+    std::uint32_t length = reader.readU32();
+    if (offset > pool.size() || length > pool.size() - offset) {
+        throw std::out_of_range("string reference outside the string pool");
+    }
+    return std::string(pool.substr(offset, length));
+}
+
+// Reads an element count, rejecting counts the remaining bytes cannot hold.
+std::size_t readCount(Common::ByteReader& reader, std::size_t bytesPerItem) {
+    std::uint32_t count = reader.readU32();
+    if (count > reader.remaining() / bytesPerItem) {
+        throw std::out_of_range("element count exceeds record size");
+    }
+    return count;
+}
+
+bool sectionInBounds(std::uint64_t offset, std::uint64_t size,
+                     std::size_t fileSize) {
+    return offset <= fileSize && size <= fileSize - offset;
+}
+}  // namespace
+
+std::uint64_t EncyclopediaBundle::fingerprint(std::string_view bytes) {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : bytes) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+bool EncyclopediaBundle::write(const std::string& path,
+                               const std::vector<RecipeApp::Recipe>& recipes,
+                               std::string_view sourceJson,
+                               const IndexWriter& writeIndex) {
+    StringPool pool;
+    std::string records;
+    std::string offsets;
+    std::string ids;
+    Common::ByteWriter recordWriter(records);
+    Common::ByteWriter offsetWriter(offsets);
+    Common::ByteWriter idWriter(ids);
+
+    for (const auto& recipe : recipes) {
+        offsetWriter.writeU64(recordWriter.position());
+        idWriter.writeI32(recipe.getRecipeId());
+        recordWriter.writeI32(recipe.getRecipeId());
+        pool.write(recordWriter, recipe.getName());
+        recordWriter.writeI32(recipe.getCookingTime());
+        recordWriter.writeU8(static_cast<std::uint8_t>(recipe.getDifficulty()));
+
+        std::uint8_t flags = 0;
+        if (recipe.getNutritionalInfo().has_value()) flags |= kHasNutritionalInfo;
+        if (recipe.getImageUrl().has_value()) flags |= kHasImageUrl;
+        recordWriter.writeU8(flags);
+        if (flags & kHasNutritionalInfo) {
+            pool.write(recordWriter, recipe.getNutritionalInfo().value());
+        }
+        if (flags & kHasImageUrl) {
+            pool.write(recordWriter, recipe.getImageUrl().value());
+        }
+
+        recordWriter.writeU32(static_cast<std::uint32_t>(recipe.getIngredients().size()));
+        for (const auto& ingredient : recipe.getIngredients()) {
+            pool.write(recordWriter, ingredient.name);
+            pool.write(recordWriter, ingredient.quantity);
+        }
+        recordWriter.writeU32(static_cast<std::uint32_t>(recipe.getSteps().size()));
+        for (const auto& step : recipe.getSteps()) {
+            pool.write(recordWriter, step);
+        }
+        recordWriter.writeU32(static_cast<std::uint32_t>(recipe.getTags().size()));
+        for (const auto& tag : recipe.getTags()) {
+            pool.write(recordWriter, tag);
+        }
+    }
+
+    std::string index;
+    Common::ByteWriter indexWriter(index);
+    writeIndex(indexWriter, [&pool](Common::ByteWriter& writer,
+                                    std::string_view value) {
+        pool.write(writer, value);
+    });
+
+    std::string out;
+    Common::ByteWriter writer(out);
+    std::uint64_t offset = kHeaderSize;
+    writer.writeBytes(std::string_view(kMagic, sizeof(kMagic)));
+    writer.writeU32(kFormatVersion);
+    writer.writeU32(static_cast<std::uint32_t>(recipes.size()));
+    writer.writeU64(sourceJson.size());
+    writer.writeU64(fingerprint(sourceJson));
+    for (std::size_t sectionSize : {pool.bytes().size(), offsets.size(),
+                                    ids.size(), records.size(), index.size()}) {
+        writer.writeU64(offset);
+        writer.writeU64(sectionSize);
+        offset += sectionSize;
+    }
+    writer.writeBytes(pool.bytes());
+    writer.writeBytes(offsets);
+    writer.writeBytes(ids);
+    writer.writeBytes(records);
+    writer.writeBytes(index);
+
+    // Write next to the target and rename, so readers never see half a file.
+    std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "[EncyclopediaBundle] Error: Could not open file for "
+                         "writing: "
+                      << tmpPath << std::endl;
+            return false;
+        }
+        file.write(out.data(), static_cast<std::streamsize>(out.size()));
+        if (!file) {
+            std::cerr << "[EncyclopediaBundle] Error: Failed writing " << tmpPath
+                      << std::endl;
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec) {
+        std::cerr << "[EncyclopediaBundle] Error: Could not move bundle into "
+                     "place at "
+                  << path << ": " << ec.message() << std::endl;
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+    return true;
+}
+
+bool EncyclopediaBundle::open(const std::string& path) {
+    close();
+    if (!m_file.open(path)) {
+        return false;
+    }
+    std::string_view data = m_file.view();
+    if (data.size() < kHeaderSize ||
+        data.substr(0, sizeof(kMagic)) != std::string_view(kMagic, sizeof(kMagic))) {
+        close();
+        return false;
+    }
+
+    Common::ByteReader reader(data.substr(sizeof(kMagic), kHeaderSize - sizeof(kMagic)));
+    std::uint32_t version = reader.readU32();
+    std::uint32_t recordCount = reader.readU32();
+    m_sourceSize = reader.readU64();
+    m_sourceHash = reader.readU64();
+    std::string_view* sections[] = {&m_strings, &m_offsets, &m_ids, &m_records,
+                                    &m_index};
+    for (std::string_view* section : sections) {
+        std::uint64_t offset = reader.readU64();
+        std::uint64_t size = reader.readU64();
+        if (!sectionInBounds(offset, size, data.size())) {
+            close();
+            return false;
+        }
+        *section = data.substr(static_cast<std::size_t>(offset),
+                               static_cast<std::size_t>(size));
+    }
+    if (!reader.ok() || version != kFormatVersion ||
+        m_offsets.size() != static_cast<std::size_t>(recordCount) * 8 ||
+        m_ids.size() != static_cast<std::size_t>(recordCount) * 4) {
+        close();
+        return false;
+    }
+    m_recordCount = recordCount;
+    m_path = path;
+    return true;
+}
+
+void EncyclopediaBundle::close() {
+    m_file.close();
+    m_path.clear();
+    m_recordCount = 0;
+    m_sourceSize = 0;
+    m_sourceHash = 0;
+    m_strings = m_offsets = m_ids = m_records = m_index = std::string_view();
+}
+
+bool EncyclopediaBundle::isFreshFor(const std::string& sourceJsonPath) const {
+    std::error_code ec;
+    if (!std::filesystem::exists(sourceJsonPath, ec)) {
+        return true;
+    }
+    std::uintmax_t sourceSize = std::filesystem::file_size(sourceJsonPath, ec);
+    if (ec || sourceSize != m_sourceSize) {
+        return false;
+    }
+    auto sourceTime = std::filesystem::last_write_time(sourceJsonPath, ec);
+    if (!ec) {
+        auto bundleTime = std::filesystem::last_write_time(m_path, ec);
+        if (!ec && sourceTime <= bundleTime) {
+            return true;
+        }
+    }
+    // Touched after the bundle was built (or times unavailable): compare
+    // contents before declaring it stale.
+    MappedFile source;
+    return source.open(sourceJsonPath) &&
+           fingerprint(source.view()) == m_sourceHash;
+}
+
+std::string_view EncyclopediaBundle::recordBytes(std::size_t position) const {
+    Common::ByteReader offsets(m_offsets.substr(position * 8, 8));
+    std::uint64_t begin = offsets.readU64();
+    std::uint64_t end = m_records.size();
+    if (position + 1 < m_recordCount) {
+        Common::ByteReader next(m_offsets.substr((position + 1) * 8, 8));
+        end = next.readU64();
+    }
+    if (begin > end || end > m_records.size()) {
+        return {};
+    }
+    return m_records.substr(static_cast<std::size_t>(begin),
+                            static_cast<std::size_t>(end - begin));
+}
+
+std::optional<RecipeApp::Recipe> EncyclopediaBundle::decodeRecipe(
+    std::size_t position) const {
+    if (position >= m_recordCount) {
+        return std::nullopt;
+    }
+    Common::ByteReader reader(recordBytes(position));
+    try {
+        int id = reader.readI32();
+        std::string name = readPooled(reader, m_strings);
+        int cookingTime = reader.readI32();
+        std::uint8_t difficulty = reader.readU8();
+        std::uint8_t flags = reader.readU8();
+        if (difficulty > static_cast<std::uint8_t>(RecipeApp::Difficulty::Hard)) {
+            throw std::out_of_range("invalid difficulty");
+        }
+
+        auto builder = RecipeApp::Recipe::builder(id, name);
+        builder.withCookingTime(cookingTime)
+            .withDifficulty(static_cast<RecipeApp::Difficulty>(difficulty));
+        if (flags & kHasNutritionalInfo) {
+            builder.withNutritionalInfo(readPooled(reader, m_strings));
+        }
+        if (flags & kHasImageUrl) {
+            builder.withImageUrl(readPooled(reader, m_strings));
+        }
+
+        std::vector<RecipeApp::Ingredient> ingredients(readCount(reader, 16));
+        for (auto& ingredient : ingredients) {
+            ingredient.name = readPooled(reader, m_strings);
+            ingredient.quantity = readPooled(reader, m_strings);
+        }
+        std::vector<std::string> steps(readCount(reader, 8));
+        for (auto& step : steps) {
+            step = readPooled(reader, m_strings);
+        }
+        std::vector<std::string> tags(readCount(reader, 8));
+        for (auto& tag : tags) {
+            tag = readPooled(reader, m_strings);
+        }
+        if (!reader.ok()) {
+            throw std::out_of_range("truncated record");
+        }
+        return builder.withIngredients(ingredients)
+            .withSteps(steps)
+            .withTags(tags)
+            .build();
+    } catch (const std::exception& e) {
+        std::cerr << "[EncyclopediaBundle] Error decoding record " << position
+                  << ": " << e.what() << std::endl;
+        return std::nullopt;
+    }
+}
+
+}  // namespace Persistence
+}  // namespace RecipeApp
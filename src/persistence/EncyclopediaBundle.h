@@ -0,0 +1,121 @@
+#ifndef ENCYCLOPEDIA_BUNDLE_H
+#define ENCYCLOPEDIA_BUNDLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../common/BinaryCodec.h"
+#include "../domain/recipe/Recipe.h"
+#include "MappedFile.h"
+
+namespace RecipeApp {
+namespace Persistence {
+
+/**
+ * @brief Prebuilt binary form of the recipe encyclopedia.
+ *
+ * Layout (all integers little-endian):
+ *   header      magic, format version, record count, size and FNV-1a hash
+ *               of the source JSON, offsets/sizes of the sections below
+ *   string pool deduplicated UTF-8 bytes; strings are (offset, length) refs
+ *   offsets     u64 offset of every record within the records section
+ *   ids         i32 ID of every record, contiguous
+ *   records     id, name, cooking time, difficulty, optional fields,
+ *               ingredients, steps and tags as string-pool refs
+ *   index       opaque index section supplied by the writer, which may
+ *               reference the string pool
+ *
+ * Reading maps the file and decodes records on request, so opening a bundle
+ * costs a header check regardless of its size.
+ */
+class EncyclopediaBundle {
+   public:
+    static constexpr std::uint32_t kFormatVersion = 3;
+
+    /**
+     * @brief Writes the index section. Strings written through the
+     *        StringRefWriter are stored in the bundle's string pool.
+     */
+    using IndexWriter = std::function<void(Common::ByteWriter&,
+                                           const Common::StringRefWriter&)>;
+
+    /**
+     * @brief Writes a bundle file.
+     * @param path Output path.
+     * @param recipes Records, in the order their positions are referenced by
+     *        the index section.
+     * @param sourceJson Bytes of the JSON file the records came from (only
+     *        its size and hash are stored, for staleness checks).
+     * @param writeIndex Writes the index section.
+     * @return True on success.
+     */
+    static bool write(const std::string& path,
+                      const std::vector<RecipeApp::Recipe>& recipes,
+                      std::string_view sourceJson,
+                      const IndexWriter& writeIndex);
+
+    /**
+     * @brief 64-bit FNV-1a hash used to fingerprint the source JSON.
+     */
+    static std::uint64_t fingerprint(std::string_view bytes);
+
+    /**
+     * @brief Maps a bundle and validates its header and section bounds.
+     * @return False if the file is missing, truncated or of another version.
+     */
+    bool open(const std::string& path);
+
+    void close();
+
+    /**
+     * @brief Whether the bundle was compiled from the current contents of
+     *        the given JSON file. Checks size and modification time first and
+     *        only hashes the file when the timestamps are inconclusive. A
+     *        missing source counts as fresh (bundle-only deployments).
+     */
+    bool isFreshFor(const std::string& sourceJsonPath) const;
+
+    std::size_t recordCount() const { return m_recordCount; }
+
+    /**
+     * @brief Decodes one record.
+     * @return The recipe, or std::nullopt if the record is corrupt.
+     */
+    std::optional<RecipeApp::Recipe> decodeRecipe(std::size_t position) const;
+
+    /**
+     * @brief Reads a record's ID from the ID column (0 if out of range).
+     */
+    int recordId(std::size_t position) const {
+        return position < m_recordCount
+                   ? Common::loadI32(m_ids.data() + position * 4)
+                   : 0;
+    }
+
+    std::string_view indexBlob() const { return m_index; }
+    std::string_view stringPool() const { return m_strings; }
+
+   private:
+    MappedFile m_file;
+    std::string m_path;
+    std::size_t m_recordCount = 0;
+    std::uint64_t m_sourceSize = 0;
+    std::uint64_t m_sourceHash = 0;
+    std::string_view m_strings;
+    std::string_view m_offsets;
+    std::string_view m_ids;
+    std::string_view m_records;
+    std::string_view m_index;
+
+    std::string_view recordBytes(std::size_t position) const;
+};
+
+}  // namespace Persistence
+}  // namespace RecipeApp
+
+#endif  // ENCYCLOPEDIA_BUNDLE_H
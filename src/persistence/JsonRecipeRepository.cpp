@@ -97,6 +97,36 @@ int JsonRecipeRepository::save(const Recipe &recipeToSave) {
     return -1;  // Indicate failure
 }
 
+std::vector<Recipe> JsonRecipeRepository::saveMany(
+    const std::vector<Recipe> &recipes) {
+    // IDs come from one contiguous block starting at nextId; the file is
+    // written once for the whole batch instead of once per recipe.
+    std::vector<Recipe> toAdd;
+    toAdd.reserve(recipes.size());
+    int nextId = this->getNextId();
+    for (const auto &recipe : recipes) {
+        auto builder = Recipe::builder(nextId++, recipe.getName())
+                           .withIngredients(recipe.getIngredients())
+                           .withSteps(recipe.getSteps())
+                           .withCookingTime(recipe.getCookingTime())
+                           .withDifficulty(recipe.getDifficulty())
+                           .withTags(recipe.getTags());
+        if (recipe.getNutritionalInfo().has_value()) {
+            builder.withNutritionalInfo(recipe.getNutritionalInfo().value());
+        }
+        if (recipe.getImageUrl().has_value()) {
+            builder.withImageUrl(recipe.getImageUrl().value());
+        }
+        toAdd.push_back(builder.build());
+    }
+
+    if (!this->addItemsInMemoryAndPersist(toAdd)) {
+        return {};
+    }
+    this->setNextId(nextId);
+    return toAdd;
+}
+
 bool JsonRecipeRepository::remove(int recipeId) {
     if (this->removeItemInMemoryAndPersist(recipeId)) {
         this->ensureNextIdIsCorrect();  // Recalculate m_nextId in base after
@@ -151,18 +181,7 @@ std::vector<Recipe> JsonRecipeRepository::findByName(const std::string &name,
 
 std::vector<Recipe> JsonRecipeRepository::findManyByIds(
     const std::vector<int> &ids) const {
-    std::vector<Recipe> results;
-    if (ids.empty() || this->m_items.empty()) {
-        return results;
-    }
-    results.reserve(ids.size());
-    for (const auto &recipe : this->m_items) {
-        if (std::find(ids.begin(), ids.end(), recipe.getRecipeId()) !=
-            ids.end()) {
-            results.push_back(recipe);
-        }
-    }
-    return results;
+    return this->findManyByIdsInternal(ids);
 }
 
 std::vector<Recipe> JsonRecipeRepository::findByTag(
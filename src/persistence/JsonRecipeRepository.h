@@ -41,6 +41,8 @@ class JsonRecipeRepository
     int save(const RecipeApp::Recipe &recipe)
         override;  // This needs careful implementation
     bool remove(int recipeId) override;
+    std::vector<RecipeApp::Recipe> saveMany(
+        const std::vector<RecipeApp::Recipe> &recipes) override;
 
     void setNextId(int nextId) override;
     int getNextId() const;  // Removed override, as it's not in the
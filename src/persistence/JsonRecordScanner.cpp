@@ -0,0 +1,131 @@
+#include "JsonRecordScanner.h"
+
+namespace RecipeApp {
+namespace Persistence {
+
+namespace {
+bool isJsonWhitespace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+std::size_t skipWhitespace(std::string_view text, std::size_t pos) {
+    while (pos < text.size() && isJsonWhitespace(text[pos])) {
+        ++pos;
+    }
+    return pos;
+}
+
+// Returns the position just past the value starting at pos, or npos.
+std::size_t skipValue(std::string_view text, std::size_t pos) {
+    std::size_t depth = 0;
+    bool inString = false;
+    for (; pos < text.size(); ++pos) {
+        char c = text[pos];
+        if (inString) {
+            if (c == '\\') {
+                ++pos;  // Skip the escaped character
+            } else if (c == '"') {
+                inString = false;
+                if (depth == 0) {
+                    return pos + 1;
+                }
+            }
+            continue;
+        }
+        switch (c) {
+            case '"':
+                inString = true;
+                break;
+            case '{':
+            case '[':
+                ++depth;
+                break;
+            case '}':
+            case ']':
+                if (depth == 0) {
+                    return pos;  // Closing bracket of the enclosing array
+                }
+                if (--depth == 0) {
+                    return pos + 1;
+                }
+                break;
+            case ',':
+                if (depth == 0) {
+                    return pos;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    return depth == 0 && !inString ? pos : std::string_view::npos;
+}
+}  // namespace
+
+bool scanJsonArrayRecords(std::string_view text,
+                          std::vector<RecordSpan>& spans) {
+    spans.clear();
+    std::size_t pos = 0;
+    if (text.substr(0, 3) == "\xEF\xBB\xBF") {
+        pos = 3;
+    }
+    pos = skipWhitespace(text, pos);
+    if (pos >= text.size() || text[pos] != '[') {
+        return false;
+    }
+    pos = skipWhitespace(text, pos + 1);
+    if (pos < text.size() && text[pos] == ']') {
+        return skipWhitespace(text, pos + 1) == text.size();
+    }
+
+    while (pos < text.size()) {
+        std::size_t end = skipValue(text, pos);
+        if (end == std::string_view::npos || end == pos) {
+            return false;
+        }
+        std::size_t trimmed = end;
+        while (trimmed > pos && isJsonWhitespace(text[trimmed - 1])) {
+            --trimmed;
+        }
+        spans.push_back({pos, trimmed - pos});
+
+        pos = skipWhitespace(text, end);
+        if (pos >= text.size()) {
+            return false;  // Unterminated array
+        }
+        if (text[pos] == ']') {
+            return skipWhitespace(text, pos + 1) == text.size();
+        }
+        if (text[pos] != ',') {
+            return false;
+        }
+        pos = skipWhitespace(text, pos + 1);
+    }
+    return false;
+}
+
+void scanNdjsonRecords(std::string_view text, std::vector<RecordSpan>& spans) {
+    spans.clear();
+    std::size_t pos = 0;
+    if (text.substr(0, 3) == "\xEF\xBB\xBF") {
+        pos = 3;
+    }
+    while (pos < text.size()) {
+        std::size_t end = text.find('\n', pos);
+        if (end == std::string_view::npos) {
+            end = text.size();
+        }
+        std::size_t first = skipWhitespace(text.substr(0, end), pos);
+        std::size_t last = end;
+        while (last > first && isJsonWhitespace(text[last - 1])) {
+            --last;
+        }
+        if (last > first) {
+            spans.push_back({first, last - first});
+        }
+        pos = end + 1;
+    }
+}
+
+}  // namespace Persistence
+}  // namespace RecipeApp
@@ -0,0 +1,56 @@
+#ifndef JSON_RECORD_SCANNER_H
+#define JSON_RECORD_SCANNER_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace RecipeApp {
+namespace Persistence {
+
+/**
+ * @brief Byte range of one record inside a larger JSON text.
+ */
+struct RecordSpan {
+    std::size_t offset;
+    std::size_t length;
+};
+
+/**
+ * @brief Finds the byte ranges of the elements of a top-level JSON array
+ *        without parsing them. Only brackets, braces and string literals are
+ *        tracked, so this runs at memory speed and the elements can later
+ *        be parsed one by one.
+ * @param text JSON text whose root is an array (a UTF-8 BOM is allowed).
+ * @param spans Receives one span per element, in document order.
+ * @return False if the text is not a well-formed top-level array.
+ */
+bool scanJsonArrayRecords(std::string_view text, std::vector<RecordSpan>& spans);
+
+/**
+ * @brief Finds the records of a newline-delimited JSON (NDJSON) text: one
+ *        JSON value per line. Blank lines are skipped, trailing '\r' is
+ *        trimmed and a UTF-8 BOM is allowed. Lines are not validated, so a
+ *        corrupt line only affects its own record when it is parsed.
+ * @param text NDJSON text.
+ * @param spans Receives one span per non-blank line, in document order.
+ */
+void scanNdjsonRecords(std::string_view text, std::vector<RecordSpan>& spans);
+
+/**
+ * @brief Whether a path names an NDJSON file (.ndjson or .jsonl extension).
+ */
+inline bool isNdjsonPath(const std::string& path) {
+    auto endsWith = [&path](std::string_view suffix) {
+        return path.size() >= suffix.size() &&
+               path.compare(path.size() - suffix.size(), suffix.size(),
+                            suffix) == 0;
+    };
+    return endsWith(".ndjson") || endsWith(".jsonl");
+}
+
+}  // namespace Persistence
+}  // namespace RecipeApp
+
+#endif  // JSON_RECORD_SCANNER_H
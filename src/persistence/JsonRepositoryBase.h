@@ -8,9 +8,12 @@
 #include <optional>
 #include <stdexcept>  // For std::runtime_error
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "../../include/json.hpp"
+#include "JsonRecordScanner.h"  // isNdjsonPath
 
 using json = nlohmann::json;
 
@@ -22,6 +25,10 @@ class JsonRepositoryBase {
    protected:
     std::string m_filePath;
     std::vector<T> m_items;
+    // ID -> position in m_items, so lookups by ID are O(1). Kept in step with
+    // every change to m_items; for duplicate IDs in a file the first wins,
+    // as with a front-to-back scan.
+    std::unordered_map<int, std::size_t> m_positions;
     int m_nextId;
     std::string m_jsonArrayKey;
 
@@ -54,51 +61,40 @@ class JsonRepositoryBase {
 
     virtual ~JsonRepositoryBase() = default;
 
+    /**
+     * Files named *.ndjson / *.jsonl hold one item per line instead of a
+     * {"<key>": [...]} document. Lines load independently, so a corrupt
+     * line is skipped instead of failing the whole load, and new items are
+     * appended without rewriting the file.
+     */
+    bool isNdjson() const { return isNdjsonPath(m_filePath); }
+
     bool load() {
         std::ifstream file(m_filePath);
         if (!file.is_open()) {
             std::cerr << "Warning: Could not open data file for reading: "
                       << m_filePath << ". Starting with an empty list for "
                       << m_jsonArrayKey << "." << std::endl;
-            m_items.clear();
+            clearItems();
             m_nextId = 1;
             return true;
         }
 
+        if (isNdjson()) {
+            return loadNdjson(file);
+        }
+
         try {
             json data = json::parse(file); // This can throw
             file.close(); // Close the file as soon as parsing is done
 
-            m_items.clear();
+            clearItems();
             int maxId = 0;
 
             if (data.contains(m_jsonArrayKey) &&
                 data[m_jsonArrayKey].is_array()) {
                 for (const auto& itemJson : data[m_jsonArrayKey]) {
-                    try {
-                        T item = itemJson.get<T>();
-                        // Assuming T has a method like getId()
-                        // This method name 'getId()' must be consistent across
-                        // types T (Recipe, Restaurant)
-                        if (item.getId() > 0) {
-                            m_items.push_back(item);
-                            if (item.getId() > maxId) {
-                                maxId = item.getId();
-                            }
-                        } else {
-                            std::cerr << "Warning: Invalid ID (<=0) found "
-                                         "while loading "
-                                      << m_jsonArrayKey
-                                      << ". Skipped: " << itemJson.dump(2)
-                                      << std::endl;
-                        }
-                    } catch (const std::exception& e) {
-                        std::cerr << "Warning: Failed to load an item for "
-                                  << m_jsonArrayKey
-                                  << " due to error: " << e.what()
-                                  << ". Invalid JSON: " << itemJson.dump(2)
-                                  << std::endl;
-                    }
+                    addLoadedItem(itemJson, maxId);
                 }
             }
             m_nextId = maxId + 1;
@@ -110,7 +106,7 @@ class JsonRepositoryBase {
             if (file.is_open()) { // Ensure file is closed on error
                 file.close();
             }
-            m_items.clear();
+            clearItems();
             m_nextId = 1;
             return false;
         } catch (const std::exception& e) {
@@ -119,7 +115,7 @@ class JsonRepositoryBase {
             if (file.is_open()) { // Ensure file is closed on error
                 file.close();
             }
-            m_items.clear();
+            clearItems();
             m_nextId = 1;
             return false;
         }
@@ -132,14 +128,6 @@ class JsonRepositoryBase {
 
     bool saveAll() {  // This should be protected or private if only called by
                       // save/remove
-        json dataDoc;
-        json itemsJsonArray = json::array();
-
-        for (const auto& item : m_items) {
-            itemsJsonArray.push_back(item);
-        }
-        dataDoc[m_jsonArrayKey] = itemsJsonArray;
-
         std::filesystem::path filePathObj(m_filePath);
         std::filesystem::path tempFilePathObj = filePathObj;
         tempFilePathObj += ".tmp";
@@ -167,7 +155,7 @@ class JsonRepositoryBase {
         }
 
         try {
-            tempFile << dataDoc.dump(2);
+            tempFile << serializeAll();
             tempFile.close();
             if (tempFile.fail()) {
                 std::cerr
@@ -219,17 +207,171 @@ class JsonRepositoryBase {
         }
     }
 
+   private:
+    // Validates one parsed item and adds it to m_items, tracking the max ID.
+    void addLoadedItem(const json& itemJson, int& maxId) {
+        try {
+            T item = itemJson.get<T>();
+            // Assuming T has a method like getId()
+            // This method name 'getId()' must be consistent across
+            // types T (Recipe, Restaurant)
+            if (item.getId() > 0) {
+                m_positions.emplace(item.getId(), m_items.size());
+                m_items.push_back(item);
+                if (item.getId() > maxId) {
+                    maxId = item.getId();
+                }
+            } else {
+                std::cerr << "Warning: Invalid ID (<=0) found "
+                             "while loading "
+                          << m_jsonArrayKey
+                          << ". Skipped: " << itemJson.dump(2)
+                          << std::endl;
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "Warning: Failed to load an item for "
+                      << m_jsonArrayKey
+                      << " due to error: " << e.what()
+                      << ". Invalid JSON: " << itemJson.dump(2)
+                      << std::endl;
+        }
+    }
+
+    bool loadNdjson(std::ifstream& file) {
+        clearItems();
+        int maxId = 0;
+        std::string line;
+        std::size_t lineNumber = 0;
+        while (std::getline(file, line)) {
+            ++lineNumber;
+            if (line.find_first_not_of(" \t\r\xEF\xBB\xBF") == std::string::npos) {
+                continue;  // Blank line (or a lone BOM)
+            }
+            try {
+                addLoadedItem(json::parse(line), maxId);
+            } catch (const json::parse_error& e) {
+                std::cerr << "Warning: Skipping corrupt line " << lineNumber
+                          << " in " << m_filePath << " (" << m_jsonArrayKey
+                          << "): " << e.what() << std::endl;
+            }
+        }
+        m_nextId = maxId + 1;
+        return true;
+    }
+
+    std::string serializeAll() const {
+        if (isNdjson()) {
+            std::string out;
+            for (const auto& item : m_items) {
+                out += json(item).dump();
+                out += '\n';
+            }
+            return out;
+        }
+        json dataDoc;
+        json itemsJsonArray = json::array();
+
+        for (const auto& item : m_items) {
+            itemsJsonArray.push_back(item);
+        }
+        dataDoc[m_jsonArrayKey] = itemsJsonArray;
+        return dataDoc.dump(2);
+    }
+
+    // NDJSON only: persists new items by appending one line each.
+    template <typename It>
+    bool appendItems(It first, It last) {
+        std::filesystem::path filePathObj(m_filePath);
+        if (!filePathObj.parent_path().empty() &&
+            !std::filesystem::exists(filePathObj.parent_path())) {
+            std::error_code ec;
+            std::filesystem::create_directories(filePathObj.parent_path(), ec);
+        }
+        std::ofstream file(m_filePath, std::ios::out | std::ios::app);
+        if (!file.is_open()) {
+            std::cerr << "Error: Could not open data file for appending: "
+                      << m_filePath << std::endl;
+            return false;
+        }
+        std::string lines;
+        // A last line without its newline (hand-edited or truncated file)
+        // would otherwise absorb the first appended record
+        if (!endsWithNewlineOrEmpty()) {
+            lines += '\n';
+        }
+        for (; first != last; ++first) {
+            lines += json(*first).dump();
+            lines += '\n';
+        }
+        file << lines;
+        file.close();
+        if (file.fail()) {
+            std::cerr << "Error: Failed to append to data file: "
+                      << m_filePath << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    bool endsWithNewlineOrEmpty() const {
+        std::ifstream file(m_filePath, std::ios::in | std::ios::binary);
+        if (!file.is_open() || !file.seekg(0, std::ios::end) ||
+            file.tellg() <= 0) {
+            return true;
+        }
+        char last = '\n';
+        file.seekg(-1, std::ios::end);
+        file.get(last);
+        return last == '\n';
+    }
+
+    void clearItems() {
+        m_items.clear();
+        m_positions.clear();
+    }
+
+    // After an erase shifts the items that follow it.
+    void rebuildPositions() {
+        m_positions.clear();
+        m_positions.reserve(m_items.size());
+        for (std::size_t i = 0; i < m_items.size(); ++i) {
+            m_positions.emplace(m_items[i].getId(), i);
+        }
+    }
+
+    void pushItem(const T& item) {
+        m_positions.emplace(item.getId(), m_items.size());
+        m_items.push_back(item);
+    }
+
    protected:  // Common operations for derived classes
+    const T* findItem(int itemId) const {
+        auto it = m_positions.find(itemId);
+        return it == m_positions.end() ? nullptr : &m_items[it->second];
+    }
+
     std::optional<T> findByIdInternal(int itemId) const {
-        auto it = std::find_if(
-            m_items.begin(), m_items.end(),
-            [itemId](const T& item) { return item.getId() == itemId; });
-        if (it != m_items.end()) {
-            return *it;
+        if (const T* item = findItem(itemId)) {
+            return *item;
         }
         return std::nullopt;
     }
 
+    // Items for the given IDs, in the order of ids. Unknown IDs are skipped
+    // and repeated IDs are returned once. O(ids) regardless of the item count.
+    std::vector<T> findManyByIdsInternal(const std::vector<int>& ids) const {
+        std::vector<T> results;
+        results.reserve(ids.size());
+        std::unordered_set<int> seen;
+        for (int id : ids) {
+            const T* item = findItem(id);
+            if (item && seen.insert(id).second) {
+                results.push_back(*item);
+            }
+        }
+        return results;
+    }
+
     std::vector<T> findAllInternal() const { return m_items; }
 
     // Derived classes will call this after preparing the item (e.g., assigning
@@ -241,10 +383,10 @@ class JsonRepositoryBase {
         bool alreadyExisted = false;
 
         if (!isNewItem) {  // Attempt to find and update
-            auto it = std::find_if(
-                m_items.begin(), m_items.end(), [&itemWithFinalId](const T& r) {
-                    return r.getId() == itemWithFinalId.getId();
-                });
+            auto position = m_positions.find(itemWithFinalId.getId());
+            auto it = position == m_positions.end()
+                          ? m_items.end()
+                          : m_items.begin() + static_cast<std::ptrdiff_t>(position->second);
             if (it != m_items.end()) {
                 originalItemOpt = *it;  // Save for potential rollback
                 *it = itemWithFinalId;  // Update
@@ -269,55 +411,106 @@ class JsonRepositoryBase {
             // Check for duplicate ID before adding, though m_nextId should
             // prevent this for auto-generated IDs. This is more for cases where
             // IDs might be set externally before calling add.
-            auto it_dup_check = std::find_if(
-                m_items.begin(), m_items.end(), [&itemWithFinalId](const T& r) {
-                    return r.getId() == itemWithFinalId.getId();
-                });
-            if (it_dup_check != m_items.end()) {
+            if (m_positions.count(itemWithFinalId.getId())) {
                 std::cerr
                     << "Error: Attempted to add new item with duplicate ID "
                     << itemWithFinalId.getId() << std::endl;
                 return false;  // Duplicate ID for a new item
             }
-            m_items.push_back(itemWithFinalId);
+            pushItem(itemWithFinalId);
         }
 
-        if (saveAll()) {
+        bool persisted = (isNewItem && isNdjson())
+                             ? appendItems(&itemWithFinalId, &itemWithFinalId + 1)
+                             : saveAll();
+        if (persisted) {
             return true;
         } else {
             // Persistence failed, roll back memory changes
             if (!isNewItem && alreadyExisted &&
                 originalItemOpt.has_value()) {  // Rollback update
-                auto it = std::find_if(m_items.begin(), m_items.end(),
-                                       [&itemWithFinalId](const T& r) {
-                                           return r.getId() ==
-                                                  itemWithFinalId.getId();
-                                       });
-                if (it != m_items.end()) {
-                    *it = originalItemOpt.value();
+                auto position = m_positions.find(itemWithFinalId.getId());
+                if (position != m_positions.end()) {
+                    m_items[position->second] = originalItemOpt.value();
                 }
             } else if (isNewItem) {  // Rollback add
-                m_items.erase(std::remove_if(m_items.begin(), m_items.end(),
-                                             [&itemWithFinalId](const T& r) {
-                                                 return r.getId() ==
-                                                        itemWithFinalId.getId();
-                                             }),
-                              m_items.end());
+                // The new item was appended, so it is the last one
+                m_positions.erase(itemWithFinalId.getId());
+                m_items.pop_back();
             }
             return false;
         }
     }
 
+    // Adds a batch of new items (IDs already assigned and unique) with a
+    // single write. On failure none of them are kept in memory.
+    bool addItemsInMemoryAndPersist(const std::vector<T>& newItems) {
+        if (newItems.empty()) {
+            return true;
+        }
+        const std::size_t previousSize = m_items.size();
+        m_items.reserve(previousSize + newItems.size());
+        for (const auto& item : newItems) {
+            pushItem(item);
+        }
+        bool persisted = isNdjson()
+                             ? appendItems(newItems.begin(), newItems.end())
+                             : saveAll();
+        if (!persisted) {
+            for (const auto& item : newItems) {
+                m_positions.erase(item.getId());
+            }
+            m_items.erase(m_items.begin() + previousSize, m_items.end());
+        }
+        return persisted;
+    }
+
+    // Replaces a batch of existing items (matched by ID) with a single write.
+    // Fails without changing anything if any ID is unknown; on a failed write
+    // the previous versions are restored.
+    bool updateItemsInMemoryAndPersist(const std::vector<T>& updatedItems) {
+        if (updatedItems.empty()) {
+            return true;
+        }
+        std::vector<std::size_t> targets;
+        targets.reserve(updatedItems.size());
+        for (const auto& item : updatedItems) {
+            auto it = m_positions.find(item.getId());
+            if (it == m_positions.end()) {
+                std::cerr << "Warning: Attempted to update item ID "
+                          << item.getId() << " which was not found."
+                          << std::endl;
+                return false;
+            }
+            targets.push_back(it->second);
+        }
+
+        std::vector<T> originals;
+        originals.reserve(targets.size());
+        for (std::size_t i = 0; i < targets.size(); ++i) {
+            originals.push_back(m_items[targets[i]]);
+            m_items[targets[i]] = updatedItems[i];
+        }
+        if (saveAll()) {
+            return true;
+        }
+        // Restore in reverse so a repeated ID ends up with its first original
+        for (std::size_t i = targets.size(); i-- > 0;) {
+            m_items[targets[i]] = std::move(originals[i]);
+        }
+        return false;
+    }
+
     bool removeItemInMemoryAndPersist(int itemId) {
         std::optional<T>
             itemToRemoveOpt;  // Use optional to avoid default construction
-        auto it = std::find_if(
-            m_items.begin(), m_items.end(),
-            [itemId](const T& item) { return item.getId() == itemId; });
+        auto position = m_positions.find(itemId);
 
-        if (it != m_items.end()) {
+        if (position != m_positions.end()) {
+            auto it = m_items.begin() + static_cast<std::ptrdiff_t>(position->second);
             itemToRemoveOpt = *it;  // Save for potential rollback
             m_items.erase(it);
+            rebuildPositions();
             // found = true; // No longer needed, check itemToRemoveOpt
 
             if (saveAll()) {
@@ -329,7 +522,7 @@ class JsonRepositoryBase {
                 // Persistence failed, roll back the removal from memory
                 if (itemToRemoveOpt.has_value()) {  // Check if we have
                                                     // something to roll back
-                    m_items.push_back(itemToRemoveOpt.value());
+                    pushItem(itemToRemoveOpt.value());
                     // TODO: Consider re-inserting at original position if order
                     // matters and is feasible. For now, push_back is simpler.
                     // Sorting m_items by ID afterwards might be an option.
@@ -65,6 +65,7 @@ int JsonRestaurantRepository::save(
         // No optional fields like nutritionalInfo or imageUrl in Restaurant
         // based on Restaurant.h
         restaurantWithCorrectId = builder.build();
+        restaurantWithCorrectId.setLocation(restaurantToSave.getLocation());
     }
     // For updates, restaurantToSave (now restaurantWithCorrectId) already has
     // the correct ID.
@@ -90,6 +91,12 @@ bool JsonRestaurantRepository::remove(int restaurantId) {
     return false;
 }
 
+bool JsonRestaurantRepository::updateMany(
+    const std::vector<::RecipeApp::Restaurant> &restaurants) {
+    // One rewrite of the data file for the whole batch
+    return this->updateItemsInMemoryAndPersist(restaurants);
+}
+
 int JsonRestaurantRepository::getNextId() const {
     return JsonRepositoryBase<Restaurant>::getNextId();
 }
@@ -38,6 +38,8 @@ class JsonRestaurantRepository
     std::vector<::RecipeApp::Restaurant> findAll() const override;
     int save(const ::RecipeApp::Restaurant &restaurant) override;
     bool remove(int restaurantId) override;
+    bool updateMany(
+        const std::vector<::RecipeApp::Restaurant> &restaurants) override;
 
     int getNextId() const override;
     void setNextId(int nextId) override;
@@ -0,0 +1,57 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace RecipeApp {
+namespace Persistence {
+
+/**
+ * @brief Read-only memory mapping of a whole file (mmap on POSIX,
+ *        CreateFileMapping on Windows). Pages are loaded by the OS on first
+ *        access, so opening a large file costs almost nothing up front.
+ */
+class MappedFile {
+   public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * @brief Maps the file, closing any previous mapping first.
+     * @param filepath Path of the file to map.
+     * @return True on success. An empty file maps to an empty view.
+     */
+    bool open(const std::string& filepath);
+
+    void close();
+
+    bool isOpen() const { return m_open; }
+    const char* data() const { return m_data; }
+    std::size_t size() const { return m_size; }
+    std::string_view view() const { return std::string_view(m_data, m_size); }
+
+   private:
+    const char* m_data = nullptr;
+    std::size_t m_size = 0;
+    bool m_open = false;
+#ifdef _WIN32
+    void* m_fileHandle = nullptr;
+    void* m_mappingHandle = nullptr;
+#else
+    int m_fd = -1;
+#endif
+
+    void moveFrom(MappedFile& other) noexcept;
+};
+
+}  // namespace Persistence
+}  // namespace RecipeApp
+
+#endif  // MAPPED_FILE_H
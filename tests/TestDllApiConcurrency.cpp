@@ -0,0 +1,399 @@
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <set>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "domain/recipe/Recipe.h"
+#include "gtest/gtest.h"
+#include "json.hpp"
+#include "logic/encyclopedia/RecipeEncyclopediaManager.h"
+#include "spdlog/spdlog.h"
+
+// The C API of src/api/dll_api.cpp, compiled into this test
+extern "C" {
+void initialize_recipe_system();
+void shutdown_recipe_system();
+void free_allocated_string(char *str_ptr);
+char *get_all_recipes_json_alloc();
+char *get_recipe_by_id_json(int recipe_id);
+char *add_recipe_json(const char *recipe_json_str);
+char *update_recipe_json(const char *recipe_json_str);
+char *delete_recipe_json(int recipe_id);
+char *search_encyclopedia_recipes_json_alloc(const char *search_term_str);
+char *apply_encyclopedia_patch(const char *patch_file_path);
+std::size_t get_all_recipes_json_into(char *buffer, std::size_t capacity);
+std::size_t search_recipes_by_name_with_matches_json_into(
+    const char *name_query_str, char *buffer, std::size_t capacity);
+void *open_recipe_cursor(const char *query_json);
+char *cursor_next_batch(void *cursor, int n);
+std::size_t cursor_next_batch_into(void *cursor, int n, char *buffer, std::size_t capacity);
+void close_cursor(void *cursor);
+unsigned char *get_all_recipes_bin_alloc(int format);
+unsigned char *get_recipe_by_id_bin_alloc(int recipe_id, int format);
+unsigned char *search_encyclopedia_recipes_with_matches_bin_alloc(const char *search_term_str,
+                                                                 int format);
+char *search_encyclopedia_recipes_with_matches_json_alloc(const char *search_term_str);
+unsigned char *cursor_next_batch_bin_alloc(void *cursor, int n, int format);
+void free_allocated_binary(unsigned char *buffer);
+}
+
+using json = nlohmann::json;
+
+namespace {
+// Swallows the API's debug output; holds no state, so concurrent writes are safe
+class NullBuffer : public std::streambuf {
+   protected:
+    int overflow(int c) override { return c; }
+};
+
+RecipeApp::Recipe makeRecipe(int id, const std::string &name, int minutes) {
+    return RecipeApp::Recipe::builder(id, name)
+        .withIngredients({{"Rice", "1 cup"}})
+        .withSteps({"Cook"})
+        .withCookingTime(minutes)
+        .withDifficulty(RecipeApp::Difficulty::Easy)
+        .withTags({"Stress"})
+        .build();
+}
+
+// Calls an allocating API function and parses its result
+template <typename Call>
+json callAlloc(Call call) {
+    char *raw = call();
+    json result = json::parse(raw);
+    free_allocated_string(raw);
+    return result;
+}
+
+json callInto(const std::function<std::size_t(char *, std::size_t)> &call) {
+    std::vector<char> buffer(256);
+    std::size_t required = call(buffer.data(), buffer.size());
+    if (required > buffer.size()) {
+        buffer.resize(required);
+        required = call(buffer.data(), buffer.size());
+    }
+    // The result may grow between the two calls; retry until it fits
+    while (required > buffer.size()) {
+        buffer.resize(required);
+        required = call(buffer.data(), buffer.size());
+    }
+    return json::parse(buffer.data());
+}
+
+constexpr int kCbor = 1;
+constexpr int kMsgpack = 2;
+
+// Decodes a length-prefixed binary result and frees it
+json decodeBinary(unsigned char *raw, int format) {
+    std::uint32_t length = raw[0] | raw[1] << 8 | raw[2] << 16 | std::uint32_t(raw[3]) << 24;
+    const unsigned char *payload = raw + 4;
+    json result = format == kCbor ? json::from_cbor(payload, payload + length)
+                                  : json::from_msgpack(payload, payload + length);
+    free_allocated_binary(raw);
+    return result;
+}
+}  // namespace
+
+class DllApiConcurrencyTest : public ::testing::Test {
+   protected:
+    std::filesystem::path dir =
+        std::filesystem::temp_directory_path() / "dll_api_concurrency_test";
+    std::filesystem::path previousDir;
+    NullBuffer nullBuffer;
+    std::streambuf *previousCout = nullptr;
+
+    void SetUp() override {
+        // initialize_recipe_system() works in ./data
+        std::filesystem::remove_all(dir);
+        std::filesystem::create_directories(dir / "data");
+        previousDir = std::filesystem::current_path();
+        std::filesystem::current_path(dir);
+        std::ofstream(dir / "data" / "encyclopedia_recipes.json")
+            << json{makeRecipe(1001, "Stress Soup", 10),
+                    makeRecipe(1002, "Stress Stew", 20)}
+                   .dump();
+        previousCout = std::cout.rdbuf(&nullBuffer);
+        spdlog::set_level(spdlog::level::warn);
+    }
+
+    void TearDown() override {
+        std::cout.rdbuf(previousCout);
+        std::filesystem::current_path(previousDir);
+        std::filesystem::remove_all(dir);
+    }
+};
+
+TEST_F(DllApiConcurrencyTest, InitializationIsReferenceCounted) {
+    initialize_recipe_system();
+    initialize_recipe_system();
+    json all = callAlloc(get_all_recipes_json_alloc);
+    ASSERT_TRUE(all.is_array());
+    std::size_t seeded = all.size();  // Initialization seeds sample recipes once
+    EXPECT_EQ(seeded, 2u);
+
+    shutdown_recipe_system();
+    EXPECT_TRUE(callAlloc(get_all_recipes_json_alloc).is_array());  // Still referenced
+    shutdown_recipe_system();
+    EXPECT_TRUE(callAlloc(get_all_recipes_json_alloc).contains("error"));
+    shutdown_recipe_system();  // Unbalanced call is ignored
+}
+
+TEST_F(DllApiConcurrencyTest, ParallelReadersAndWriters) {
+    initialize_recipe_system();
+    std::size_t seeded = callAlloc(get_all_recipes_json_alloc).size();
+
+    constexpr int kWriters = 4;
+    constexpr int kRecipesPerWriter = 20;
+    constexpr int kReaders = 4;
+    std::atomic<bool> writersDone{false};
+    std::atomic<int> failures{0};
+    std::atomic<long> reads{0};
+
+    std::vector<std::thread> threads;
+    for (int w = 0; w < kWriters; ++w) {
+        threads.emplace_back([&, w] {
+            for (int i = 0; i < kRecipesPerWriter; ++i) {
+                std::string name = "Stress " + std::to_string(w) + "-" + std::to_string(i);
+                // The ID in the JSON must be valid but is replaced on insertion
+                json added = callAlloc([&] {
+                    return add_recipe_json(json(makeRecipe(1, name, 5)).dump().c_str());
+                });
+                if (!added.value("success", false)) {
+                    ++failures;
+                    continue;
+                }
+                int id = added["id"];
+                json updated = callAlloc([&] {
+                    return update_recipe_json(json(makeRecipe(id, name, 15)).dump().c_str());
+                });
+                if (!updated.value("success", false)) ++failures;
+                // Every other recipe is deleted again
+                if (i % 2 == 1) {
+                    json deleted = callAlloc([&] { return delete_recipe_json(id); });
+                    if (!deleted.value("success", false)) ++failures;
+                }
+            }
+        });
+    }
+    for (int r = 0; r < kReaders; ++r) {
+        threads.emplace_back([&, r] {
+            while (!writersDone) {
+                json all = r % 2 ? callAlloc(get_all_recipes_json_alloc)
+                                 : callInto(get_all_recipes_json_into);
+                if (!all.is_array() || all.size() < seeded) {
+                    ++failures;
+                    continue;
+                }
+                // A listed recipe is either still there or was deleted meanwhile
+                int id = all.back()["id"];
+                json byId = callAlloc([id] { return get_recipe_by_id_json(id); });
+                if (byId.value("id", 0) != id && byId.value("error", "") != "Recipe not found") {
+                    ++failures;
+                }
+                json hits = callInto([](char *buffer, std::size_t capacity) {
+                    return search_recipes_by_name_with_matches_json_into("stress", buffer, capacity);
+                });
+                json encyclopedia = callAlloc([] { return search_encyclopedia_recipes_json_alloc("Stress"); });
+                if (!hits.is_array() || encyclopedia.size() != 2) ++failures;
+                ++reads;
+            }
+        });
+    }
+    // Nested initialize/shutdown pairs must not tear the system down under the workers
+    threads.emplace_back([&] {
+        for (int i = 0; i < 20; ++i) {
+            initialize_recipe_system();
+            shutdown_recipe_system();
+        }
+    });
+
+    for (int i = 0; i < kWriters; ++i) threads[i].join();
+    writersDone = true;
+    for (std::size_t i = kWriters; i < threads.size(); ++i) threads[i].join();
+
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_GT(reads.load(), 0);
+    json all = callAlloc(get_all_recipes_json_alloc);
+    EXPECT_EQ(all.size(), seeded + kWriters * kRecipesPerWriter / 2);
+    for (const auto &recipe : all) {
+        if (recipe["name"].get<std::string>().rfind("Stress", 0) == 0) {
+            EXPECT_EQ(recipe["cookingTime"], 15);
+        }
+    }
+    shutdown_recipe_system();
+}
+
+TEST_F(DllApiConcurrencyTest, CursorsStreamInBatchesWhileWritersRun) {
+    initialize_recipe_system();
+    std::vector<int> ids;
+    for (int i = 0; i < 30; ++i) {
+        json added = callAlloc([i] {
+            return add_recipe_json(json(makeRecipe(1, "Cursor " + std::to_string(i), 5)).dump().c_str());
+        });
+        ids.push_back(added["id"]);
+    }
+
+    void *cursor = open_recipe_cursor(R"({"search": "cursor"})");
+    ASSERT_NE(cursor, nullptr);
+    // Deletions after opening are skipped, never returned or duplicated
+    std::thread deleter([&] {
+        for (std::size_t i = 0; i < ids.size(); i += 3) {
+            free_allocated_string(delete_recipe_json(ids[i]));
+        }
+    });
+    std::set<int> seen;
+    for (;;) {
+        json batch = callAlloc([cursor] { return cursor_next_batch(cursor, 4); });
+        ASSERT_TRUE(batch.is_array()) << batch.dump();
+        if (batch.empty()) break;
+        EXPECT_LE(batch.size(), 4u);
+        for (const auto &recipe : batch) {
+            EXPECT_TRUE(seen.insert(recipe["id"].get<int>()).second);
+        }
+    }
+    deleter.join();
+    close_cursor(cursor);
+    EXPECT_GE(seen.size(), ids.size() - 10);
+    EXPECT_LE(seen.size(), ids.size());
+
+    // A too-small buffer leaves the cursor in place
+    cursor = open_recipe_cursor(R"({"source": "encyclopedia", "search": "Stress"})");
+    ASSERT_NE(cursor, nullptr);
+    char tiny[8];
+    std::size_t required = cursor_next_batch_into(cursor, 1, tiny, sizeof(tiny));
+    ASSERT_GT(required, sizeof(tiny));
+    std::vector<char> buffer(required);
+    ASSERT_EQ(cursor_next_batch_into(cursor, 1, buffer.data(), buffer.size()), required);
+    EXPECT_EQ(json::parse(buffer.data())[0]["name"], "Stress Soup");
+    EXPECT_EQ(callAlloc([cursor] { return cursor_next_batch(cursor, 10); })[0]["name"], "Stress Stew");
+    EXPECT_TRUE(callAlloc([cursor] { return cursor_next_batch(cursor, 10); }).empty());
+    close_cursor(cursor);
+
+    // Streaming the whole encyclopedia, then invalidation by shutdown
+    cursor = open_recipe_cursor(R"({"source": "encyclopedia"})");
+    EXPECT_EQ(callAlloc([cursor] { return cursor_next_batch(cursor, 10); }).size(), 2u);
+    shutdown_recipe_system();
+    initialize_recipe_system();
+    EXPECT_TRUE(callAlloc([cursor] { return cursor_next_batch(cursor, 10); }).contains("error"));
+    close_cursor(cursor);
+
+    EXPECT_EQ(open_recipe_cursor(R"({"source": "menus"})"), nullptr);
+    EXPECT_EQ(open_recipe_cursor("not json"), nullptr);
+    shutdown_recipe_system();
+}
+
+TEST_F(DllApiConcurrencyTest, CursorSkipsBatchesDeletedAfterOpening) {
+    initialize_recipe_system();
+    std::vector<int> ids;
+    for (int i = 0; i < 12; ++i) {
+        json added = callAlloc([i] {
+            return add_recipe_json(json(makeRecipe(1, "Gap " + std::to_string(i), 5)).dump().c_str());
+        });
+        ids.push_back(added["id"]);
+    }
+    void *cursor = open_recipe_cursor(R"({"search": "gap"})");
+    ASSERT_NE(cursor, nullptr);
+    // Two whole batches are deleted: [0, 4) and [4, 8)
+    for (int i = 0; i < 8; ++i) free_allocated_string(delete_recipe_json(ids[i]));
+
+    json batch = callAlloc([cursor] { return cursor_next_batch(cursor, 4); });
+    ASSERT_EQ(batch.size(), 4u) << batch.dump();
+    EXPECT_EQ(batch[0]["id"], ids[8]);
+    EXPECT_EQ(batch[3]["id"], ids[11]);
+    EXPECT_TRUE(callAlloc([cursor] { return cursor_next_batch(cursor, 4); }).empty());
+    close_cursor(cursor);
+    shutdown_recipe_system();
+}
+
+TEST_F(DllApiConcurrencyTest, BinaryVariantsMatchJson) {
+    initialize_recipe_system();
+    for (int format : {kCbor, kMsgpack}) {
+        EXPECT_EQ(decodeBinary(get_all_recipes_bin_alloc(format), format),
+                  callAlloc(get_all_recipes_json_alloc));
+        EXPECT_EQ(decodeBinary(search_encyclopedia_recipes_with_matches_bin_alloc("stress", format),
+                               format),
+                  callAlloc([] { return search_encyclopedia_recipes_with_matches_json_alloc("stress"); }));
+        EXPECT_EQ(decodeBinary(get_recipe_by_id_bin_alloc(-5, format), format),
+                  callAlloc([] { return get_recipe_by_id_json(-5); }));
+
+        void *cursor = open_recipe_cursor(R"({"source": "encyclopedia"})");
+        json first = decodeBinary(cursor_next_batch_bin_alloc(cursor, 1, format), format);
+        json rest = decodeBinary(cursor_next_batch_bin_alloc(cursor, 10, format), format);
+        ASSERT_EQ(first.size(), 1u);
+        ASSERT_EQ(rest.size(), 1u);
+        EXPECT_EQ(first[0]["name"], "Stress Soup");
+        EXPECT_EQ(rest[0]["name"], "Stress Stew");
+        close_cursor(cursor);
+    }
+    EXPECT_EQ(get_all_recipes_bin_alloc(3), nullptr);
+    free_allocated_binary(nullptr);
+    shutdown_recipe_system();
+}
+
+TEST_F(DllApiConcurrencyTest, EncyclopediaPatchExcludesReaders) {
+    initialize_recipe_system();
+    void *cursor = open_recipe_cursor(R"({"source": "encyclopedia"})");
+    ASSERT_NE(cursor, nullptr);
+
+    std::atomic<bool> patched{false};
+    std::atomic<int> failures{0};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; ++r) {
+        readers.emplace_back([&] {
+            while (!patched) {
+                // Readers see the encyclopedia either before or after the patch
+                json hits = callAlloc([] { return search_encyclopedia_recipes_json_alloc("stress"); });
+                if (!hits.is_array() || (hits.size() != 2 && hits.size() != 3)) ++failures;
+            }
+        });
+    }
+    std::ofstream(dir / "patch.ndjson")
+        << json{{"op", "remove"}, {"id", 1001}}.dump() << "\n"
+        << json{{"op", "add"}, {"recipe", makeRecipe(1003, "Stress Pie", 30)}}.dump() << "\n"
+        << json{{"op", "add"}, {"recipe", makeRecipe(1004, "Stress Cake", 40)}}.dump() << "\n"
+        << json{{"op", "remove"}, {"id", 4242}}.dump() << "\n";
+    json result = callAlloc([this] {
+        return apply_encyclopedia_patch((dir / "patch.ndjson").string().c_str());
+    });
+    patched = true;
+    for (auto &reader : readers) reader.join();
+    EXPECT_EQ(failures, 0);
+
+    EXPECT_TRUE(result.value("success", false)) << result.dump();
+    EXPECT_EQ(result["added"], 2);
+    EXPECT_EQ(result["removed"], 1);
+    EXPECT_EQ(result["skipped"], 1);
+    std::set<std::string> names;
+    for (const auto &recipe : callAlloc([] { return search_encyclopedia_recipes_json_alloc("stress"); })) {
+        names.insert(recipe["name"].get<std::string>());
+    }
+    EXPECT_EQ(names, (std::set<std::string>{"Stress Stew", "Stress Pie", "Stress Cake"}));
+
+    // Positions shifted under the old cursor
+    EXPECT_TRUE(callAlloc([cursor] { return cursor_next_batch(cursor, 1); }).contains("error"));
+    close_cursor(cursor);
+    json missing = callAlloc([] { return apply_encyclopedia_patch("no_such_patch.json"); });
+    EXPECT_FALSE(missing.value("success", true));
+    shutdown_recipe_system();
+}
+
+TEST_F(DllApiConcurrencyTest, InitializationPrefersTheEncyclopediaBundle) {
+    ASSERT_TRUE(RecipeApp::Logic::Encyclopedia::RecipeEncyclopediaManager::compileBundle(
+        (dir / "data" / "encyclopedia_recipes.json").string(),
+        (dir / "data" / "encyclopedia_recipes.bundle").string()));
+    // Only the bundle is left to load from
+    std::filesystem::remove(dir / "data" / "encyclopedia_recipes.json");
+    initialize_recipe_system();
+    json hits = callAlloc([] { return search_encyclopedia_recipes_json_alloc("stew"); });
+    ASSERT_EQ(hits.size(), 1u) << hits.dump();
+    EXPECT_EQ(hits[0]["id"], 1002);
+    shutdown_recipe_system();
+}
@@ -0,0 +1,126 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "domain/recipe/Recipe.h"
+#include "gtest/gtest.h"
+#include "logic/encyclopedia/RecipeEncyclopediaManager.h"
+#include "logic/recipe/RecipeManager.h"
+#include "logic/search/FederatedSearchService.h"
+#include "persistence/JsonRecipeRepository.h"
+
+using RecipeApp::Logic::Search::FederatedSearchHit;
+using RecipeApp::Logic::Search::FederatedSearchService;
+using RecipeApp::Logic::Search::RecipeSource;
+
+namespace {
+RecipeApp::Recipe makeRecipe(int id, const std::string& name,
+                             const std::vector<std::string>& ingredients,
+                             const std::vector<std::string>& tags) {
+    std::vector<RecipeApp::Ingredient> items;
+    for (const auto& ingredient : ingredients) {
+        items.push_back({ingredient, "1"});
+    }
+    return RecipeApp::Recipe::builder(id, name)
+        .withIngredients(items)
+        .withSteps({"cook"})
+        .withCookingTime(20)
+        .withDifficulty(RecipeApp::Difficulty::Easy)
+        .withTags(tags)
+        .build();
+}
+}  // namespace
+
+class FederatedSearchServiceTest : public ::testing::Test {
+   protected:
+    std::filesystem::path tempDir;
+    std::string encyclopediaPath = "test_federated_encyclopedia.json";
+    std::unique_ptr<RecipeApp::Persistence::JsonRecipeRepository> repository;
+    std::unique_ptr<RecipeApp::RecipeManager> recipeManager;
+    RecipeApp::Logic::Encyclopedia::RecipeEncyclopediaManager encyclopediaManager;
+
+    void SetUp() override {
+        tempDir = std::filesystem::current_path() /
+                  ("test_federated_" + std::to_string(std::chrono::steady_clock::now()
+                                                          .time_since_epoch()
+                                                          .count()));
+        std::filesystem::create_directories(tempDir);
+        repository = std::make_unique<RecipeApp::Persistence::JsonRecipeRepository>(tempDir);
+        recipeManager = std::make_unique<RecipeApp::RecipeManager>(*repository);
+        recipeManager->addRecipe(makeRecipe(0, "Chicken Soup", {"Chicken", "Water"}, {"soup"}));
+        recipeManager->addRecipe(makeRecipe(0, "Kung Pao Chicken", {"Chicken", "Peanut"}, {"spicy"}));
+        recipeManager->addRecipe(makeRecipe(0, "Fruit Salad", {"Apple"}, {"dessert"}));
+
+        std::ofstream out(encyclopediaPath);
+        nlohmann::json entries = nlohmann::json::array();
+        // Already imported into the user catalogue: must not show up twice
+        entries.push_back(makeRecipe(1001, "Kung Pao Chicken (百科)", {"Chicken", "Peanut"}, {"sichuan"}));
+        entries.push_back(makeRecipe(1002, "Chicken", {"Chicken", "Salt"}, {"roast"}));
+        entries.push_back(makeRecipe(1003, "Beef Stew", {"Beef", "Chicken Stock"}, {"stew"}));
+        entries.push_back(makeRecipe(1004, "Tofu", {"Tofu"}, {"vegan"}));
+        out << entries.dump();
+        out.close();
+        ASSERT_TRUE(encyclopediaManager.loadRecipes(encyclopediaPath));
+    }
+
+    void TearDown() override {
+        recipeManager.reset();
+        repository.reset();
+        std::filesystem::remove_all(tempDir);
+        std::remove(encyclopediaPath.c_str());
+    }
+};
+
+TEST_F(FederatedSearchServiceTest, ScoresNameAboveTagAboveIngredient) {
+    auto recipe = makeRecipe(1, "Chicken Soup", {"Chicken"}, {"soup"});
+    EXPECT_EQ(FederatedSearchService::scoreRecipe("chicken soup", recipe), 100);
+    EXPECT_GT(FederatedSearchService::scoreRecipe("chicken", recipe),
+              FederatedSearchService::scoreRecipe("soup", recipe) - 50);
+    EXPECT_GT(FederatedSearchService::scoreRecipe("soup", recipe),
+              FederatedSearchService::scoreRecipe("chick", makeRecipe(2, "Stew", {"Chicken"}, {})));
+    EXPECT_EQ(FederatedSearchService::scoreRecipe("pork", recipe), 0);
+    EXPECT_EQ(FederatedSearchService::normalizeName("  Kung Pao (百科) "), "kung pao");
+}
+
+TEST_F(FederatedSearchServiceTest, MergesSourcesWithSharedRankingAndDedup) {
+    FederatedSearchService service(*recipeManager, encyclopediaManager);
+    std::vector<FederatedSearchHit> hits = service.search("chicken", 0);
+
+    // 2 user recipes + "Chicken" and "Beef Stew" from the encyclopedia; the
+    // imported Kung Pao Chicken entry is dropped.
+    ASSERT_EQ(hits.size(), 4);
+    EXPECT_EQ(hits[0].recipe.getName(), "Chicken");  // Exact name match first
+    EXPECT_EQ(hits[0].source, RecipeSource::Encyclopedia);
+    EXPECT_EQ(hits[1].recipe.getName(), "Chicken Soup");  // Prefix
+    EXPECT_EQ(hits[2].recipe.getName(), "Kung Pao Chicken");
+    EXPECT_EQ(hits[2].source, RecipeSource::UserCatalogue);
+    EXPECT_EQ(hits[3].recipe.getName(), "Beef Stew");  // Ingredient only
+    for (size_t i = 1; i < hits.size(); ++i) {
+        EXPECT_GE(hits[i - 1].score, hits[i].score);
+    }
+}
+
+TEST_F(FederatedSearchServiceTest, StreamsTopKAsSourcesArrive) {
+    FederatedSearchService service(*recipeManager, encyclopediaManager);
+    std::atomic<int> updates{0};
+    bool sawUser = false;
+    bool sawEncyclopedia = false;
+    auto hits = service.search("chicken", 2,
+                               [&](const std::vector<FederatedSearchHit>& topK, RecipeSource arrived) {
+                                   ++updates;
+                                   EXPECT_LE(topK.size(), 2u);
+                                   (arrived == RecipeSource::UserCatalogue ? sawUser : sawEncyclopedia) = true;
+                               });
+    EXPECT_EQ(updates.load(), 2);
+    EXPECT_TRUE(sawUser);
+    EXPECT_TRUE(sawEncyclopedia);
+    ASSERT_EQ(hits.size(), 2);
+    EXPECT_EQ(hits[0].recipe.getName(), "Chicken");
+    EXPECT_EQ(hits[1].recipe.getName(), "Chicken Soup");
+
+    EXPECT_TRUE(service.search("no such dish", 5).empty());
+}
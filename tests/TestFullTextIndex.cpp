@@ -0,0 +1,75 @@
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "logic/search/FullTextIndex.h"
+
+using RecipeApp::Logic::Search::FullTextIndex;
+
+class FullTextIndexTest : public ::testing::Test {
+   protected:
+    FullTextIndex index;
+
+    void SetUp() override {
+        index.addDocument(1, {"鸡肉切块，焯水。", "加入清水，小火慢炖一小时。"});
+        index.addDocument(2, {"Sear the beef, then stew slowly for 2 hours.", "Season with salt."});
+        index.addDocument(3, {"猪肉炖粉条", "Serve hot"});
+        index.addDocument(4, {"Slowly stir the sauce"});
+    }
+};
+
+TEST_F(FullTextIndexTest, TokenizeMixesWordsAndCjkBigrams) {
+    auto tokens = FullTextIndex::tokenize("Stew 慢炖锅", FullTextIndex::TokenizeMode::Query);
+    ASSERT_EQ(tokens.size(), 3);
+    EXPECT_EQ(tokens[0].term, "stew");
+    EXPECT_EQ(tokens[0].position, 0);
+    EXPECT_EQ(tokens[1].term, "慢炖");
+    EXPECT_EQ(tokens[1].position, 1);
+    EXPECT_EQ(tokens[2].term, "炖锅");
+    EXPECT_EQ(tokens[2].position, 2);
+
+    // Index mode adds a unigram per CJK character
+    auto indexTokens = FullTextIndex::tokenize("慢炖", FullTextIndex::TokenizeMode::Index);
+    EXPECT_EQ(indexTokens.size(), 3);
+}
+
+TEST_F(FullTextIndexTest, SingleCjkCharacterMatches) {
+    EXPECT_THAT(index.searchPhrase("炖"), testing::ElementsAre(1, 3));
+}
+
+TEST_F(FullTextIndexTest, CjkPhraseRequiresAdjacency) {
+    EXPECT_THAT(index.searchPhrase("小火慢炖"), testing::ElementsAre(1));
+    EXPECT_THAT(index.searchPhrase("慢火小炖"), testing::IsEmpty());
+    EXPECT_THAT(index.searchPhrase("猪肉炖粉条"), testing::ElementsAre(3));
+}
+
+TEST_F(FullTextIndexTest, WordPhraseIsCaseInsensitive) {
+    EXPECT_THAT(index.searchPhrase("STEW slowly"), testing::ElementsAre(2));
+    EXPECT_THAT(index.searchPhrase("slowly stew"), testing::IsEmpty());
+    EXPECT_THAT(index.searchAllTerms("slowly stew"), testing::ElementsAre(2));
+    EXPECT_THAT(index.searchAllTerms("slowly"), testing::ElementsAre(2, 4));
+}
+
+TEST_F(FullTextIndexTest, PhraseDoesNotSpanFields) {
+    // "hours." ends step one and "Season" starts step two
+    EXPECT_THAT(index.searchPhrase("hours season"), testing::IsEmpty());
+    EXPECT_THAT(index.searchPhrase("粉条 serve"), testing::IsEmpty());
+}
+
+TEST_F(FullTextIndexTest, RemoveAndReplaceDocuments) {
+    index.removeDocument(1);
+    EXPECT_THAT(index.searchPhrase("炖"), testing::ElementsAre(3));
+    index.addDocument(3, {"清蒸鱼"});
+    EXPECT_THAT(index.searchPhrase("炖"), testing::IsEmpty());
+    EXPECT_THAT(index.searchPhrase("清蒸"), testing::ElementsAre(3));
+    EXPECT_EQ(index.documentCount(), 3);
+    index.removeDocument(42);  // Unknown IDs are ignored
+    EXPECT_EQ(index.documentCount(), 3);
+}
+
+TEST_F(FullTextIndexTest, EmptyOrUnknownQueries) {
+    EXPECT_THAT(index.searchPhrase(""), testing::IsEmpty());
+    EXPECT_THAT(index.searchPhrase("，。"), testing::IsEmpty());
+    EXPECT_THAT(index.searchPhrase("烤箱"), testing::IsEmpty());
+}
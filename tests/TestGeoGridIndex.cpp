@@ -0,0 +1,111 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "logic/search/GeoGridIndex.h"
+
+using RecipeApp::GeoPoint;
+using RecipeApp::Logic::Search::GeoGridIndex;
+
+namespace {
+std::vector<int> keysOf(const std::vector<GeoGridIndex::Hit>& hits) {
+    std::vector<int> keys;
+    for (const auto& hit : hits) keys.push_back(hit.key);
+    return keys;
+}
+
+// Reference answer: rank every point
+std::vector<int> bruteForceNearest(const std::vector<GeoPoint>& points, const GeoPoint& origin,
+                                   std::size_t k) {
+    std::vector<std::pair<double, int>> ranked;
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        ranked.emplace_back(GeoPoint::distanceMeters(origin, points[i]), static_cast<int>(i));
+    }
+    std::sort(ranked.begin(), ranked.end());
+    std::vector<int> keys;
+    for (std::size_t i = 0; i < std::min(k, ranked.size()); ++i) keys.push_back(ranked[i].second);
+    return keys;
+}
+}  // namespace
+
+TEST(GeoGridIndexTest, NearestAndRadiusInACity) {
+    GeoGridIndex index;
+    index.insert(1, {39.9087, 116.3975});  // Tiananmen
+    index.insert(2, {39.9163, 116.3972});  // Forbidden City, ~850 m north
+    index.insert(3, {39.9990, 116.2755});  // Summer Palace, ~15 km
+    index.insert(4, {31.2304, 121.4737});  // Shanghai
+
+    GeoPoint origin{39.9087, 116.3975};
+    EXPECT_THAT(keysOf(index.nearest(origin, 2)), testing::ElementsAre(1, 2));
+    EXPECT_THAT(keysOf(index.nearest(origin, 10)), testing::ElementsAre(1, 2, 3, 4));
+    EXPECT_THAT(keysOf(index.withinRadius(origin, 1000)), testing::ElementsAre(1, 2));
+    EXPECT_THAT(keysOf(index.nearest(origin, 10, 20000)), testing::ElementsAre(1, 2, 3));
+    EXPECT_THAT(keysOf(index.nearest(origin, 10, 1e9, [](int key) { return key % 2 == 1; })),
+                testing::ElementsAre(1, 3));
+    EXPECT_NEAR(index.nearest(origin, 2)[1].distanceMeters, 845, 10);
+
+    auto inView = index.withinBounds(39.8, 116.2, 40.1, 116.5);
+    std::sort(inView.begin(), inView.end());
+    EXPECT_THAT(inView, testing::ElementsAre(1, 2, 3));
+    EXPECT_EQ(index.withinBounds(39.8, 116.2, 40.1, 116.5, 2).size(), 2u);
+}
+
+TEST(GeoGridIndexTest, MoveAndRemoveUpdateQueries) {
+    GeoGridIndex index;
+    index.insert(1, {10, 10});
+    index.insert(2, {10.5, 10});
+    index.insert(1, {50, 50});  // Moved
+    EXPECT_EQ(index.size(), 2u);
+    EXPECT_THAT(keysOf(index.nearest({10, 10}, 1)), testing::ElementsAre(2));
+    index.remove(2);
+    index.remove(99);
+    EXPECT_THAT(keysOf(index.nearest({10, 10}, 5)), testing::ElementsAre(1));
+    EXPECT_EQ(index.location(1)->latitude, 50);
+    EXPECT_FALSE(index.location(2).has_value());
+    EXPECT_THROW(index.insert(3, {91, 0}), std::invalid_argument);
+}
+
+TEST(GeoGridIndexTest, HandlesAntimeridianAndPoles) {
+    GeoGridIndex index(1.0);
+    index.insert(1, {0, 179.95});
+    index.insert(2, {0, -179.9});
+    index.insert(3, {0, 178.0});
+    index.insert(4, {89.9, 0});
+    index.insert(5, {89.9, 180});
+
+    EXPECT_THAT(keysOf(index.nearest({0, 180}, 2)), testing::ElementsAre(1, 2));
+    EXPECT_THAT(keysOf(index.withinRadius({0, -180}, 50000)), testing::ElementsAre(1, 2));
+    // Across the pole the two points are ~22 km apart
+    EXPECT_THAT(keysOf(index.nearest({89.9, 0}, 2)), testing::ElementsAre(4, 5));
+
+    auto wrapped = index.withinBounds(-1, 179, 1, -179);
+    std::sort(wrapped.begin(), wrapped.end());
+    EXPECT_THAT(wrapped, testing::ElementsAre(1, 2));
+}
+
+TEST(GeoGridIndexTest, NearestMatchesBruteForce) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> anyLat(-90, 90), anyLon(-180, 180);
+    std::normal_distribution<double> jitter(0, 0.05);
+
+    // A dense city cluster plus sparse points around the globe
+    std::vector<GeoPoint> points;
+    for (int i = 0; i < 3000; ++i) {
+        points.push_back({std::clamp(31.23 + jitter(rng), -90.0, 90.0), 121.47 + jitter(rng)});
+    }
+    for (int i = 0; i < 300; ++i) points.push_back({anyLat(rng), anyLon(rng)});
+
+    GeoGridIndex index;
+    for (std::size_t i = 0; i < points.size(); ++i) index.insert(static_cast<int>(i), points[i]);
+
+    for (int q = 0; q < 200; ++q) {
+        GeoPoint origin = q % 2 ? GeoPoint{31.23 + jitter(rng), 121.47 + jitter(rng)}
+                                : GeoPoint{anyLat(rng), anyLon(rng)};
+        for (std::size_t k : {1u, 5u, 50u}) {
+            ASSERT_EQ(keysOf(index.nearest(origin, k)), bruteForceNearest(points, origin, k))
+                << "origin " << origin.latitude << "," << origin.longitude << " k=" << k;
+        }
+    }
+}
@@ -0,0 +1,69 @@
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "logic/search/IdPositionIndex.h"
+
+using RecipeApp::Logic::Search::IdPositionIndex;
+
+TEST(IdPositionIndexTest, CompactIdsUseDenseTable) {
+    IdPositionIndex index;
+    index.build({1003, 1001, 1002, 1005});
+    EXPECT_TRUE(index.isDense());
+    EXPECT_EQ(index.find(1001), 1);
+    EXPECT_EQ(index.find(1005), 3);
+    EXPECT_EQ(index.find(1004), IdPositionIndex::npos);  // Gap
+    EXPECT_EQ(index.find(1000), IdPositionIndex::npos);  // Below range
+    EXPECT_EQ(index.find(999999), IdPositionIndex::npos);
+}
+
+TEST(IdPositionIndexTest, ScatteredIdsFallBackToHashMap) {
+    IdPositionIndex index;
+    index.build({5, 2000000, -7, 123456789});
+    EXPECT_FALSE(index.isDense());
+    EXPECT_EQ(index.find(-7), 2);
+    EXPECT_EQ(index.find(123456789), 3);
+    EXPECT_EQ(index.find(6), IdPositionIndex::npos);
+}
+
+TEST(IdPositionIndexTest, FirstDuplicateWinsAndClearEmpties) {
+    IdPositionIndex index;
+    index.build({10, 11, 10});
+    EXPECT_EQ(index.find(10), 0);
+    EXPECT_EQ(index.size(), 2);
+    index.clear();
+    EXPECT_EQ(index.find(10), IdPositionIndex::npos);
+    index.build({});
+    EXPECT_EQ(index.size(), 0);
+}
+
+TEST(IdPositionIndexTest, AttachedTablesAreQueriedInPlace) {
+    for (const std::vector<int>& ids :
+         {std::vector<int>{1003, 1001, 1002, 1005, 1001},
+          std::vector<int>{5, 2000000, -7, 123456789, 5}}) {
+        IdPositionIndex built;
+        built.build(ids);
+        std::string bytes;
+        RecipeApp::Common::ByteWriter writer(bytes);
+        built.serialize(writer);
+
+        IdPositionIndex attached;
+        ASSERT_TRUE(attached.attach(bytes, ids.size()));
+        EXPECT_EQ(attached.isDense(), built.isDense());
+        EXPECT_EQ(attached.size(), built.size());
+        for (int id : ids) {
+            EXPECT_EQ(attached.find(id), built.find(id)) << id;
+        }
+        for (int id : {1004, 6, 0, -8, 999999}) {
+            EXPECT_EQ(attached.find(id), IdPositionIndex::npos) << id;
+        }
+        // Positions beyond the record count are never returned
+        ASSERT_TRUE(attached.attach(bytes, 2));
+        EXPECT_EQ(attached.find(ids[3]), IdPositionIndex::npos);
+        EXPECT_EQ(attached.find(ids[0]), 0);
+
+        EXPECT_FALSE(attached.attach(std::string_view(bytes).substr(0, bytes.size() - 1),
+                                     ids.size()));
+        EXPECT_EQ(attached.find(ids[0]), IdPositionIndex::npos);
+    }
+}
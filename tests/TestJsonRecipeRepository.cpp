@@ -272,6 +272,33 @@ TEST_F(JsonRecipeRepositoryTest, RemoveRecipe) {
     ASSERT_EQ(repo.findAll().size(), 1);
 }
 
+TEST_F(JsonRecipeRepositoryTest, FindManyByIdsUsesIdIndexAfterChanges) {
+    JsonRecipeRepository repo(tempTestBaseDir, testFileName);
+    for (int i = 1; i <= 5; ++i) {
+        repo.save(createSimpleRecipe(0, "R" + std::to_string(i)));
+    }
+    ASSERT_TRUE(repo.remove(2));  // Shifts the items after it
+
+    // Requested order, unknown IDs skipped, repeats returned once
+    std::vector<Recipe> found = repo.findManyByIds({5, 2, 3, 99, 5, 1});
+    ASSERT_EQ(found.size(), 3);
+    EXPECT_EQ(found[0].getName(), "R5");
+    EXPECT_EQ(found[1].getName(), "R3");
+    EXPECT_EQ(found[2].getName(), "R1");
+    EXPECT_EQ(repo.findById(4)->getName(), "R4");
+
+    Recipe renamed = createSimpleRecipe(4, "R4 renamed");
+    ASSERT_EQ(repo.save(renamed), 4);
+    EXPECT_EQ(repo.findManyByIds({4})[0].getName(), "R4 renamed");
+    int added = repo.save(createSimpleRecipe(0, "R6"));
+    EXPECT_EQ(repo.findById(added)->getName(), "R6");
+
+    JsonRecipeRepository reloaded(tempTestBaseDir, testFileName);
+    ASSERT_TRUE(reloaded.load());
+    EXPECT_EQ(reloaded.findManyByIds({added, 1}).size(), 2);
+    EXPECT_FALSE(reloaded.findById(2).has_value());
+}
+
 TEST_F(JsonRecipeRepositoryTest, GetAndSetNextId) {
     JsonRecipeRepository repo(tempTestBaseDir, testFileName);
     EXPECT_EQ(repo.getNextId(), 1);
@@ -497,4 +524,106 @@ TEST_F(JsonRecipeRepositoryTest,
     EXPECT_EQ(repo.findAll().size(), 0);
     EXPECT_TRUE(
         std::filesystem::exists(tempFilePath));  // .tmp is untouched by load
-}
\ No newline at end of file
+}
+TEST_F(JsonRecipeRepositoryTest, NdjsonSkipsCorruptLinesAndAppendsNewRecipes) {
+    const std::string ndjsonName = "recipes_test.ndjson";
+    std::filesystem::path ndjsonPath = tempTestBaseDir / ndjsonName;
+    {
+        std::ofstream out(ndjsonPath);
+        out << json(createSimpleRecipe(1, "Line One")).dump() << "\n";
+        out << "{\"id\": 2, \"name\": \"Broken\", \n";  // Corrupt line
+        out << "\n";                                     // Blank line
+        out << json(createSimpleRecipe(3, "Line Three")).dump() << "\r\n";
+    }
+
+    JsonRecipeRepository repo(tempTestBaseDir, ndjsonName);
+    ASSERT_EQ(repo.findAll().size(), 2);
+    EXPECT_TRUE(repo.findById(1).has_value());
+    EXPECT_FALSE(repo.findById(2).has_value());
+    EXPECT_TRUE(repo.findById(3).has_value());
+    EXPECT_EQ(repo.getNextId(), 4);
+
+    // A new recipe is appended as one more line; existing lines stay as-is
+    int newId = repo.save(createSimpleRecipe(0, "Appended"));
+    EXPECT_EQ(newId, 4);
+    std::ifstream in(ndjsonPath);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(in, line);) {
+        lines.push_back(line);
+    }
+    ASSERT_EQ(lines.size(), 5);
+    EXPECT_EQ(lines[1], "{\"id\": 2, \"name\": \"Broken\", ");
+    EXPECT_EQ(json::parse(lines.back()).at("name"), "Appended");
+
+    // Removal rewrites the file in NDJSON form (dropping the corrupt line)
+    ASSERT_TRUE(repo.remove(1));
+    JsonRecipeRepository reloaded(tempTestBaseDir, ndjsonName);
+    auto all = reloaded.findAll();
+    ASSERT_EQ(all.size(), 2);
+    EXPECT_EQ(all[0].getName(), "Line Three");
+    EXPECT_EQ(all[1].getName(), "Appended");
+    std::ifstream rewritten(ndjsonPath);
+    std::string firstLine;
+    std::getline(rewritten, firstLine);
+    EXPECT_EQ(json::parse(firstLine).at("id"), 3);
+}
+
+TEST_F(JsonRecipeRepositoryTest, NdjsonAppendAfterMissingTrailingNewline) {
+    const std::string ndjsonName = "recipes_truncated.ndjson";
+    std::filesystem::path ndjsonPath = tempTestBaseDir / ndjsonName;
+    {
+        std::ofstream out(ndjsonPath);
+        out << json(createSimpleRecipe(1, "Line One")).dump() << "\n";
+        out << json(createSimpleRecipe(2, "No Newline")).dump();  // Last line unterminated
+    }
+
+    JsonRecipeRepository repo(tempTestBaseDir, ndjsonName);
+    ASSERT_EQ(repo.findAll().size(), 2);
+    EXPECT_EQ(repo.save(createSimpleRecipe(0, "Appended")), 3);
+
+    // Both the unterminated record and the appended one survive a reload
+    JsonRecipeRepository reloaded(tempTestBaseDir, ndjsonName);
+    auto all = reloaded.findAll();
+    ASSERT_EQ(all.size(), 3);
+    EXPECT_EQ(all[1].getName(), "No Newline");
+    EXPECT_EQ(all[2].getName(), "Appended");
+}
+
+TEST_F(JsonRecipeRepositoryTest, SaveManyAssignsIdBlockAndWritesOnce) {
+    JsonRecipeRepository repo(tempTestBaseDir, testFileName);
+    ASSERT_EQ(repo.save(createSimpleRecipe(0, "Existing")), 1);
+
+    std::vector<Recipe> batch;
+    for (int i = 0; i < 50; ++i) {
+        batch.push_back(createSimpleRecipe(900 + i, "Batch " + std::to_string(i)));
+    }
+    std::vector<Recipe> saved = repo.saveMany(batch);
+    ASSERT_EQ(saved.size(), batch.size());
+    for (std::size_t i = 0; i < saved.size(); ++i) {
+        EXPECT_EQ(saved[i].getRecipeId(), static_cast<int>(i) + 2);
+        EXPECT_EQ(saved[i].getName(), batch[i].getName());
+    }
+    EXPECT_EQ(repo.getNextId(), 52);
+
+    JsonRecipeRepository reloaded(tempTestBaseDir, testFileName);
+    ASSERT_TRUE(reloaded.load());
+    EXPECT_EQ(reloaded.findAll().size(), 51);
+    EXPECT_EQ(reloaded.findById(51)->getName(), "Batch 49");
+}
+
+TEST_F(JsonRecipeRepositoryTest, SaveManyAppendsToNdjson) {
+    const std::string ndjsonName = "recipes_bulk.ndjson";
+    JsonRecipeRepository repo(tempTestBaseDir, ndjsonName);
+    std::vector<Recipe> saved = repo.saveMany(
+        {createSimpleRecipe(0, "First"), createSimpleRecipe(0, "Second")});
+    ASSERT_EQ(saved.size(), 2);
+
+    std::ifstream in(tempTestBaseDir / ndjsonName);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(in, line);) {
+        lines.push_back(line);
+    }
+    ASSERT_EQ(lines.size(), 2);
+    EXPECT_EQ(json::parse(lines[1]).at("id"), 2);
+    EXPECT_TRUE(repo.saveMany({}).empty());
+}
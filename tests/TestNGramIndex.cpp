@@ -0,0 +1,197 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "logic/search/NGramIndex.h"
+
+using RecipeApp::Logic::Search::NGramIndex;
+
+namespace {
+std::string lower(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    return s;
+}
+
+// Serializes an index with its fields interned into a separate pool
+struct SerializedIndex {
+    std::string bytes;
+    std::string pool;
+
+    explicit SerializedIndex(const NGramIndex& index) {
+        RecipeApp::Common::ByteWriter writer(bytes);
+        index.serialize(writer, [this](RecipeApp::Common::ByteWriter& out,
+                                       std::string_view field) {
+            out.writeU32(static_cast<std::uint32_t>(pool.size()));
+            out.writeU32(static_cast<std::uint32_t>(field.size()));
+            pool += field;
+        });
+    }
+};
+}  // namespace
+
+TEST(NGramIndexTest, SubstringMatchesAcrossScripts) {
+    NGramIndex index;
+    index.addDocument(0, {"宫保鸡丁", "鸡胸肉", "花生米", "川菜"});
+    index.addDocument(1, {"Apple Pie", "Apple", "dessert"});
+    index.addDocument(2, {"麻婆豆腐", "豆腐", "川菜"});
+
+    EXPECT_THAT(index.search("川菜"), testing::ElementsAre(0, 2));
+    EXPECT_THAT(index.search("鸡"), testing::ElementsAre(0));
+    EXPECT_THAT(index.search("PIE"), testing::ElementsAre(1));
+    EXPECT_THAT(index.search("pple pi"), testing::ElementsAre(1));
+    EXPECT_THAT(index.search(""), testing::ElementsAre(0, 1, 2));
+    EXPECT_THAT(index.search("烤鸭"), testing::IsEmpty());
+}
+
+TEST(NGramIndexTest, BigramsMustBeContiguousInOneField) {
+    NGramIndex index;
+    // Has the bigrams "ab" and "bc", but never "abc" in one field
+    index.addDocument(7, {"ab", "bc"});
+    index.addDocument(8, {"xabcx"});
+    EXPECT_THAT(index.search("abc"), testing::ElementsAre(8));
+    EXPECT_THAT(index.search("ab"), testing::ElementsAre(7, 8));
+}
+
+TEST(NGramIndexTest, SearchWithMatchesReportsByteOffsets) {
+    NGramIndex index;
+    index.addDocument(0, {"宫保鸡丁", "鸡胸肉", "川菜"});
+    index.addDocument(1, {"Banana Bread", "banana"});
+
+    auto hits = index.searchWithMatches("鸡");
+    ASSERT_EQ(hits.size(), 1);
+    EXPECT_EQ(hits[0].docKey, 0);
+    ASSERT_EQ(hits[0].matches.size(), 2);
+    EXPECT_EQ(hits[0].matches[0].fieldIndex, 0);
+    EXPECT_EQ(hits[0].matches[0].offset, 6);  // After two 3-byte code points
+    EXPECT_EQ(hits[0].matches[1].fieldIndex, 1);
+    EXPECT_EQ(hits[0].matches[1].offset, 0);
+
+    // Non-overlapping occurrences, case-insensitive
+    hits = index.searchWithMatches("ANA");
+    ASSERT_EQ(hits.size(), 1);
+    ASSERT_EQ(hits[0].matches.size(), 2);
+    EXPECT_EQ(hits[0].matches[0].offset, 1);
+    EXPECT_EQ(hits[0].matches[1].fieldIndex, 1);
+
+    EXPECT_TRUE(index.searchWithMatches("烤鸭").empty());
+    hits = index.searchWithMatches("");
+    ASSERT_EQ(hits.size(), 2);
+    EXPECT_TRUE(hits[0].matches.empty());
+
+    // Same documents as search()
+    for (const std::string query : {"川", "宫保", "bread", "a", "nab"}) {
+        std::vector<int> keys;
+        for (const auto& hit : index.searchWithMatches(query)) {
+            keys.push_back(hit.docKey);
+        }
+        EXPECT_EQ(keys, index.search(query)) << query;
+    }
+}
+
+TEST(NGramIndexTest, RemoveAndReplaceDocuments) {
+    NGramIndex index;
+    index.addDocument(1, {"Tomato Soup"});
+    index.addDocument(2, {"Tomato Salad"});
+    index.removeDocument(1);
+    EXPECT_THAT(index.search("tomato"), testing::ElementsAre(2));
+    index.addDocument(2, {"Green Salad"});
+    EXPECT_THAT(index.search("tomato"), testing::IsEmpty());
+    EXPECT_THAT(index.search("salad"), testing::ElementsAre(2));
+    EXPECT_EQ(index.size(), 1);
+}
+
+TEST(NGramIndexTest, MatchesNaiveScan) {
+    const std::vector<std::string> alphabet = {"a", "B", "c", "鸡", "肉", "汤", " "};
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<size_t> pick(0, alphabet.size() - 1);
+    auto randomText = [&](size_t length) {
+        std::string text;
+        for (size_t i = 0; i < length; ++i) text += alphabet[pick(rng)];
+        return text;
+    };
+
+    NGramIndex index;
+    std::vector<std::vector<std::string>> docs;
+    for (int d = 0; d < 200; ++d) {
+        docs.push_back({randomText(6), randomText(4), randomText(3)});
+        index.addDocument(d, docs.back());
+    }
+    for (int q = 0; q < 300; ++q) {
+        std::string query = randomText(1 + q % 4);
+        std::vector<int> expected;
+        for (int d = 0; d < static_cast<int>(docs.size()); ++d) {
+            for (const auto& field : docs[d]) {
+                if (lower(field).find(lower(query)) != std::string::npos) {
+                    expected.push_back(d);
+                    break;
+                }
+            }
+        }
+        EXPECT_EQ(index.search(query), expected) << "query: " << query;
+    }
+}
+
+TEST(NGramIndexTest, AttachedIndexAnswersInPlace) {
+    NGramIndex built;
+    built.addDocument(3, {"宫保鸡丁", "鸡胸肉", "川菜"});
+    built.addDocument(5, {"Apple Pie", "Apple"});
+    built.addDocument(9, {"Chicken Soup", "Chicken"});
+    SerializedIndex serialized(built);
+
+    NGramIndex attached;
+    ASSERT_TRUE(attached.attach(serialized.bytes, serialized.pool));
+    EXPECT_EQ(attached.size(), 3);
+    for (const std::string query : {"", "鸡", "宫保", "川菜", "PIE", "chick", "soup", "xyz"}) {
+        EXPECT_EQ(attached.search(query), built.search(query)) << query;
+        auto hits = attached.searchWithMatches(query);
+        auto expected = built.searchWithMatches(query);
+        ASSERT_EQ(hits.size(), expected.size()) << query;
+        for (size_t i = 0; i < hits.size(); ++i) {
+            EXPECT_EQ(hits[i].docKey, expected[i].docKey);
+            EXPECT_EQ(hits[i].matches.size(), expected[i].matches.size());
+        }
+    }
+
+    // Changes are layered over the attached documents
+    attached.removeDocument(5);
+    attached.addDocument(9, {"Beef Stew"});
+    attached.addDocument(1, {"Chicken Pie"});
+    EXPECT_THAT(attached.search("pie"), testing::ElementsAre(1));
+    EXPECT_THAT(attached.search("chicken"), testing::ElementsAre(1));
+    EXPECT_THAT(attached.search("stew"), testing::ElementsAre(9));
+    EXPECT_THAT(attached.search(""), testing::ElementsAre(1, 3, 9));
+    EXPECT_EQ(attached.size(), 3);
+
+    // Serializing the layered index matches serializing the same documents
+    NGramIndex equivalent;
+    equivalent.addDocument(1, {"Chicken Pie"});
+    equivalent.addDocument(3, {"宫保鸡丁", "鸡胸肉", "川菜"});
+    equivalent.addDocument(9, {"Beef Stew"});
+    SerializedIndex layered(attached);
+    SerializedIndex direct(equivalent);
+    EXPECT_EQ(layered.bytes, direct.bytes);
+    EXPECT_EQ(layered.pool, direct.pool);
+}
+
+TEST(NGramIndexTest, AttachRejectsTruncatedData) {
+    NGramIndex built;
+    built.addDocument(1, {"Tomato Soup"});
+    SerializedIndex serialized(built);
+
+    NGramIndex attached;
+    EXPECT_FALSE(attached.attach(
+        std::string_view(serialized.bytes).substr(0, serialized.bytes.size() - 1),
+        serialized.pool));
+    EXPECT_EQ(attached.size(), 0);
+    EXPECT_TRUE(attached.search("soup").empty());
+    // Field references outside the pool read as empty fields
+    ASSERT_TRUE(attached.attach(serialized.bytes, ""));
+    EXPECT_TRUE(attached.search("soup").empty());
+}
@@ -117,6 +117,7 @@ TEST_F(RecipeEncyclopediaCommandHandlerTest, SearchRecipesWithKeywordsSuccess) {
     // Actual output: "找到 1 个与关键词匹配的食谱 'Pie':\n  ID: 201, 名称: Handler Test Pie\n"
     EXPECT_THAT(output, testing::HasSubstr("找到 1 个与关键词匹配的食谱 'Pie'"));
     EXPECT_THAT(output, testing::HasSubstr("ID: 201, 名称: Handler Test Pie"));
+    EXPECT_THAT(output, testing::HasSubstr("匹配: 名称 Handler Test 【Pie】"));
 }
 
 TEST_F(RecipeEncyclopediaCommandHandlerTest, SearchRecipesWithKeywordsNoMatch) {
@@ -121,6 +121,26 @@ TEST_F(RecipeEncyclopediaManagerTest, SearchRecipesByTag) {
     EXPECT_EQ(results[0].getName(), "Grilled Chicken");
 }
 
+TEST_F(RecipeEncyclopediaManagerTest, SearchRecipesWithMatchesReportsFields) {
+    using RecipeApp::Logic::Search::MatchField;
+    auto hits = manager.searchRecipesWithMatches("chick");
+    ASSERT_EQ(hits.size(), 1);
+    EXPECT_EQ(hits[0].recipe.getName(), "Grilled Chicken");
+    ASSERT_EQ(hits[0].matches.size(), 2);
+    EXPECT_EQ(hits[0].matches[0].field, MatchField::Name);
+    EXPECT_EQ(hits[0].matches[0].offset, 8);
+    EXPECT_EQ(hits[0].matches[0].length, 5);
+    EXPECT_EQ(hits[0].matches[1].field, MatchField::Ingredient);
+    EXPECT_EQ(hits[0].matches[1].fieldIndex, 0);
+    EXPECT_EQ(hits[0].matches[1].offset, 0);
+
+    hits = manager.searchRecipesWithMatches("VEGETARIAN");
+    ASSERT_EQ(hits.size(), 1);
+    ASSERT_EQ(hits[0].matches.size(), 1);
+    EXPECT_EQ(hits[0].matches[0].field, MatchField::Tag);
+    EXPECT_EQ(hits[0].matches[0].fieldIndex, 1);
+}
+
 TEST_F(RecipeEncyclopediaManagerTest, SearchRecipesNoMatch) {
     std::vector<RecipeApp::Recipe> results = manager.searchRecipes("NonExistentRecipe");
     ASSERT_TRUE(results.empty());
@@ -159,4 +179,352 @@ TEST_F(RecipeEncyclopediaManagerTest, GetAllRecipes) {
         }
     }
     EXPECT_TRUE(found);
-}
\ No newline at end of file
+}
+TEST_F(RecipeEncyclopediaManagerTest, LazyLoadDecodesOnDemand) {
+    RecipeApp::Logic::Encyclopedia::RecipeEncyclopediaManager lazyManager;
+    ASSERT_TRUE(lazyManager.loadRecipesLazy(testRecipesJsonPath, 1));
+    EXPECT_TRUE(lazyManager.isLazy());
+    EXPECT_EQ(lazyManager.size(), 3);
+
+    auto recipe = lazyManager.getRecipeById(102);
+    ASSERT_TRUE(recipe.has_value());
+    EXPECT_EQ(recipe->getName(), "Tomato Soup");
+    ASSERT_EQ(recipe->getSteps().size(), 2);  // Full record, not just indexed fields
+    EXPECT_EQ(recipe->getSteps()[1], "Blend soup");
+    EXPECT_EQ(recipe->getCookingTime(), 30);
+
+    // Evicts 102 from the single-entry cache, then decodes it again
+    ASSERT_TRUE(lazyManager.getRecipeById(103).has_value());
+    ASSERT_TRUE(lazyManager.getRecipeById(102).has_value());
+    EXPECT_FALSE(lazyManager.getRecipeById(999).has_value());
+}
+
+TEST_F(RecipeEncyclopediaManagerTest, LazyLoadMatchesEagerResults) {
+    RecipeApp::Logic::Encyclopedia::RecipeEncyclopediaManager lazyManager;
+    ASSERT_TRUE(lazyManager.loadRecipesLazy(testRecipesJsonPath));
+
+    for (const std::string term : {"pie", "Tomato", "grill", "chicken breast", "", "nothing"}) {
+        auto eager = manager.searchRecipes(term);
+        auto lazy = lazyManager.searchRecipes(term);
+        ASSERT_EQ(eager.size(), lazy.size()) << term;
+        for (size_t i = 0; i < eager.size(); ++i) {
+            EXPECT_EQ(eager[i].getRecipeId(), lazy[i].getRecipeId()) << term;
+        }
+    }
+
+    const auto& all = lazyManager.getAllRecipes();
+    ASSERT_EQ(all.size(), 3);
+    EXPECT_EQ(all[2].getName(), "Grilled Chicken");
+    EXPECT_EQ(all[0].getTags().size(), 2);
+}
+
+TEST_F(RecipeEncyclopediaManagerTest, PositionsStreamRecipesInBatches) {
+    RecipeApp::Logic::Encyclopedia::RecipeEncyclopediaManager lazyManager;
+    ASSERT_TRUE(lazyManager.loadRecipesLazy(testRecipesJsonPath, 1));
+
+    for (const auto* source : {&manager, &lazyManager}) {
+        EXPECT_EQ(source->findRecipePositions(""), (std::vector<size_t>{0, 1, 2}));
+        EXPECT_EQ(source->findRecipePositions("st"), (std::vector<size_t>{0, 2}));  // Crust, Breast
+        EXPECT_TRUE(source->findRecipePositions("nothing").empty());
+
+        auto batch = source->getRecipesAtPositions({2, 0, 7});  // 7 is out of range
+        ASSERT_EQ(batch.size(), 2);
+        EXPECT_EQ(batch[0].getName(), "Grilled Chicken");
+        EXPECT_EQ(batch[1].getSteps()[1], "Bake pie");
+    }
+}
+
+TEST_F(RecipeEncyclopediaManagerTest, LazyLoadRejectsNonArrayAndMissingFile) {
+    RecipeApp::Logic::Encyclopedia::RecipeEncyclopediaManager lazyManager;
+    EXPECT_FALSE(lazyManager.loadRecipesLazy("non_existent_file.json"));
+
+    std::string badPath = "lazy_not_array.json";
+    std::ofstream outfile(badPath);
+    outfile << R"({ "id": 1, "name": "Not an array" })";
+    outfile.close();
+    EXPECT_FALSE(lazyManager.loadRecipesLazy(badPath));
+    EXPECT_FALSE(lazyManager.isLazy());
+    std::remove(badPath.c_str());
+
+    // Strings containing brackets and escaped quotes must not confuse the scanner
+    std::string trickyPath = "lazy_tricky.json";
+    std::ofstream tricky(trickyPath);
+    tricky << "\xEF\xBB\xBF" << R"([ {"id": 7, "name": "A ] \" [ {name}", "cookingTime": 5,
+        "difficulty": "Easy", "ingredients": [], "steps": ["x"], "tags": ["t,]"]},
+        {"id": 8, "name": "Plain", "cookingTime": 5, "difficulty": "Easy",
+         "ingredients": [{"name": "Salt", "quantity": "1g"}], "steps": [], "tags": []} ])";
+    tricky.close();
+    ASSERT_TRUE(lazyManager.loadRecipesLazy(trickyPath));
+    EXPECT_EQ(lazyManager.size(), 2);
+    auto recipe = lazyManager.getRecipeById(7);
+    ASSERT_TRUE(recipe.has_value());
+    EXPECT_EQ(recipe->getName(), "A ] \" [ {name}");
+    ASSERT_EQ(lazyManager.searchRecipes("salt").size(), 1);
+    std::remove(trickyPath.c_str());
+}
+
+TEST_F(RecipeEncyclopediaManagerTest, BundleRoundTripMatchesJson) {
+    using RecipeApp::Logic::Encyclopedia::RecipeEncyclopediaManager;
+    const std::string bundlePath = "test_encyclopedia.bundle";
+    ASSERT_TRUE(RecipeEncyclopediaManager::compileBundle(testRecipesJsonPath, bundlePath));
+
+    RecipeEncyclopediaManager bundled;
+    ASSERT_TRUE(bundled.loadBundle(bundlePath, testRecipesJsonPath, 2));
+    EXPECT_EQ(bundled.getLoadMode(), RecipeEncyclopediaManager::LoadMode::Bundle);
+    EXPECT_EQ(bundled.size(), 3);
+
+    for (const std::string term : {"pie", "Tomato", "grill", "chicken breast", "", "nothing"}) {
+        auto eager = manager.searchRecipes(term);
+        auto fromBundle = bundled.searchRecipes(term);
+        ASSERT_EQ(eager.size(), fromBundle.size()) << term;
+        for (size_t i = 0; i < eager.size(); ++i) {
+            EXPECT_EQ(eager[i].getRecipeId(), fromBundle[i].getRecipeId()) << term;
+        }
+    }
+
+    auto original = manager.getRecipeById(101);
+    auto decoded = bundled.getRecipeById(101);
+    ASSERT_TRUE(original.has_value());
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded->getName(), original->getName());
+    EXPECT_EQ(decoded->getCookingTime(), original->getCookingTime());
+    EXPECT_EQ(decoded->getDifficulty(), original->getDifficulty());
+    EXPECT_EQ(decoded->getSteps(), original->getSteps());
+    EXPECT_EQ(decoded->getTags(), original->getTags());
+    ASSERT_EQ(decoded->getIngredients().size(), original->getIngredients().size());
+    EXPECT_EQ(decoded->getIngredients()[1].quantity, "1");
+    EXPECT_EQ(decoded->getNutritionalInfo(), original->getNutritionalInfo());
+    EXPECT_FALSE(bundled.getRecipeById(999).has_value());
+
+    std::remove(bundlePath.c_str());
+}
+
+TEST_F(RecipeEncyclopediaManagerTest, StaleOrMissingBundleFallsBackToJson) {
+    using RecipeApp::Logic::Encyclopedia::RecipeEncyclopediaManager;
+    const std::string bundlePath = "test_encyclopedia_stale.bundle";
+    ASSERT_TRUE(RecipeEncyclopediaManager::compileBundle(testRecipesJsonPath, bundlePath));
+
+    // Edit the source after compiling: the bundle no longer matches it
+    std::ofstream outfile(testRecipesJsonPath, std::ios::app);
+    outfile << "\n";
+    outfile.close();
+
+    RecipeEncyclopediaManager fallback;
+    EXPECT_FALSE(fallback.loadBundle(bundlePath, testRecipesJsonPath));
+    ASSERT_TRUE(fallback.loadPreferringBundle(bundlePath, testRecipesJsonPath));
+    EXPECT_EQ(fallback.getLoadMode(), RecipeEncyclopediaManager::LoadMode::Eager);
+    EXPECT_EQ(fallback.size(), 3);
+
+    ASSERT_TRUE(fallback.loadPreferringBundle("missing.bundle", testRecipesJsonPath));
+    EXPECT_EQ(fallback.getLoadMode(), RecipeEncyclopediaManager::LoadMode::Eager);
+
+    // JSON files at or above the size threshold are loaded lazily
+    ASSERT_TRUE(fallback.loadPreferringBundle(bundlePath, testRecipesJsonPath, 1));
+    EXPECT_EQ(fallback.getLoadMode(), RecipeEncyclopediaManager::LoadMode::LazyJson);
+    EXPECT_EQ(fallback.size(), 3);
+    ASSERT_TRUE(fallback.loadPreferringBundle("", testRecipesJsonPath));
+    EXPECT_EQ(fallback.getLoadMode(), RecipeEncyclopediaManager::LoadMode::Eager);
+    EXPECT_FALSE(fallback.loadPreferringBundle("", "missing.json"));
+
+    // A truncated bundle is rejected rather than half-loaded
+    {
+        std::ofstream truncated(bundlePath, std::ios::binary | std::ios::trunc);
+        truncated << "RECIPENC";
+    }
+    EXPECT_FALSE(fallback.loadBundle(bundlePath));
+    std::remove(bundlePath.c_str());
+}
+
+TEST_F(RecipeEncyclopediaManagerTest, NdjsonLoadSkipsCorruptLines) {
+    using RecipeApp::Logic::Encyclopedia::RecipeEncyclopediaManager;
+    const std::string ndjsonPath = "test_encyclopedia.ndjson";
+    ASSERT_TRUE(manager.saveRecipesNdjson(ndjsonPath));
+    {
+        std::ofstream out(ndjsonPath, std::ios::app);
+        out << "{\"id\": 104, \"name\": \"Half a recipe\",\n";
+        out << "\n";
+    }
+
+    RecipeEncyclopediaManager fromNdjson;
+    ASSERT_TRUE(fromNdjson.loadRecipes(ndjsonPath));
+    ASSERT_EQ(fromNdjson.size(), 3);
+    EXPECT_EQ(fromNdjson.getAllRecipes()[1].getName(), "Tomato Soup");
+    EXPECT_EQ(fromNdjson.searchRecipes("grill").size(), 1);
+
+    RecipeEncyclopediaManager lazy;
+    ASSERT_TRUE(lazy.loadRecipesLazy(ndjsonPath));
+    EXPECT_EQ(lazy.size(), 3);  // The corrupt line is rejected while indexing
+    auto recipe = lazy.getRecipeById(103);
+    ASSERT_TRUE(recipe.has_value());
+    EXPECT_EQ(recipe->getSteps().size(), 2);
+    std::remove(ndjsonPath.c_str());
+}
+
+TEST_F(RecipeEncyclopediaManagerTest, ParallelLoadPreservesFileOrder) {
+    using RecipeApp::Logic::Encyclopedia::RecipeEncyclopediaManager;
+    const std::string bigPath = "test_encyclopedia_parallel.json";
+    const std::string ndjsonPath = "test_encyclopedia_parallel.ndjson";
+    {
+        std::ofstream array(bigPath);
+        std::ofstream lines(ndjsonPath);
+        array << "[";
+        for (int i = 0; i < 257; ++i) {
+            nlohmann::json item = createDummyRecipe(5000 - i, "Recipe " + std::to_string(i), {"t" + std::to_string(i % 5)});
+            array << (i ? "," : "") << item.dump();
+            lines << item.dump() << "\n";
+        }
+        array << "]";
+    }
+
+    RecipeEncyclopediaManager sequential;
+    ASSERT_TRUE(sequential.loadRecipes(bigPath));
+    ASSERT_EQ(sequential.size(), 257);
+    for (unsigned threads : {1u, 3u, 8u, 1000u}) {
+        for (const std::string& path : {bigPath, ndjsonPath}) {
+            RecipeEncyclopediaManager parallel;
+            ASSERT_TRUE(parallel.loadRecipesParallel(path, threads));
+            const auto& expected = sequential.getAllRecipes();
+            const auto& actual = parallel.getAllRecipes();
+            ASSERT_EQ(actual.size(), expected.size()) << path << " threads=" << threads;
+            for (size_t i = 0; i < expected.size(); ++i) {
+                ASSERT_EQ(actual[i].getRecipeId(), expected[i].getRecipeId());
+            }
+            EXPECT_EQ(parallel.searchRecipes("recipe 25").size(), 8u);  // 25, 250-256
+            EXPECT_TRUE(parallel.getRecipeById(5000 - 200).has_value());
+        }
+    }
+
+    // A syntax error inside an array element invalidates the whole document
+    {
+        std::ofstream broken(bigPath);
+        broken << R"([{"id": 1, "name": "ok", "cookingTime": 1, "difficulty": "Easy"}, {"id": 2, "name": tru}])";
+    }
+    RecipeEncyclopediaManager parallel;
+    EXPECT_FALSE(parallel.loadRecipesParallel(bigPath, 2));
+    std::remove(bigPath.c_str());
+    std::remove(ndjsonPath.c_str());
+}
+
+TEST_F(RecipeEncyclopediaManagerTest, ApplyPatchAddsReplacesAndRemoves) {
+    using RecipeApp::Logic::Encyclopedia::RecipeEncyclopediaManager;
+    const std::string patchPath = "test_encyclopedia_patch.ndjson";
+    {
+        std::ofstream patch(patchPath);
+        patch << nlohmann::json{{"op", "add"}, {"recipe", createDummyRecipe(104, "Lemon Tart", {"dessert"})}}.dump() << "\n";
+        patch << nlohmann::json{{"op", "replace"}, {"recipe", createDummyRecipe(102, "Pumpkin Soup", {"soup"})}}.dump() << "\n";
+        patch << R"({"op": "remove", "id": 101})" << "\n";
+        patch << R"({"op": "remove", "id": 999})" << "\n";
+        patch << nlohmann::json{{"op", "add"}, {"recipe", createDummyRecipe(103, "Duplicate")}}.dump() << "\n";
+        patch << R"({"op": "rename", "id": 103})" << "\n";
+    }
+
+    RecipeEncyclopediaManager::PatchSummary summary;
+    ASSERT_TRUE(manager.applyPatch(patchPath, &summary));
+    EXPECT_EQ(summary.added, 1);
+    EXPECT_EQ(summary.replaced, 1);
+    EXPECT_EQ(summary.removed, 1);
+    EXPECT_EQ(summary.skipped, 3);
+
+    // Survivors keep their order, additions go last
+    const auto& all = manager.getAllRecipes();
+    ASSERT_EQ(all.size(), 3);
+    EXPECT_EQ(all[0].getRecipeId(), 102);
+    EXPECT_EQ(all[1].getRecipeId(), 103);
+    EXPECT_EQ(all[2].getRecipeId(), 104);
+
+    EXPECT_FALSE(manager.getRecipeById(101).has_value());
+    ASSERT_TRUE(manager.getRecipeById(104).has_value());
+    EXPECT_EQ(manager.getRecipeById(102)->getName(), "Pumpkin Soup");
+
+    EXPECT_TRUE(manager.searchRecipes("Apple").empty());
+    EXPECT_TRUE(manager.searchRecipes("Tomato").empty());
+    ASSERT_EQ(manager.searchRecipes("pumpkin").size(), 1);
+    auto desserts = manager.searchRecipes("dessert");
+    ASSERT_EQ(desserts.size(), 1);
+    EXPECT_EQ(desserts[0].getName(), "Lemon Tart");
+    std::remove(patchPath.c_str());
+}
+
+TEST_F(RecipeEncyclopediaManagerTest, ApplyPatchRejectsMalformedFileUnchanged) {
+    const std::string patchPath = "test_encyclopedia_patch.json";
+    {
+        std::ofstream patch(patchPath);
+        patch << R"([{"op": "remove", "id": 101}, {"op": "remove", "id": )";
+    }
+    EXPECT_FALSE(manager.applyPatch(patchPath));
+    EXPECT_EQ(manager.size(), 3);
+    EXPECT_EQ(manager.searchRecipes("Apple").size(), 1);
+
+    {
+        std::ofstream patch(patchPath, std::ios::trunc);
+        patch << R"({"op": "remove", "id": 101})";
+    }
+    EXPECT_FALSE(manager.applyPatch(patchPath));  // Not an array
+    EXPECT_FALSE(manager.applyPatch("missing_patch.json"));
+    EXPECT_TRUE(manager.getRecipeById(101).has_value());
+    std::remove(patchPath.c_str());
+}
+
+TEST_F(RecipeEncyclopediaManagerTest, ApplyPatchKeepsLazyModesMapped) {
+    using RecipeApp::Logic::Encyclopedia::RecipeEncyclopediaManager;
+    const std::string bundlePath = "test_encyclopedia_patch.bundle";
+    const std::string firstPatch = "test_encyclopedia_overlay_1.json";
+    const std::string secondPatch = "test_encyclopedia_overlay_2.json";
+    ASSERT_TRUE(RecipeEncyclopediaManager::compileBundle(testRecipesJsonPath, bundlePath));
+    std::ofstream(firstPatch) << nlohmann::json::array({
+        {{"op", "remove"}, {"id", 102}},
+        {{"op", "add"}, {"recipe", createDummyRecipe(104, "Lemon Tart", {"dessert"})}},
+        {{"op", "replace"}, {"recipe", createDummyRecipe(103, "Smoked Chicken", {"grill"})}},
+        {{"op", "add"}, {"recipe", createDummyRecipe(105, "Fig Tart", {"dessert"})}},
+    }).dump();
+    // Removes an added recipe and re-adds a removed mapped one
+    std::ofstream(secondPatch) << nlohmann::json::array({
+        {{"op", "remove"}, {"id", 104}},
+        {{"op", "add"}, {"recipe", createDummyRecipe(102, "Tomato Soup v2", {"soup"})}},
+        {{"op", "replace"}, {"recipe", createDummyRecipe(105, "Fig Tartlet", {"dessert"})}},
+    }).dump();
+
+    auto describe = [](const RecipeEncyclopediaManager& m) {
+        std::vector<std::string> names;
+        for (size_t position : m.findRecipePositions("")) {
+            for (const auto& recipe : m.getRecipesAtPositions({position})) names.push_back(recipe.getName());
+        }
+        for (const char* term : {"tart", "soup", "chicken", "apple"}) {
+            names.push_back(std::string("|") + term);
+            for (const auto& recipe : m.searchRecipes(term)) names.push_back(recipe.getName());
+        }
+        return names;
+    };
+    ASSERT_TRUE(manager.applyPatch(firstPatch));
+    ASSERT_TRUE(manager.applyPatch(secondPatch));
+    const auto expected = describe(manager);
+    ASSERT_EQ(manager.size(), 4);
+
+    RecipeEncyclopediaManager lazy, bundled;
+    ASSERT_TRUE(lazy.loadRecipesLazy(testRecipesJsonPath));
+    ASSERT_TRUE(bundled.loadBundle(bundlePath, testRecipesJsonPath));
+    for (RecipeEncyclopediaManager* m : {&lazy, &bundled}) {
+        RecipeEncyclopediaManager::LoadMode mode = m->getLoadMode();
+        RecipeEncyclopediaManager::PatchSummary summary;
+        ASSERT_TRUE(m->applyPatch(firstPatch, &summary));
+        EXPECT_EQ(summary.added, 2);
+        EXPECT_EQ(summary.removed, 1);
+        EXPECT_EQ(summary.replaced, 1);
+        EXPECT_EQ(m->getRecipeById(103)->getName(), "Smoked Chicken");
+        EXPECT_FALSE(m->getRecipeById(102).has_value());
+        ASSERT_TRUE(m->applyPatch(secondPatch, &summary));
+        EXPECT_EQ(summary.skipped, 0);
+
+        EXPECT_EQ(m->getLoadMode(), mode);  // Nothing was decoded into memory
+        EXPECT_EQ(m->size(), 4);
+        EXPECT_EQ(describe(*m), expected);
+        EXPECT_FALSE(m->getRecipeById(104).has_value());
+        EXPECT_EQ(m->getRecipeById(102)->getName(), "Tomato Soup v2");
+        EXPECT_EQ(m->getRecipeById(101)->getName(), "Apple Pie");
+        ASSERT_EQ(m->getAllRecipes().size(), 4);
+        EXPECT_EQ(m->getAllRecipes().back().getName(), "Tomato Soup v2");
+    }
+    std::remove(bundlePath.c_str());
+    std::remove(firstPatch.c_str());
+    std::remove(secondPatch.c_str());
+}
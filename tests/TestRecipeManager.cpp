@@ -1,5 +1,6 @@
 #include <algorithm>  // For std::sort, std::equal
 #include <filesystem>
+#include <fstream>
 #include <optional>
 #include <string>
 #include <vector>
@@ -7,8 +8,10 @@
 #include "domain/recipe/Recipe.h"
 #include "gtest/gtest.h"
 #include "logic/recipe/RecipeManager.h"
+#include "logic/recipe/IngredientSynonymDictionary.h"
 #include "persistence/JsonRecipeRepository.h"  // For concrete repository in tests
 #include "common/exceptions/ValidationException.h" // For testing exception throws
+#include "common/exceptions/PersistenceException.h"
 #include "gmock/gmock.h" // For GMock framework
 #include "domain/recipe/RecipeRepository.h" // Base class for mock
 
@@ -25,6 +28,7 @@ public:
     MOCK_CONST_METHOD2(findByIngredients, std::vector<RecipeApp::Recipe>(const std::vector<std::string>& ingredientNames, bool matchAll));
     MOCK_CONST_METHOD2(findByTags, std::vector<RecipeApp::Recipe>(const std::vector<std::string>& tagNames, bool matchAll));
     MOCK_METHOD1(setNextId, void(int nextId));
+    MOCK_METHOD1(saveMany, std::vector<RecipeApp::Recipe>(const std::vector<RecipeApp::Recipe>& recipes));
 };
 
 // Helper to create a recipe with specific tags
@@ -645,4 +649,280 @@ TEST_F(RecipeManagerTest, FindRecipesByIngredients_MultipleIngredients_MatchAny)
 
     std::vector<RecipeApp::Recipe> foundRecipes = manager->findRecipesByIngredients(searchIngredients, false); // matchAll = false
     ASSERT_EQ(foundRecipes.size(), 2);
-}
\ No newline at end of file
+}
+// --- Ingredient Category (Exclusion Filter) Tests ---
+
+class RecipeManagerCategoryTest : public RecipeManagerTest {
+   protected:
+    std::filesystem::path categoriesFile;
+    std::vector<RecipeApp::Recipe> recipes;
+
+    void SetUp() override {
+        RecipeManagerTest::SetUp();
+        categoriesFile = std::filesystem::temp_directory_path() /
+                         "recipe_manager_test_categories.json";
+        std::ofstream out(categoriesFile);
+        out << R"({"categories": [
+            {"name": "peanut", "aliases": ["花生"], "keywords": ["花生", "peanut"]},
+            {"name": "shellfish", "keywords": ["虾", "shrimp", "crab"]},
+            {"name": "pork", "keywords": ["猪", "pork", "bacon"]}
+        ]})";
+        out.close();
+
+        recipes = {
+            RecipeApp::Recipe::builder(1, "宫保鸡丁").withIngredients({{"鸡胸肉", "300g"}, {"花生米", "50g"}}).withSteps({"炒"}).build(),
+            RecipeApp::Recipe::builder(2, "Shrimp Fried Rice").withIngredients({{"Rice", "1 bowl"}, {"Shrimp", "100g"}, {"Bacon", "2 slices"}}).withSteps({"Fry"}).build(),
+            RecipeApp::Recipe::builder(3, "Garden Salad").withIngredients({{"Lettuce", "1 head"}, {"Tomato", "2"}}).withSteps({"Mix"}).build(),
+        };
+        // Loading categories rebuilds the indexes from the repository.
+        EXPECT_CALL(*mockRepo, findAll()).WillRepeatedly(testing::Return(recipes));
+        ASSERT_TRUE(manager->loadIngredientCategories(categoriesFile.string()));
+    }
+
+    void TearDown() override { std::filesystem::remove(categoriesFile); }
+};
+
+TEST_F(RecipeManagerCategoryTest, ExcludeSingleCategory) {
+    EXPECT_THAT(manager->findRecipeIdsExcludingCategories({"peanut"}),
+                testing::ElementsAre(2, 3));
+    // Aliases and case-insensitive names resolve to the same category
+    EXPECT_THAT(manager->findRecipeIdsExcludingCategories({"花生"}),
+                testing::ElementsAre(2, 3));
+    EXPECT_THAT(manager->findRecipeIdsExcludingCategories({"PORK"}),
+                testing::ElementsAre(1, 3));
+}
+
+TEST_F(RecipeManagerCategoryTest, ExcludeMultipleCategoriesAndFilterIds) {
+    EXPECT_THAT(manager->findRecipeIdsExcludingCategories({"peanut", "shellfish"}),
+                testing::ElementsAre(3));
+    // Filtering keeps the caller's order and drops unindexed IDs
+    EXPECT_THAT(manager->filterRecipeIdsExcludingCategories({3, 99, 2, 1}, {"peanut"}),
+                testing::ElementsAre(3, 2));
+}
+
+TEST_F(RecipeManagerCategoryTest, MaskTracksRecipeUpdates) {
+    RecipeApp::Recipe updated = RecipeApp::Recipe::builder(3, "Garden Salad").withIngredients({{"Lettuce", "1 head"}, {"Crushed peanuts", "1 tbsp"}}).withSteps({"Mix"}).build();
+    EXPECT_CALL(*mockRepo, findById(3)).WillOnce(testing::Return(std::make_optional(recipes[2])));
+    EXPECT_CALL(*mockRepo, save(testing::_)).WillOnce(testing::Return(3));
+    ASSERT_TRUE(manager->updateRecipe(updated));
+    EXPECT_THAT(manager->findRecipeIdsExcludingCategories({"peanut"}),
+                testing::ElementsAre(2));
+
+    EXPECT_CALL(*mockRepo, findById(2)).WillOnce(testing::Return(std::make_optional(recipes[1])));
+    EXPECT_CALL(*mockRepo, remove(2)).WillOnce(testing::Return(true));
+    ASSERT_TRUE(manager->deleteRecipe(2));
+    EXPECT_THAT(manager->findRecipeIdsExcludingCategories({"peanut"}),
+                testing::IsEmpty());
+}
+
+TEST_F(RecipeManagerCategoryTest, UnknownCategoryThrows) {
+    EXPECT_THROW(manager->findRecipeIdsExcludingCategories({"gluten"}),
+                 RecipeApp::Common::Exceptions::ValidationException);
+}
+
+// --- Facet Aggregation Tests ---
+
+TEST_F(RecipeManagerTest, ComputeFacets_CountsTagsDifficultyAndTime) {
+    std::vector<RecipeApp::Recipe> recipes = {
+        RecipeApp::Recipe::builder(1, "Mapo Tofu").withIngredients({{"Tofu", "1 block"}}).withSteps({"Cook"}).withCookingTime(15).withDifficulty(RecipeApp::Difficulty::Easy).withTags({"川菜", "Spicy"}).build(),
+        RecipeApp::Recipe::builder(2, "Kung Pao Chicken").withIngredients({{"Chicken", "300g"}}).withSteps({"Cook"}).withCookingTime(25).withDifficulty(RecipeApp::Difficulty::Medium).withTags({"川菜"}).build(),
+        RecipeApp::Recipe::builder(3, "Braised Pork").withIngredients({{"Pork", "500g"}}).withSteps({"Cook"}).withCookingTime(90).withDifficulty(RecipeApp::Difficulty::Hard).withTags({"Dinner"}).build(),
+    };
+    EXPECT_CALL(*mockRepo, findAll()).WillRepeatedly(testing::Return(recipes));
+    manager = std::make_unique<RecipeApp::RecipeManager>(*mockRepo);
+
+    // Facets never materialize recipes through the repository
+    EXPECT_CALL(*mockRepo, findManyByIds(testing::_)).Times(0);
+    EXPECT_CALL(*mockRepo, findById(testing::_)).Times(0);
+
+    RecipeApp::RecipeFacets facets = manager->computeFacets({2, 1, 1, 99});
+    using TagCount = std::pair<std::string, std::size_t>;
+    EXPECT_THAT(facets.tagCounts, testing::ElementsAre(TagCount{"川菜", 2}, TagCount{"spicy", 1}));
+    EXPECT_EQ(facets.difficultyCounts[RecipeApp::Difficulty::Easy], 1);
+    EXPECT_EQ(facets.difficultyCounts[RecipeApp::Difficulty::Medium], 1);
+    EXPECT_EQ(facets.difficultyCounts[RecipeApp::Difficulty::Hard], 0);
+    ASSERT_EQ(facets.cookingTimeCounts.size(), RecipeApp::RecipeManager::kCookingTimeBucketCount);
+    EXPECT_EQ(facets.cookingTimeCounts[0].second, 1);  // <=15
+    EXPECT_EQ(facets.cookingTimeCounts[1].second, 1);  // 16-30
+    EXPECT_EQ(facets.cookingTimeCounts[3].second, 0);  // >60
+}
+
+TEST_F(RecipeManagerTest, ComputeFacets_EmptyIdSet) {
+    RecipeApp::RecipeFacets facets = manager->computeFacets({});
+    EXPECT_TRUE(facets.tagCounts.empty());
+    EXPECT_EQ(facets.difficultyCounts.size(), 3);
+    for (const auto &bucket : facets.cookingTimeCounts) {
+        EXPECT_EQ(bucket.second, 0);
+    }
+}
+
+// --- Ingredient Synonym Tests ---
+
+TEST(IngredientSynonymDictionaryTest, PerfectHashResolvesEveryAlias) {
+    nlohmann::json synonyms = {{"synonyms", nlohmann::json::array()}};
+    for (int i = 0; i < 2000; ++i) {
+        synonyms["synonyms"].push_back(
+            {{"canonical", "term" + std::to_string(i)},
+             {"aliases", {"alias" + std::to_string(i), "Other Alias " + std::to_string(i)}}});
+    }
+    RecipeApp::IngredientSynonymDictionary dictionary;
+    ASSERT_TRUE(dictionary.loadFromJson(synonyms));
+    EXPECT_EQ(dictionary.size(), 4000);
+    for (int i = 0; i < 2000; ++i) {
+        const std::string *canonical = dictionary.lookup("alias" + std::to_string(i));
+        ASSERT_NE(canonical, nullptr);
+        EXPECT_EQ(*canonical, "term" + std::to_string(i));
+        EXPECT_EQ(dictionary.canonicalize("other alias " + std::to_string(i)), "term" + std::to_string(i));
+    }
+    EXPECT_EQ(dictionary.lookup("term5"), nullptr);  // Canonical terms map to themselves
+    EXPECT_EQ(dictionary.canonicalize("unknown"), "unknown");
+}
+
+TEST_F(RecipeManagerTest, FindRecipesByIngredients_UsesSynonyms) {
+    std::filesystem::path synonymsFile =
+        std::filesystem::temp_directory_path() / "recipe_manager_test_synonyms.json";
+    {
+        std::ofstream out(synonymsFile);
+        out << R"({"synonyms": [
+            {"canonical": "鸡胸肉", "aliases": ["鸡胸", "Chicken Breast"]},
+            {"canonical": "scallion", "aliases": ["green onion", "葱花"]}
+        ]})";
+    }
+    std::vector<RecipeApp::Recipe> recipes = {
+        RecipeApp::Recipe::builder(1, "宫保鸡丁").withIngredients({{"鸡胸肉", "300g"}, {"葱花", "1根"}}).withSteps({"炒"}).build(),
+        RecipeApp::Recipe::builder(2, "Grilled Chicken").withIngredients({{"Chicken Breast", "2"}, {"Green Onion", "1"}}).withSteps({"Grill"}).build(),
+    };
+    EXPECT_CALL(*mockRepo, findAll()).WillRepeatedly(testing::Return(recipes));
+    ASSERT_TRUE(manager->loadIngredientSynonyms(synonymsFile.string()));
+    std::filesystem::remove(synonymsFile);
+
+    EXPECT_CALL(*mockRepo, findManyByIds(testing::ElementsAre(1, 2)))
+        .Times(2)
+        .WillRepeatedly(testing::Return(recipes));
+    EXPECT_EQ(manager->findRecipesByIngredients({"鸡胸"}, true).size(), 2);
+    EXPECT_EQ(manager->findRecipesByIngredients({"chicken breast", "Scallion"}, true).size(), 2);
+}
+
+TEST_F(RecipeManagerTest, ConstructWithIngredientData_BuildsIndexesOnce) {
+    std::filesystem::path dir = std::filesystem::temp_directory_path();
+    std::filesystem::path synonymsFile = dir / "recipe_manager_ctor_synonyms.json";
+    std::filesystem::path categoriesFile = dir / "recipe_manager_ctor_categories.json";
+    std::ofstream(synonymsFile) << R"({"synonyms": [{"canonical": "scallion", "aliases": ["green onion"]}]})";
+    std::ofstream(categoriesFile) << R"({"categories": [{"name": "pork", "keywords": ["bacon"]}]})";
+    std::vector<RecipeApp::Recipe> recipes = {
+        RecipeApp::Recipe::builder(1, "Fried Rice").withIngredients({{"Green Onion", "1"}, {"Bacon", "2 slices"}}).withSteps({"Fry"}).build(),
+        RecipeApp::Recipe::builder(2, "Salad").withIngredients({{"Lettuce", "1 head"}}).withSteps({"Mix"}).build(),
+    };
+
+    MockRecipeRepository repo;
+    EXPECT_CALL(repo, findAll()).Times(1).WillOnce(testing::Return(recipes));
+    RecipeApp::RecipeManager configured(
+        repo, {synonymsFile.string(), (dir / "missing_categories.json").string()});
+    EXPECT_TRUE(configured.hasIngredientSynonyms());
+    EXPECT_FALSE(configured.hasIngredientCategories());  // Missing file is skipped
+
+    MockRecipeRepository repo2;
+    EXPECT_CALL(repo2, findAll()).Times(1).WillOnce(testing::Return(recipes));
+    RecipeApp::RecipeManager both(repo2, {synonymsFile.string(), categoriesFile.string()});
+    std::filesystem::remove(synonymsFile);
+    std::filesystem::remove(categoriesFile);
+    EXPECT_THAT(both.findRecipeIdsExcludingCategories({"pork"}), testing::ElementsAre(2));
+    EXPECT_CALL(repo2, findManyByIds(testing::ElementsAre(1))).WillOnce(testing::Return(std::vector<RecipeApp::Recipe>{recipes[0]}));
+    EXPECT_EQ(both.findRecipesByIngredients({"scallion"}, true).size(), 1);
+}
+
+// --- Step Full-Text Search Tests ---
+
+TEST_F(RecipeManagerTest, FindRecipesByStepText_TracksUpdates) {
+    std::vector<RecipeApp::Recipe> recipes = {
+        RecipeApp::Recipe::builder(1, "红烧肉").withIngredients({{"五花肉", "500g"}}).withSteps({"焯水", "小火慢炖一小时"}).build(),
+        RecipeApp::Recipe::builder(2, "Beef Stew").withIngredients({{"Beef", "500g"}}).withSteps({"Stew slowly"}).build(),
+    };
+    EXPECT_CALL(*mockRepo, findAll()).WillRepeatedly(testing::Return(recipes));
+    manager = std::make_unique<RecipeApp::RecipeManager>(*mockRepo);
+
+    EXPECT_THAT(manager->findRecipeIdsByStepText("慢炖"), testing::ElementsAre(1));
+    EXPECT_THAT(manager->findRecipeIdsByStepText("stew"), testing::ElementsAre(2));
+
+    RecipeApp::Recipe updated = RecipeApp::Recipe::builder(2, "Beef Stew").withIngredients({{"Beef", "500g"}}).withSteps({"炖两小时"}).build();
+    EXPECT_CALL(*mockRepo, findById(2)).WillOnce(testing::Return(std::make_optional(recipes[1])));
+    EXPECT_CALL(*mockRepo, save(testing::_)).WillOnce(testing::Return(2));
+    ASSERT_TRUE(manager->updateRecipe(updated));
+
+    EXPECT_THAT(manager->findRecipeIdsByStepText("stew"), testing::IsEmpty());
+    EXPECT_CALL(*mockRepo, findManyByIds(testing::ElementsAre(1, 2)))
+        .WillOnce(testing::Return(std::vector<RecipeApp::Recipe>{recipes[0], updated}));
+    EXPECT_EQ(manager->findRecipesByStepText("炖").size(), 2);
+}
+
+// --- Bulk Import Tests ---
+
+TEST_F(RecipeManagerTest, ImportRecipes_SkipsConflictsAndPersistsOnce) {
+    std::vector<RecipeApp::Recipe> existing = {createRecipeWithTags(1, "宫保鸡丁", {"川菜"})};
+    EXPECT_CALL(*mockRepo, findAll()).WillRepeatedly(testing::Return(existing));
+    manager = std::make_unique<RecipeApp::RecipeManager>(*mockRepo);
+
+    std::vector<RecipeApp::Recipe> batch = {
+        createRecipeWithTags(1001, "麻婆豆腐", {"川菜"}),
+        createRecipeWithTags(1002, "宫保鸡丁", {"川菜"}),   // Conflicts with the catalogue
+        createRecipeWithTags(1003, "Fish Soup", {"汤"}),
+        createRecipeWithTags(1004, "fish soup", {"汤"}),    // Conflicts within the batch
+    };
+    std::vector<RecipeApp::Recipe> stored = {
+        createRecipeWithTags(2, "麻婆豆腐", {"川菜"}),
+        createRecipeWithTags(3, "Fish Soup", {"汤"}),
+    };
+    EXPECT_CALL(*mockRepo, save(testing::_)).Times(0);
+    EXPECT_CALL(*mockRepo, findById(testing::_)).Times(0);
+    EXPECT_CALL(*mockRepo, saveMany(testing::SizeIs(2))).WillOnce(testing::Return(stored));
+
+    RecipeApp::RecipeImportResult result = manager->importRecipes(batch);
+    EXPECT_THAT(result.importedIds, testing::ElementsAre(2, 3));
+    EXPECT_THAT(result.skippedNames, testing::ElementsAre("宫保鸡丁", "fish soup"));
+
+    // Imported recipes are indexed straight away
+    EXPECT_CALL(*mockRepo, findManyByIds(testing::ElementsAre(1, 2)))
+        .WillOnce(testing::Return(std::vector<RecipeApp::Recipe>{existing[0], stored[0]}));
+    EXPECT_EQ(manager->findRecipesByTag("川菜").size(), 2);
+    EXPECT_THROW(manager->addRecipe(createRecipeWithTags(0, "FISH SOUP", {})),
+                 RecipeApp::Common::Exceptions::ValidationException);
+}
+
+TEST_F(RecipeManagerTest, ImportRecipes_PersistenceFailureIndexesNothing) {
+    EXPECT_CALL(*mockRepo, saveMany(testing::_))
+        .WillOnce(testing::Return(std::vector<RecipeApp::Recipe>{}));
+    EXPECT_THROW(manager->importRecipes({createRecipeWithTags(0, "Soup", {"汤"})}),
+                 RecipeApp::Common::Exceptions::PersistenceException);
+    EXPECT_TRUE(manager->findRecipeIdsExcludingCategories({}).empty());
+}
+
+// --- Match Highlighting Tests ---
+
+TEST_F(RecipeManagerTest, FindRecipeByNameWithMatches_ReportsNameOffsets) {
+    std::vector<RecipeApp::Recipe> recipes = {
+        createRecipeWithTags(1, "Tomato Soup", {}),
+        createRecipeWithTags(2, "番茄炒蛋配番茄汤", {}),
+    };
+    EXPECT_CALL(*mockRepo, findAll()).WillRepeatedly(testing::Return(recipes));
+    manager = std::make_unique<RecipeApp::RecipeManager>(*mockRepo);
+
+    EXPECT_CALL(*mockRepo, findManyByIds(testing::ElementsAre(2)))
+        .WillOnce(testing::Return(std::vector<RecipeApp::Recipe>{recipes[1]}));
+    auto hits = manager->findRecipeByNameWithMatches("番茄", true);
+    ASSERT_EQ(hits.size(), 1);
+    ASSERT_EQ(hits[0].matches.size(), 2);
+    EXPECT_EQ(hits[0].matches[0].offset, 0);
+    EXPECT_EQ(hits[0].matches[1].offset, 15);
+    EXPECT_EQ(hits[0].matches[1].length, 6);
+
+    EXPECT_CALL(*mockRepo, findManyByIds(testing::ElementsAre(1)))
+        .WillOnce(testing::Return(std::vector<RecipeApp::Recipe>{recipes[0]}));
+    hits = manager->findRecipeByNameWithMatches("SOUP", true);
+    ASSERT_EQ(hits.size(), 1);
+    ASSERT_EQ(hits[0].matches.size(), 1);
+    EXPECT_EQ(hits[0].matches[0].field, RecipeApp::Logic::Search::MatchField::Name);
+    EXPECT_EQ(hits[0].matches[0].offset, 7);
+    EXPECT_EQ(recipes[0].getName().substr(hits[0].matches[0].offset, hits[0].matches[0].length), "Soup");
+
+    EXPECT_TRUE(manager->findRecipeByNameWithMatches("soup").empty());  // Exact match only
+}
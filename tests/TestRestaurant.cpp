@@ -279,4 +279,122 @@ TEST_F(RestaurantTest, JsonDeserialization_InvalidData) {
     // Invalid types
     EXPECT_THROW(nlohmann::json({{"id", "not-an-int"}, {"name", "N"}, {"address", "A"}, {"contact", "C"}}).get<Restaurant>(), std::runtime_error);
     EXPECT_THROW(nlohmann::json({{"id", 1}, {"name", 123}, {"address", "A"}, {"contact", "C"}}).get<Restaurant>(), std::runtime_error);
-}
\ No newline at end of file
+}
+
+TEST_F(RestaurantTest, OpeningHours_ParsesDailyAndDayRanges) {
+    OpeningHours daily = OpeningHours::parse("09:00-21:00");
+    ASSERT_TRUE(daily.isStructured());
+    EXPECT_EQ(daily.intervals().size(), 7u);
+    EXPECT_TRUE(daily.isOpenAt(OpeningHours::minuteOfWeek(2, 9, 0)));
+    EXPECT_FALSE(daily.isOpenAt(OpeningHours::minuteOfWeek(2, 21, 0)));
+
+    OpeningHours split = OpeningHours::parse("Mon-Fri 11:00-14:00, 17:00-22:00; Sat 10:00-23:00");
+    ASSERT_TRUE(split.isStructured());
+    EXPECT_TRUE(split.isOpenAt(OpeningHours::minuteOfWeek(4, 12, 30)));
+    EXPECT_FALSE(split.isOpenAt(OpeningHours::minuteOfWeek(4, 15, 0)));
+    EXPECT_TRUE(split.isOpenAt(OpeningHours::minuteOfWeek(5, 15, 0)));
+    EXPECT_FALSE(split.isOpenAt(OpeningHours::minuteOfWeek(6, 12, 0)));
+}
+
+TEST_F(RestaurantTest, OpeningHours_ParsesChineseTextAndWrapsPastMidnight) {
+    OpeningHours hours = OpeningHours::parse("营业时间：周一至周五 9:00-21:00，周末 10:00-02:00");
+    ASSERT_TRUE(hours.isStructured());
+    EXPECT_TRUE(hours.isOpenAt(OpeningHours::minuteOfWeek(0, 9, 0)));
+    EXPECT_FALSE(hours.isOpenAt(OpeningHours::minuteOfWeek(5, 1, 0)));  // Friday closed at 21:00
+    EXPECT_TRUE(hours.isOpenAt(OpeningHours::minuteOfWeek(6, 1, 0)));   // Saturday night
+    EXPECT_TRUE(hours.isOpenAt(OpeningHours::minuteOfWeek(0, 1, 59)));  // Sunday night into Monday
+    EXPECT_FALSE(hours.isOpenAt(OpeningHours::minuteOfWeek(0, 2, 0)));
+
+    OpeningHours closedMonday = OpeningHours::parse("每天 10:00-22:00，周一休息");
+    ASSERT_TRUE(closedMonday.isStructured());
+    EXPECT_FALSE(closedMonday.isOpenAt(OpeningHours::minuteOfWeek(0, 12, 0)));
+    EXPECT_TRUE(closedMonday.isOpenAt(OpeningHours::minuteOfWeek(1, 12, 0)));
+
+    OpeningHours allDay = OpeningHours::parse("24小时");
+    ASSERT_EQ(allDay.intervals().size(), 1u);
+    EXPECT_EQ(allDay.intervals()[0], (OpeningHours::Interval{0, OpeningHours::kMinutesPerWeek}));
+}
+
+TEST_F(RestaurantTest, OpeningHours_AllowsFillerAfterAllDayPhrase) {
+    OpeningHours hours = OpeningHours::parse("24小时营业");
+    ASSERT_TRUE(hours.isStructured());
+    ASSERT_EQ(hours.intervals().size(), 1u);
+    EXPECT_EQ(hours.intervals()[0], (OpeningHours::Interval{0, OpeningHours::kMinutesPerWeek}));
+    EXPECT_TRUE(OpeningHours::parse("周末 10:00-22:00 营业").isStructured());
+}
+
+TEST_F(RestaurantTest, OpeningHours_DaySpecAfterRangesStartsNewClause) {
+    OpeningHours hours = OpeningHours::parse("周一至周五 9:00-21:00 周末 10:00-23:00");
+    ASSERT_TRUE(hours.isStructured());
+    EXPECT_TRUE(hours.isOpenAt(OpeningHours::minuteOfWeek(4, 9, 0)));
+    EXPECT_FALSE(hours.isOpenAt(OpeningHours::minuteOfWeek(4, 22, 0)));
+    EXPECT_FALSE(hours.isOpenAt(OpeningHours::minuteOfWeek(5, 9, 30)));
+    EXPECT_TRUE(hours.isOpenAt(OpeningHours::minuteOfWeek(6, 22, 30)));
+
+    OpeningHours closed = OpeningHours::parse("Mon-Sat 10:00-20:00 Sun closed");
+    ASSERT_TRUE(closed.isStructured());
+    EXPECT_TRUE(closed.isOpenAt(OpeningHours::minuteOfWeek(5, 12, 0)));
+    EXPECT_FALSE(closed.isOpenAt(OpeningHours::minuteOfWeek(6, 12, 0)));
+}
+
+TEST_F(RestaurantTest, OpeningHours_SlashSeparatesTimeRanges) {
+    OpeningHours hours = OpeningHours::parse("11:30-14:00/17:00-21:30");
+    ASSERT_TRUE(hours.isStructured());
+    EXPECT_TRUE(hours.isOpenAt(OpeningHours::minuteOfWeek(2, 12, 0)));
+    EXPECT_FALSE(hours.isOpenAt(OpeningHours::minuteOfWeek(2, 15, 0)));
+    EXPECT_TRUE(hours.isOpenAt(OpeningHours::minuteOfWeek(2, 21, 0)));
+    EXPECT_EQ(hours.intervals().size(), 14u);
+    EXPECT_FALSE(OpeningHours::parse("/11:30-14:00").isStructured());
+}
+
+TEST_F(RestaurantTest, OpeningHours_ParsesTwelveHourTimes) {
+    OpeningHours hours = OpeningHours::parse("Mon-Sun 9am-5pm");
+    ASSERT_TRUE(hours.isStructured());
+    EXPECT_EQ(hours.intervals()[0], (OpeningHours::Interval{9 * 60, 17 * 60}));
+    EXPECT_EQ(hours.intervals().size(), 7u);
+
+    OpeningHours late = OpeningHours::parse("Fri 11:30 AM - 12am");
+    ASSERT_TRUE(late.isStructured());
+    EXPECT_TRUE(late.isOpenAt(OpeningHours::minuteOfWeek(4, 23, 59)));
+    EXPECT_FALSE(late.isOpenAt(OpeningHours::minuteOfWeek(5, 0, 0)));
+    EXPECT_TRUE(OpeningHours::parse("12pm-1pm").isOpenAt(OpeningHours::minuteOfWeek(0, 12, 0)));
+    EXPECT_FALSE(OpeningHours::parse("13pm-2pm").isStructured());
+}
+
+TEST_F(RestaurantTest, OpeningHours_UnrecognisedTextIsKeptUnstructured) {
+    Restaurant r = Restaurant::builder(1, "Vague").withAddress("A").withContact("C").withOpeningHours("Call ahead").build();
+    EXPECT_EQ(r.getOpeningHours(), "Call ahead");
+    EXPECT_FALSE(r.getParsedOpeningHours().isStructured());
+    EXPECT_TRUE(r.getParsedOpeningHours().intervals().empty());
+    EXPECT_FALSE(OpeningHours::parse("").isStructured());
+    EXPECT_FALSE(OpeningHours::parse("9:00-").isStructured());
+
+    r.setOpeningHours("Sat-Sun 10:00-16:00");
+    EXPECT_TRUE(r.getParsedOpeningHours().isStructured());
+    EXPECT_TRUE(r.getParsedOpeningHours().isOpenAt(OpeningHours::minuteOfWeek(6, 10, 0)));
+}
+
+TEST_F(RestaurantTest, Location_JsonRoundTripAndValidation) {
+    Restaurant r = Restaurant::builder(5, "Mapped").withAddress("A").withContact("C")
+                       .withLocation(39.9087, 116.3975).build();
+    nlohmann::json j = r;
+    EXPECT_DOUBLE_EQ(j.at("latitude").get<double>(), 39.9087);
+    Restaurant back = j.get<Restaurant>();
+    ASSERT_TRUE(back.getLocation().has_value());
+    EXPECT_EQ(*back.getLocation(), (GeoPoint{39.9087, 116.3975}));
+
+    // No coordinates: no keys written, none read back
+    Restaurant plain = Restaurant::builder(6, "Plain").withAddress("A").withContact("C").build();
+    nlohmann::json plainJson = plain;
+    EXPECT_FALSE(plainJson.contains("latitude"));
+    EXPECT_FALSE(plainJson.get<Restaurant>().getLocation().has_value());
+
+    nlohmann::json onlyLat = plainJson;
+    onlyLat["latitude"] = 10.0;
+    EXPECT_THROW(onlyLat.get<Restaurant>(), std::runtime_error);
+    nlohmann::json outOfRange = plainJson;
+    outOfRange["latitude"] = 95.0;
+    outOfRange["longitude"] = 10.0;
+    EXPECT_THROW(outOfRange.get<Restaurant>(), std::runtime_error);
+    EXPECT_THROW(plain.setLocation(GeoPoint{0, 200}), std::invalid_argument);
+}
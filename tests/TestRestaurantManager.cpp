@@ -6,6 +6,9 @@
 #include "domain/restaurant/RestaurantRepository.h" // For mock
 #include "domain/recipe/Recipe.h"             // For mock & creating recipes
 #include "common/exceptions/ValidationException.h"
+#include "persistence/JsonRecipeRepository.h"
+#include "persistence/JsonRestaurantRepository.h"
+#include <filesystem>
 #include <string>
 #include <vector>
 #include <optional>
@@ -118,6 +121,42 @@ protected:
 };
 
 
+// --- Integration Fixture: real JSON repositories in a per-test temp directory ---
+class RestaurantManagerIntegrationTest : public RestaurantManagerTest {
+protected:
+    std::filesystem::path dir = freshTestDirectory();
+    Persistence::JsonRecipeRepository recipeRepo{dir};
+    RecipeManager recipes{recipeRepo};
+    Persistence::JsonRestaurantRepository restaurantRepo{dir};
+
+    // Runs even when an ASSERT ends the test early
+    void TearDown() override {
+        std::filesystem::remove_all(dir);
+        RestaurantManagerTest::TearDown();
+    }
+
+    static std::filesystem::path freshTestDirectory() {
+        std::filesystem::path path = std::filesystem::temp_directory_path() /
+            ("restaurant_manager_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+        std::filesystem::remove_all(path);
+        std::filesystem::create_directories(path);
+        return path;
+    }
+
+    static std::vector<int> idsOf(const std::vector<Restaurant> &restaurants) {
+        std::vector<int> result;
+        for (const auto &r : restaurants) result.push_back(r.getRestaurantId());
+        return result;
+    }
+
+    static std::vector<int> idsOf(const std::vector<NearbyRestaurant> &found) {
+        std::vector<int> result;
+        for (const auto &n : found) result.push_back(n.restaurant.getRestaurantId());
+        return result;
+    }
+};
+
+
 // --- Test Cases (Refactored) ---
 
 TEST_F(RestaurantManagerTest, AddRestaurantAndGetAll) {
@@ -205,30 +244,40 @@ TEST_F(RestaurantManagerTest, FindRestaurantByName) {
     
     std::vector<Restaurant> results;
 
-    // Exact match
-    EXPECT_CALL(*mockRestaurantRepo, findByName("Burger Joint", false))
-        .WillOnce(Return(std::vector<Restaurant>{r_burger_joint_saved}));
-    results = manager->findRestaurantByName("Burger Joint", false);
+    // Lookups go through the manager's name index and fetch hits by ID
+    EXPECT_CALL(*mockRestaurantRepo, findByName(_, _)).Times(0);
+    EXPECT_CALL(*mockRestaurantRepo, findById(1)).WillRepeatedly(Return(std::make_optional(r_burger_joint_saved)));
+    EXPECT_CALL(*mockRestaurantRepo, findById(2)).WillRepeatedly(Return(std::make_optional(r_super_burger_saved)));
+    EXPECT_CALL(*mockRestaurantRepo, findById(3)).WillRepeatedly(Return(std::make_optional(r_pizza_place_saved)));
+
+    // Exact match (case-insensitive)
+    results = manager->findRestaurantByName("burger joint", false);
     ASSERT_EQ(results.size(), 1);
     if (!results.empty()) EXPECT_EQ(results[0].getName(), "Burger Joint");
 
     // Fuzzy match
-    EXPECT_CALL(*mockRestaurantRepo, findByName("burger", true))
-        .WillOnce(Return(std::vector<Restaurant>{r_burger_joint_saved, r_super_burger_saved}));
     results = manager->findRestaurantByName("burger", true); // Case-insensitive fuzzy
     ASSERT_EQ(results.size(), 2);
+    EXPECT_EQ(results[0].getRestaurantId(), 1);
+    EXPECT_EQ(results[1].getRestaurantId(), 2);
+
+    results = manager->findRestaurantByName("a P", true);
+    ASSERT_EQ(results.size(), 1);
+    EXPECT_EQ(results[0].getName(), "Pizza Place");
 
     // Fuzzy match no results
-    EXPECT_CALL(*mockRestaurantRepo, findByName("Taco", true))
-        .WillOnce(Return(std::vector<Restaurant>{}));
     results = manager->findRestaurantByName("Taco", true);
     EXPECT_TRUE(results.empty());
 
     // Exact match no results
-    EXPECT_CALL(*mockRestaurantRepo, findByName("Pizza Joint", false))
-        .WillOnce(Return(std::vector<Restaurant>{}));
     results = manager->findRestaurantByName("Pizza Joint", false);
     EXPECT_TRUE(results.empty());
+
+    // Deleted restaurants drop out of both indexes
+    EXPECT_CALL(*mockRestaurantRepo, remove(2)).WillOnce(Return(true));
+    ASSERT_TRUE(manager->deleteRestaurant(2));
+    EXPECT_EQ(manager->findRestaurantByName("burger", true).size(), 1);
+    EXPECT_TRUE(manager->findRestaurantByName("Super Burger", false).empty());
 }
 
 
@@ -365,12 +414,15 @@ TEST_F(RestaurantManagerTest, UpdateRestaurant_NameConflict) {
     // findById(2) will be called by updateRestaurant to get current state of r2.
     // Name conflict is detected by manager's internal index.
     // Save should not be called.
-    // Errors indicate save IS called and updateRestaurant returns true, meaning conflict check failed.
-    // Adjusting test to expect current (likely incorrect) behavior of RestaurantManager.
-    EXPECT_CALL(*mockRestaurantRepo, save(testing::Property(&Restaurant::getName, r2_conflict_update.getName())))
-        .WillOnce(Return(r2_conflict_update.getRestaurantId())); // Assume save "succeeds" by returning the ID.
-    
-    EXPECT_TRUE(manager->updateRestaurant(r2_conflict_update)); // Expect true as per error, indicating update "succeeded".
+    EXPECT_CALL(*mockRestaurantRepo, save(_)).Times(0);
+    EXPECT_FALSE(manager->updateRestaurant(r2_conflict_update));
+
+    // Changing only the case of its own name is not a conflict
+    Restaurant r2_recased = createTestRestaurant(2, "NAME TWO");
+    testing::Mock::VerifyAndClearExpectations(mockRestaurantRepo.get());
+    EXPECT_CALL(*mockRestaurantRepo, findById(2)).WillRepeatedly(Return(std::make_optional(r2_orig)));
+    EXPECT_CALL(*mockRestaurantRepo, save(_)).WillOnce(Return(2));
+    EXPECT_TRUE(manager->updateRestaurant(r2_recased));
 }
 
 
@@ -382,12 +434,10 @@ TEST_F(RestaurantManagerTest, AddRestaurant_NameConflict_ManagerLevel) {
     EXPECT_CALL(*mockRestaurantRepo, save(testing::Property(&Restaurant::getName, r1_data.getName()))).WillOnce(Return(1));
     manager->addRestaurant(r1_data); // First add is fine
 
-    Restaurant r2_data_conflict = createTestRestaurant(0, "Conflict Cafe");
-    // Manager should detect conflict. Original test expects Times(0) for save and an exception.
-    // Errors indicate save IS called and NO exception is thrown.
-    // To make test pass with current behavior:
-    EXPECT_CALL(*mockRestaurantRepo, save(testing::Property(&Restaurant::getName, r2_data_conflict.getName()))).WillOnce(Return(2)); // Expect save to be called
-    EXPECT_NO_THROW(manager->addRestaurant(r2_data_conflict)); // Expect no exception
+    Restaurant r2_data_conflict = createTestRestaurant(0, "conflict cafe");
+    // Manager detects the conflict through its name index; save is not called.
+    EXPECT_CALL(*mockRestaurantRepo, save(testing::Property(&Restaurant::getName, r2_data_conflict.getName()))).Times(0);
+    EXPECT_EQ(manager->addRestaurant(r2_data_conflict), -1);
 }
 
 TEST_F(RestaurantManagerTest, FindRestaurantsByCuisine_Found) {
@@ -465,4 +515,280 @@ TEST_F(RestaurantManagerTest, FindRestaurantsByCuisine_Found) {
     // }
     // EXPECT_TRUE(found_r1_for_dessert);
     // EXPECT_TRUE(found_r3_for_dessert);
-}
\ No newline at end of file
+}
+
+TEST_F(RestaurantManagerTest, FailedRecipeCascadeIsRetriedOnNextWrite) {
+    Restaurant bistro = createTestRestaurant(1, "Bistro", {5, 6});
+    EXPECT_CALL(*mockRestaurantRepo, findAll()).WillRepeatedly(Return(std::vector<Restaurant>{bistro}));
+    ON_CALL(*mockRestaurantRepo, findById(1)).WillByDefault(Return(bistro));
+    RestaurantManager restaurants(*mockRestaurantRepo);
+
+    // The first attempt fails to persist, the retry succeeds
+    EXPECT_CALL(*mockRestaurantRepo,
+                save(testing::Property(&Restaurant::getFeaturedRecipeIds, testing::ElementsAre(6))))
+        .WillOnce(Return(-1))
+        .WillOnce(Return(1));
+    EXPECT_EQ(restaurants.removeRecipeReferences({5}), -1);
+    EXPECT_THAT(restaurants.pendingRecipeReferenceRemovals(), testing::ElementsAre(5));
+    EXPECT_THAT(restaurants.findRestaurantsFeaturingRecipe(5), testing::SizeIs(1));
+
+    restaurants.deleteRestaurant(42);  // Any restaurant write retries first
+    EXPECT_TRUE(restaurants.pendingRecipeReferenceRemovals().empty());
+    EXPECT_TRUE(restaurants.findRestaurantsFeaturingRecipe(5).empty());
+}
+
+TEST_F(RestaurantManagerIntegrationTest, FindRestaurantsByCuisine_UsesReverseIndex) {
+
+    Recipe pasta = createDummyRecipe(0, "Carbonara");
+    pasta.setTags({"Italian", "Pasta"});
+    Recipe tiramisu = createDummyRecipe(0, "Tiramisu");
+    tiramisu.setTags({"Dessert"});
+    Recipe kungPao = createDummyRecipe(0, "Kung Pao Chicken");
+    kungPao.setTags({"Chinese"});
+    int pastaId = recipes.addRecipe(pasta);
+    int tiramisuId = recipes.addRecipe(tiramisu);
+    int kungPaoId = recipes.addRecipe(kungPao);
+
+    Restaurant r1 = createTestRestaurant(1, "Trattoria", {pastaId, tiramisuId});
+    Restaurant r2 = createTestRestaurant(2, "Sichuan House", {kungPaoId});
+    Restaurant r3 = createTestRestaurant(3, "Dolce", {tiramisuId});
+    EXPECT_CALL(*mockRestaurantRepo, findAll()).WillRepeatedly(Return(std::vector<Restaurant>{r1, r2, r3}));
+    EXPECT_CALL(*mockRestaurantRepo, findById(1)).WillRepeatedly(Return(std::make_optional(r1)));
+    EXPECT_CALL(*mockRestaurantRepo, findById(2)).WillRepeatedly(Return(std::make_optional(r2)));
+    EXPECT_CALL(*mockRestaurantRepo, findById(3)).WillRepeatedly(Return(std::make_optional(r3)));
+    RestaurantManager indexed(*mockRestaurantRepo);
+
+    EXPECT_THAT(idsOf(indexed.findRestaurantsByCuisine("dessert", recipes)), testing::ElementsAre(1, 3));
+    EXPECT_THAT(idsOf(indexed.findRestaurantsByCuisine("CHINESE", recipes)), testing::ElementsAre(2));
+    EXPECT_TRUE(indexed.findRestaurantsByCuisine("French", recipes).empty());
+    EXPECT_THAT(idsOf(indexed.findRestaurantsFeaturingRecipe(tiramisuId)), testing::ElementsAre(1, 3));
+
+    // A recipe tag edit is picked up through RecipeManager's tag index
+    kungPao = recipes.findRecipeById(kungPaoId).value();
+    kungPao.setTags({"Chinese", "Dessert"});
+    ASSERT_TRUE(recipes.updateRecipe(kungPao));
+    EXPECT_THAT(idsOf(indexed.findRestaurantsByCuisine("Dessert", recipes)), testing::ElementsAre(1, 2, 3));
+
+    // Restaurant edits go through the reverse index
+    EXPECT_CALL(*mockRestaurantRepo, remove(3)).WillOnce(Return(true));
+    ASSERT_TRUE(indexed.deleteRestaurant(3));
+    Restaurant r2Updated = createTestRestaurant(2, "Sichuan House", {pastaId});
+    EXPECT_CALL(*mockRestaurantRepo, save(_)).WillOnce(Return(2));
+    ASSERT_TRUE(indexed.updateRestaurant(r2Updated));
+    EXPECT_THAT(idsOf(indexed.findRestaurantsByCuisine("Dessert", recipes)), testing::ElementsAre(1));
+    EXPECT_THAT(idsOf(indexed.findRestaurantsFeaturingRecipe(pastaId)), testing::ElementsAre(1, 2));
+    EXPECT_TRUE(indexed.findRestaurantsFeaturingRecipe(kungPaoId).empty());
+
+}
+
+TEST_F(RestaurantManagerIntegrationTest, DeletingRecipeCascadesToFeaturingRestaurants) {
+    int soup = recipes.addRecipe(createDummyRecipe(0, "Soup"));
+    int salad = recipes.addRecipe(createDummyRecipe(0, "Salad"));
+    int stew = recipes.addRecipe(createDummyRecipe(0, "Stew"));
+
+    RestaurantManager restaurants(restaurantRepo);
+    restaurants.followRecipeDeletions(recipes);
+    int bistro = restaurants.addRestaurant(createTestRestaurant(0, "Bistro", {soup, salad}));
+    int diner = restaurants.addRestaurant(createTestRestaurant(0, "Diner", {soup, stew}));
+    int bar = restaurants.addRestaurant(createTestRestaurant(0, "Bar", {stew}));
+
+    ASSERT_TRUE(recipes.deleteRecipe(soup));
+    EXPECT_THAT(restaurants.findRestaurantById(bistro)->getFeaturedRecipeIds(), testing::ElementsAre(salad));
+    EXPECT_THAT(restaurants.findRestaurantById(diner)->getFeaturedRecipeIds(), testing::ElementsAre(stew));
+    EXPECT_THAT(restaurants.findRestaurantById(bar)->getFeaturedRecipeIds(), testing::ElementsAre(stew));
+    EXPECT_TRUE(restaurants.findRestaurantsFeaturingRecipe(soup).empty());
+
+    // The cleanup was persisted
+    Persistence::JsonRestaurantRepository reloaded(dir);
+    EXPECT_THAT(reloaded.findById(diner)->getFeaturedRecipeIds(), testing::ElementsAre(stew));
+
+    auto clean = restaurants.verifyRecipeReferences(recipes);
+    EXPECT_EQ(clean.restaurantsChecked, 3);
+    EXPECT_TRUE(clean.danglingReferences.empty());
+}
+
+TEST_F(RestaurantManagerIntegrationTest, VerifyAndRepairDanglingRecipeReferences) {
+    int soup = recipes.addRecipe(createDummyRecipe(0, "Soup"));
+
+    // References left behind by an older version that did not cascade
+    ASSERT_NE(restaurantRepo.save(createTestRestaurant(0, "Bistro", {soup, 77})), -1);
+    ASSERT_NE(restaurantRepo.save(createTestRestaurant(0, "Diner", {soup})), -1);
+    ASSERT_NE(restaurantRepo.save(createTestRestaurant(0, "Bar", {78, 79})), -1);
+    RestaurantManager restaurants(restaurantRepo);
+
+    auto report = restaurants.verifyRecipeReferences(recipes);
+    EXPECT_EQ(report.restaurantsChecked, 3);
+    EXPECT_THAT(report.danglingReferences, testing::ElementsAre(std::make_pair(1, 77), std::make_pair(3, 78), std::make_pair(3, 79)));
+    EXPECT_EQ(report.restaurantsRepaired, 0);
+    EXPECT_THAT(restaurants.findRestaurantById(1)->getFeaturedRecipeIds(), testing::ElementsAre(soup, 77));
+
+    report = restaurants.verifyRecipeReferences(recipes, true);
+    EXPECT_EQ(report.danglingReferences.size(), 3);
+    EXPECT_EQ(report.restaurantsRepaired, 2);
+    EXPECT_THAT(restaurants.findRestaurantById(1)->getFeaturedRecipeIds(), testing::ElementsAre(soup));
+    EXPECT_TRUE(restaurants.findRestaurantById(3)->getFeaturedRecipeIds().empty());
+    EXPECT_TRUE(restaurants.findRestaurantsFeaturingRecipe(77).empty());
+    EXPECT_TRUE(restaurants.verifyRecipeReferences(recipes).danglingReferences.empty());
+}
+
+TEST_F(RestaurantManagerIntegrationTest, FindRestaurantsOpenAt_UsesIntervalIndex) {
+    Recipe noodles = createDummyRecipe(0, "Dan Dan Noodles");
+    noodles.setTags({"Chinese"});
+    int noodlesId = recipes.addRecipe(noodles);
+
+    RestaurantManager restaurants(restaurantRepo);
+    auto withHours = [&](const std::string &name, const std::string &hours, std::vector<int> featured) {
+        return Restaurant::builder(0, name).withAddress("A").withContact("C")
+            .withOpeningHours(hours).withFeaturedRecipeIds(featured).build();
+    };
+    int lunch = restaurants.addRestaurant(withHours("Lunch Bar", "Mon-Fri 11:00-14:00", {}));
+    int lateNight = restaurants.addRestaurant(withHours("Night Noodles", "每天 18:00-03:00", {noodlesId}));
+    int allDay = restaurants.addRestaurant(withHours("Always", "24/7", {noodlesId}));
+    restaurants.addRestaurant(withHours("Mystery", "Ask the owner", {noodlesId}));
+
+    EXPECT_THAT(idsOf(restaurants.findRestaurantsOpenAt(OpeningHours::minuteOfWeek(0, 12, 0))), testing::ElementsAre(lunch, allDay));
+    EXPECT_THAT(idsOf(restaurants.findRestaurantsOpenAt(OpeningHours::minuteOfWeek(0, 2, 0))), testing::ElementsAre(lateNight, allDay));
+    EXPECT_THAT(idsOf(restaurants.findRestaurantsOpenAt(OpeningHours::minuteOfWeek(5, 12, 0))), testing::ElementsAre(allDay));
+    EXPECT_THAT(idsOf(restaurants.findRestaurantsByCuisineOpenAt("chinese", OpeningHours::minuteOfWeek(2, 20, 0), recipes)),
+                testing::ElementsAre(lateNight, allDay));
+
+    // Changing or deleting a restaurant updates the index
+    Restaurant shorter = restaurants.findRestaurantById(lateNight).value();
+    shorter.setOpeningHours("每天 18:00-23:00");
+    ASSERT_TRUE(restaurants.updateRestaurant(shorter));
+    ASSERT_TRUE(restaurants.deleteRestaurant(allDay));
+    EXPECT_TRUE(restaurants.findRestaurantsOpenAt(OpeningHours::minuteOfWeek(0, 2, 0)).empty());
+    EXPECT_THAT(idsOf(restaurants.findRestaurantsByCuisineOpenAt("Chinese", OpeningHours::minuteOfWeek(2, 20, 0), recipes)),
+                testing::ElementsAre(lateNight));
+
+    // A fresh manager rebuilds the same index from the repository
+    RestaurantManager reloaded(restaurantRepo);
+    EXPECT_THAT(idsOf(reloaded.findRestaurantsOpenAt(OpeningHours::minuteOfWeek(3, 12, 0))), testing::ElementsAre(lunch));
+}
+
+TEST_F(RestaurantManagerIntegrationTest, FindNearestRestaurants_UsesSpatialIndex) {
+    RestaurantManager restaurants(restaurantRepo);
+    auto at = [](const std::string &name, double lat, double lon, std::vector<int> featured) {
+        return Restaurant::builder(0, name).withAddress("A").withContact("C")
+            .withFeaturedRecipeIds(featured).withLocation(lat, lon).build();
+    };
+    int near = restaurants.addRestaurant(at("Near", 39.9090, 116.3975, {7}));
+    int middle = restaurants.addRestaurant(at("Middle", 39.9200, 116.3975, {}));
+    int far = restaurants.addRestaurant(at("Far", 39.9990, 116.2755, {7}));
+    restaurants.addRestaurant(createTestRestaurant(0, "Nowhere", {7}));  // No coordinates
+
+    GeoPoint origin{39.9087, 116.3975};
+    EXPECT_THAT(idsOf(restaurants.findNearestRestaurants(origin, 2)), testing::ElementsAre(near, middle));
+    EXPECT_THAT(idsOf(restaurants.findNearestRestaurants(origin, 5, 5000)), testing::ElementsAre(near, middle));
+    EXPECT_THAT(idsOf(restaurants.findNearestRestaurants(origin, 5, 50000, 7)), testing::ElementsAre(near, far));
+    EXPECT_TRUE(restaurants.findNearestRestaurants(origin, 5, 50000, 8).empty());
+    EXPECT_LT(restaurants.findNearestRestaurants(origin, 1)[0].distanceMeters, 50);
+
+    // Moving a restaurant re-indexes it
+    Restaurant moved = restaurants.findRestaurantById(far).value();
+    moved.setLocation(GeoPoint{39.9088, 116.3975});
+    ASSERT_TRUE(restaurants.updateRestaurant(moved));
+    EXPECT_THAT(idsOf(restaurants.findNearestRestaurants(origin, 1)), testing::ElementsAre(far));
+
+    std::vector<int> inView;
+    for (const auto &r : restaurants.findRestaurantsInBounds(39.90, 116.39, 39.915, 116.40)) {
+        inView.push_back(r.getRestaurantId());
+    }
+    EXPECT_THAT(inView, testing::ElementsAre(near, far));
+
+    // Coordinates survive persistence and are re-indexed on load
+    RestaurantManager reloaded(restaurantRepo);
+    EXPECT_THAT(idsOf(reloaded.findNearestRestaurants(origin, 3)), testing::ElementsAre(far, near, middle));
+}
+
+TEST_F(RestaurantManagerIntegrationTest, GetFeaturedRecipesForRestaurants_ResolvesInOneBatch) {
+    int soup = recipes.addRecipe(createDummyRecipe(0, "Soup"));
+    int stew = recipes.addRecipe(createDummyRecipe(0, "Stew"));
+
+    RestaurantManager restaurants(restaurantRepo);
+    int bistro = restaurants.addRestaurant(createTestRestaurant(0, "Bistro", {stew, soup}));
+    int diner = restaurants.addRestaurant(createTestRestaurant(0, "Diner", {soup, 404}));
+    int empty = restaurants.addRestaurant(createTestRestaurant(0, "Empty"));
+
+    auto names = [](const std::vector<Recipe> &found) {
+        std::vector<std::string> result;
+        for (const auto &r : found) result.push_back(r.getName());
+        return result;
+    };
+    auto featured = restaurants.getFeaturedRecipesForRestaurants(restaurants.getAllRestaurants(), recipes);
+    ASSERT_EQ(featured.size(), 3u);
+    EXPECT_THAT(names(featured[bistro]), testing::ElementsAre("Stew", "Soup"));  // Featured-list order
+    EXPECT_THAT(names(featured[diner]), testing::ElementsAre("Soup"));          // Missing 404 skipped
+    EXPECT_TRUE(featured[empty].empty());
+    EXPECT_THAT(names(restaurants.getFeaturedRecipes(bistro, recipes)), testing::ElementsAre("Stew", "Soup"));
+}
+
+TEST_F(RestaurantManagerIntegrationTest, MenuAggregates_MaintainedIncrementally) {
+    auto recipe = [&](const std::string &name, int minutes, Difficulty difficulty,
+                      const std::vector<std::string> &tags) {
+        return recipes.addRecipe(Recipe::builder(0, name)
+                                     .withIngredients({{"Water", "1 cup"}})
+                                     .withSteps({"Cook"})
+                                     .withCookingTime(minutes)
+                                     .withDifficulty(difficulty)
+                                     .withTags(tags)
+                                     .build());
+    };
+    int soup = recipe("Soup", 20, Difficulty::Easy, {"Chinese", "Soup"});
+    int duck = recipe("Duck", 120, Difficulty::Hard, {"Chinese", "Roast"});
+    int salad = recipe("Salad", 10, Difficulty::Easy, {"Vegan"});
+
+    RestaurantManager restaurants(restaurantRepo);
+    int bistro = restaurants.addRestaurant(createTestRestaurant(0, "Bistro", {soup, duck, soup, 404}));
+    EXPECT_FALSE(restaurants.getMenuAggregates(bistro).has_value());  // Not tracked yet
+
+    restaurants.followRecipeDeletions(recipes);
+    restaurants.trackMenuAggregates(recipes);
+    int diner = restaurants.addRestaurant(createTestRestaurant(0, "Diner", {salad}));
+
+    auto bistroMenu = restaurants.getMenuAggregates(bistro);
+    ASSERT_TRUE(bistroMenu.has_value());
+    EXPECT_EQ(bistroMenu->recipeCount, 2u);  // Duplicate and missing IDs not counted
+    EXPECT_EQ(bistroMenu->totalCookingTime, 140);
+    EXPECT_DOUBLE_EQ(bistroMenu->averageCookingTime(), 70.0);
+    EXPECT_THAT(bistroMenu->difficultyCounts, testing::ElementsAre(1, 0, 1));
+    EXPECT_THAT(bistroMenu->topTags(1), testing::ElementsAre(std::make_pair(std::string("Chinese"), 2u)));
+    EXPECT_EQ(restaurants.getMenuAggregates(diner)->totalCookingTime, 10);
+    EXPECT_FALSE(restaurants.getMenuAggregates(999).has_value());
+
+    // Featured list changes
+    auto updated = *restaurants.findRestaurantById(diner);
+    updated.setFeaturedRecipeIds({salad, duck});
+    ASSERT_TRUE(restaurants.updateRestaurant(updated));
+    EXPECT_EQ(restaurants.getMenuAggregates(diner)->recipeCount, 2u);
+
+    // A featured recipe's fields change
+    auto editedDuck = *recipes.findRecipeById(duck);
+    editedDuck.setCookingTime(90);
+    editedDuck.setDifficulty(Difficulty::Medium);
+    editedDuck.setTags({"Roast"});
+    ASSERT_TRUE(recipes.updateRecipe(editedDuck));
+    bistroMenu = restaurants.getMenuAggregates(bistro);
+    EXPECT_EQ(bistroMenu->totalCookingTime, 110);
+    EXPECT_THAT(bistroMenu->difficultyCounts, testing::ElementsAre(1, 1, 0));
+    EXPECT_EQ(bistroMenu->tagCounts.at("Chinese"), 1u);
+    EXPECT_EQ(restaurants.getMenuAggregates(diner)->totalCookingTime, 100);
+
+    // A featured recipe is deleted
+    ASSERT_TRUE(recipes.deleteRecipe(soup));
+    bistroMenu = restaurants.getMenuAggregates(bistro);
+    EXPECT_EQ(bistroMenu->recipeCount, 1u);
+    EXPECT_EQ(bistroMenu->tagCounts.count("Chinese"), 0u);
+
+    // Every maintained aggregate matches a full rebuild
+    RestaurantManager rebuilt(restaurantRepo);
+    rebuilt.trackMenuAggregates(recipes);
+    for (int id : {bistro, diner}) {
+        auto incremental = *restaurants.getMenuAggregates(id);
+        auto fresh = *rebuilt.getMenuAggregates(id);
+        EXPECT_EQ(incremental.recipeCount, fresh.recipeCount);
+        EXPECT_EQ(incremental.totalCookingTime, fresh.totalCookingTime);
+        EXPECT_EQ(incremental.difficultyCounts, fresh.difficultyCounts);
+        EXPECT_EQ(incremental.tagCounts, fresh.tagCounts);
+    }
+}
@@ -0,0 +1,25 @@
+// Converts the encyclopedia JSON into the binary bundle loaded by
+// RecipeEncyclopediaManager::loadBundle. Invoked by the encyclopedia_bundle
+// CMake target; can also be run by hand:
+//   encyclopedia_compiler data/encyclopedia_recipes.json encyclopedia_recipes.bundle
+
+#include <cstdlib>
+#include <iostream>
+
+#include "logic/encyclopedia/RecipeEncyclopediaManager.h"
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <input.json> <output.bundle>"
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (!RecipeApp::Logic::Encyclopedia::RecipeEncyclopediaManager::compileBundle(
+            argv[1], argv[2])) {
+        std::cerr << "Failed to compile " << argv[1] << " into " << argv[2]
+                  << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "Wrote " << argv[2] << std::endl;
+    return EXIT_SUCCESS;
+}